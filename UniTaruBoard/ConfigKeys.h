@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include "config_store.h"
+
+// Settings kept in the config store, set with "set <key> <value>" on the
+// USB console. Missing keys fall back to the compile-time defaults.
+enum ConfigKey : uint16_t
+{
+    ConfigVolume = 1,
+    ConfigFolder,
+    ConfigPlaybackPolicy,      // PlaybackScheduler::Policy
+    ConfigKeySoundBase = 0x10, // + key index
+    ConfigCardSignature = 0x20,   // Written by TrackIndex
+    ConfigFolderTracksBase,       // + folder / 4, four track counts each
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Fixed-size DFPlayer frame with a fill length.
+// Frames are passed by value, so receiving and logging never touch the heap.
+struct DfFrame
+{
+    static constexpr uint8_t Capacity = 10;
+
+    std::array<uint8_t, Capacity> bytes{};
+    uint8_t length = 0;
+
+    bool empty() const { return length == 0; }
+    bool full() const { return length == Capacity; }
+
+    void push(uint8_t byte) { bytes[length++] = byte; }
+
+    uint8_t operator[](uint8_t index) const { return bytes[index]; }
+    const uint8_t* begin() const { return bytes.data(); }
+    const uint8_t* end() const { return bytes.data() + length; }
+};
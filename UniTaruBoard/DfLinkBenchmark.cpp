@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include "DfLinkBenchmark.h"
+#include "TrackIndex.h"
+
+void DfLinkBenchmark::onResponse(const DfResponse& response, void* context)
+{
+    auto* benchmark = static_cast<DfLinkBenchmark*>(context);
+    // Queries are answered with their own frame as well as an ack.
+    if (response.cmd == DfPlayerPicoSd::ResponseAck || response.cmd == DfPlayerPicoSd::ResponseError) {
+        ++benchmark->m_responses;
+    }
+}
+
+bool DfLinkBenchmark::waitResponses(uint32_t count, uint32_t startUs, uint32_t* txUs)
+{
+    bool txDone = false;
+    while (time_us_32() - startUs < TimeoutUs) {
+        m_player.poll();
+        if (!txDone && m_player.txIdle()) {
+            *txUs = time_us_32() - startUs;
+            txDone = true;
+        }
+        // A tx time is only meaningful once the wire is quiet, even if the
+        // answers came first.
+        if (m_responses >= count && txDone) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DfLinkBenchmark::measure(uint8_t cmd, uint16_t param, Stats& stats)
+{
+    for (uint8_t repeat = 0; repeat < Repeats; ++repeat) {
+        m_responses = 0;
+        const uint32_t startUs = time_us_32();
+        uint32_t txUs = 0;
+        m_player.sendCmd(cmd, param);
+        if (!waitResponses(1, startUs, &txUs)) {
+            ++stats.timeouts;
+            continue;
+        }
+        const uint32_t elapsedUs = time_us_32() - startUs;
+        ++stats.count;
+        stats.txSumUs += txUs;
+        stats.sumUs += elapsedUs;
+        stats.minUs = elapsedUs < stats.minUs ? elapsedUs : stats.minUs;
+        stats.maxUs = elapsedUs > stats.maxUs ? elapsedUs : stats.maxUs;
+        sleep_ms(20); // Let late answers drain before the next command
+        m_player.poll();
+    }
+}
+
+void DfLinkBenchmark::burst()
+{
+    m_responses = 0;
+    const uint32_t startUs = time_us_32();
+    uint32_t txUs = 0;
+    for (uint8_t frame = 0; frame < BurstFrames; ++frame) {
+        m_player.sendCmd(dfPlayer::cmd::SPECIFY_VOL, 20);
+    }
+    const bool complete = waitResponses(BurstFrames, startUs, &txUs);
+    const uint32_t elapsedUs = time_us_32() - startUs;
+
+    printf("bench burst frames=%u tx=%luus acked=%lu/%u in %luus (%lu frames/s)\n",
+        BurstFrames, static_cast<unsigned long>(txUs),
+        static_cast<unsigned long>(m_responses), BurstFrames, static_cast<unsigned long>(elapsedUs),
+        complete ? static_cast<unsigned long>(BurstFrames * 1000000ull / elapsedUs) : 0ul);
+}
+
+void DfLinkBenchmark::print(const char* name, const Stats& stats)
+{
+    if (stats.count == 0) {
+        printf("bench %s no answers (%lu timeouts)\n", name, static_cast<unsigned long>(stats.timeouts));
+        return;
+    }
+    printf("bench %s n=%lu tx=%luus ack min=%luus mean=%luus max=%luus timeouts=%lu\n", name,
+        static_cast<unsigned long>(stats.count), static_cast<unsigned long>(stats.txSumUs / stats.count),
+        static_cast<unsigned long>(stats.minUs), static_cast<unsigned long>(stats.sumUs / stats.count),
+        static_cast<unsigned long>(stats.maxUs), static_cast<unsigned long>(stats.timeouts));
+}
+
+void DfLinkBenchmark::run()
+{
+    while (!m_player.ready()) {
+        m_player.poll();
+    }
+    m_player.setResponseHandler(&DfLinkBenchmark::onResponse, this);
+    m_player.setRequestAck(true);
+
+    Stats volume, source, soundCount, folderCount;
+    measure(dfPlayer::cmd::SPECIFY_VOL, 20, volume);
+    measure(dfPlayer::SPECIFY_PLAYBACK_SRC, 0x0002, source);
+    measure(DfPlayerPicoSd::QuerySoundCount, 0, soundCount);
+    measure(TrackIndex::QueryFolderCount, 0, folderCount);
+    print("volume", volume);
+    print("source", source);
+    print("sound_count", soundCount);
+    print("folder_count", folderCount);
+    burst();
+
+    m_player.setRequestAck(false);
+    m_player.setResponseHandler(nullptr);
+}
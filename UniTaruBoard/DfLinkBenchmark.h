@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include "DfPlayerPicoSd.h"
+
+// Measures the DFPlayer link at startup (UNITARU_DF_BENCHMARK builds).
+//
+// Each command type is sent on its own with acknowledgement requested,
+// timing how long until the UART has shifted out its last stop bit
+// (txIdle(), TX FIFO empty and not busy) and how long until the module
+// answers. A burst of frames queued at once then shows the
+// throughput of the link. Results are printed over stdio.
+class DfLinkBenchmark
+{
+public:
+    static constexpr uint8_t Repeats = 8;
+    static constexpr uint8_t BurstFrames = 8;
+    static constexpr uint32_t TimeoutUs = 500000;
+
+    explicit DfLinkBenchmark(DfPlayerPicoSd& player) : m_player(player) {}
+
+    // Blocks until done; the player's response handler is replaced.
+    void run();
+
+private:
+    struct Stats
+    {
+        uint32_t count = 0;
+        uint32_t timeouts = 0;
+        uint32_t txSumUs = 0;
+        uint32_t minUs = UINT32_MAX;
+        uint32_t maxUs = 0;
+        uint32_t sumUs = 0;
+    };
+
+    static void onResponse(const DfResponse& response, void* context);
+
+    void measure(uint8_t cmd, uint16_t param, Stats& stats);
+    void burst();
+    // Polls the player until count responses arrived and the frames are
+    // off the wire; false on timeout.
+    bool waitResponses(uint32_t count, uint32_t startUs, uint32_t* txUs);
+    static void print(const char* name, const Stats& stats);
+
+    DfPlayerPicoSd& m_player;
+    volatile uint32_t m_responses = 0;
+};
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cstdint>
+#include "DfResponseParser.h"
+
+// Round trips of answered queries, over every player on the loopback. Outside
+// the transport, as a nested type's member initializers are not usable in
+// its enclosing class.
+struct DfLatencyStats
+{
+    uint32_t count = 0;
+    uint32_t minUs = UINT32_MAX;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+};
+
+// Host-side transport for DfPlayerSd that simulates the DFPlayer instead of
+// talking to a UART, so the player and the code above it can run on Linux
+// for throughput and latency analysis.
+//
+// Time is simulated: nothing moves until advanceUs() is called, so a run is
+// deterministic and not tied to the host's speed. The model follows the
+// module as seen on the wire:
+//  - both directions take 10 bit times per byte at the configured baud,
+//    and frames queue behind each other on each line;
+//  - the module announces itself with NotifyReady BootUs after begin(), and
+//    ignores frames that arrive before that;
+//  - a frame is answered CommandDelayUs after its last byte arrived with an
+//    ack if feedback was requested, and queries QueryDelayUs after that;
+//  - a play command starts the track, cutting off the current one, and the
+//    track end is notified with 0x3D after its folder's track length;
+//  - missing tracks and folders and bad checksums answer with ResponseError.
+// Received bytes are released one at a time as their stop bit passes.
+class DfLoopbackTransport
+{
+public:
+    static constexpr uint32_t BootUs = 500000;
+    static constexpr uint32_t CommandDelayUs = 15000;
+    static constexpr uint32_t QueryDelayUs = 20000;
+    static constexpr uint32_t TxBufferSize = 128; // Same as the UART ring
+    static constexpr uint8_t MaxFolders = 16;
+
+    static constexpr uint8_t PlayFolderTrack = 0x0F;
+    static constexpr uint8_t SetVolume = 0x06;
+    static constexpr uint8_t QuerySoundCount = 0x47;
+    static constexpr uint8_t QueryFolderTracks = 0x4E;
+    static constexpr uint8_t QueryFolderCount = 0x4F;
+    static constexpr uint8_t NotifyTrackFinished = 0x3D;
+    static constexpr uint8_t NotifyReady = 0x3F;
+    static constexpr uint8_t ResponseError = 0x40;
+    static constexpr uint8_t ResponseAck = 0x41;
+    static constexpr uint8_t ErrorChecksum = 0x04;
+    static constexpr uint8_t ErrorNotFound = 0x06;
+
+    using LatencyStats = DfLatencyStats;
+
+    // Wire time of one byte: start bit, eight data bits and stop bit.
+    static constexpr uint32_t byteUs(uint32_t baudRate) { return (10 * 1000000 + baudRate / 2) / baudRate; }
+
+    // The simulated clock shared by every instance.
+    static uint32_t nowUs() { return s_nowUs; }
+    static void advanceUs(uint32_t us) { s_nowUs += us; }
+
+    static void traceQueryLatency(uint32_t us)
+    {
+        ++s_queryLatency.count;
+        s_queryLatency.minUs = us < s_queryLatency.minUs ? us : s_queryLatency.minUs;
+        s_queryLatency.maxUs = us > s_queryLatency.maxUs ? us : s_queryLatency.maxUs;
+        s_queryLatency.sumUs += us;
+    }
+    static const LatencyStats& queryLatency() { return s_queryLatency; }
+
+    // Contents of the simulated SD card. Folders start at 1.
+    void setFolder(uint8_t folder, uint8_t tracks, uint32_t trackUs)
+    {
+        if (folder == 0 || folder > MaxFolders) {
+            return;
+        }
+        m_tracks[folder - 1] = tracks;
+        m_trackUs[folder - 1] = trackUs;
+    }
+
+    void begin(uint32_t baudRate)
+    {
+        m_byteUs = byteUs(baudRate);
+        m_bootAtUs = s_nowUs + BootUs;
+        m_booted = false;
+    }
+
+    bool write(const uint8_t* data, uint32_t count)
+    {
+        update();
+        if (count != DfResponseParser::FrameSize || m_txCount == TxFrames
+            || (m_txCount + 1u) * DfResponseParser::FrameSize > TxBufferSize) {
+            return false;
+        }
+        TxFrame& frame = m_txFrames[(m_txHead + m_txCount) % TxFrames];
+        frame.frame = DfFrame();
+        for (uint32_t index = 0; index < count; ++index) {
+            frame.frame.push(data[index]);
+        }
+        ++m_txCount;
+        if (m_started) {
+            frame.doneUs = hostWireSlot();
+        }
+        return true;
+    }
+
+    void start()
+    {
+        m_started = true;
+        for (uint8_t index = 0; index < m_txCount; ++index) {
+            m_txFrames[(m_txHead + index) % TxFrames].doneUs = hostWireSlot();
+        }
+    }
+
+    bool read(uint8_t& byte)
+    {
+        update();
+        if (m_rxCount == 0 || !reached(m_rxBytes[m_rxHead].atUs)) {
+            return false;
+        }
+        byte = m_rxBytes[m_rxHead].byte;
+        m_rxHead = (m_rxHead + 1) % RxBytes;
+        --m_rxCount;
+        return true;
+    }
+
+    bool txIdle() const
+    {
+        return m_txCount == 0 || (m_started && reached(m_hostWireFreeUs));
+    }
+
+    uint32_t droppedRxBytes() const { return m_rxDropped; }
+    void onClockChanged(uint32_t) {}
+
+    // Some modules do not always send 0x3D when a track ends.
+    void setNotifyTrackEnd(bool notify) { m_notifyTrackEnd = notify; }
+
+    uint8_t volume() const { return m_volume; }
+    bool playing() const { return m_playing; }
+    uint8_t playingTrack() const { return m_playingTrack; }
+    uint32_t ignoredFrames() const { return m_ignoredFrames; }
+    uint32_t cutTracks() const { return m_cutTracks; }
+    uint32_t playCommands() const { return m_playCommands; }
+
+private:
+    static constexpr uint8_t TxFrames = 16;
+    static constexpr uint32_t RxBytes = 256;
+
+    enum class Event : uint8_t
+    {
+        None,
+        Boot,
+        FrameArrived,
+        TrackEnd,
+    };
+
+    struct TxFrame
+    {
+        DfFrame frame;
+        uint32_t doneUs; // Last byte received by the module
+    };
+
+    struct RxByte
+    {
+        uint32_t atUs;
+        uint8_t byte;
+    };
+
+    static bool reached(uint32_t timeUs) { return static_cast<int32_t>(s_nowUs - timeUs) >= 0; }
+    static uint32_t later(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) >= 0 ? a : b; }
+
+    // Time the next frame from the host has fully arrived.
+    uint32_t hostWireSlot()
+    {
+        m_hostWireFreeUs = later(s_nowUs, m_hostWireFreeUs) + DfResponseParser::FrameSize * m_byteUs;
+        return m_hostWireFreeUs;
+    }
+
+    // Runs the module's events up to now in time order.
+    void update()
+    {
+        for (;;) {
+            // Earliest pending event: boot, an arrived frame or a track end.
+            Event event = Event::None;
+            uint32_t at = 0;
+            auto consider = [&](bool pending, uint32_t timeUs, Event kind) {
+                if (pending && (event == Event::None || static_cast<int32_t>(timeUs - at) < 0)) {
+                    at = timeUs;
+                    event = kind;
+                }
+            };
+            consider(!m_booted, m_bootAtUs, Event::Boot);
+            consider(m_started && m_txCount > 0, m_txFrames[m_txHead].doneUs, Event::FrameArrived);
+            consider(m_playing, m_playEndUs, Event::TrackEnd);
+            if (event == Event::None || !reached(at)) {
+                return;
+            }
+
+            if (event == Event::Boot) {
+                m_booted = true;
+                respond(at, NotifyReady, 0x0002);
+            } else if (event == Event::FrameArrived) {
+                const DfFrame frame = m_txFrames[m_txHead].frame;
+                m_txHead = (m_txHead + 1) % TxFrames;
+                --m_txCount;
+                receive(at, frame);
+            } else {
+                m_playing = false;
+                if (m_notifyTrackEnd) {
+                    respond(at, NotifyTrackFinished, m_playingTrack);
+                }
+            }
+        }
+    }
+
+    void receive(uint32_t at, const DfFrame& frame)
+    {
+        if (!m_booted) {
+            ++m_ignoredFrames;
+            return;
+        }
+        const uint16_t checksum = frame[DfResponseParser::Checksum1Offset] << 8
+            | frame[DfResponseParser::Checksum2Offset];
+        if (checksum != DfResponseParser::checksum(frame)) {
+            respond(at + CommandDelayUs, ResponseError, ErrorChecksum);
+            return;
+        }
+
+        const uint8_t cmd = frame[DfResponseParser::CmdOffset];
+        const uint8_t para1 = frame[DfResponseParser::Para1Offset];
+        const uint8_t para2 = frame[DfResponseParser::Para2Offset];
+        if (frame[DfResponseParser::FeedbackOffset]) {
+            respond(at + CommandDelayUs, ResponseAck, 0);
+        }
+
+        const uint32_t answerUs = at + CommandDelayUs + QueryDelayUs;
+        switch (cmd) {
+        case PlayFolderTrack:
+            if (para1 == 0 || para1 > MaxFolders || para2 == 0 || para2 > m_tracks[para1 - 1]) {
+                respond(at + CommandDelayUs, ResponseError, ErrorNotFound);
+                break;
+            }
+            ++m_playCommands;
+            m_cutTracks += m_playing ? 1 : 0;
+            m_playing = true;
+            m_playingTrack = para2;
+            m_playEndUs = at + CommandDelayUs + m_trackUs[para1 - 1];
+            break;
+        case SetVolume:
+            m_volume = para2;
+            break;
+        case QuerySoundCount: {
+            uint16_t total = 0;
+            for (uint8_t folder = 0; folder < MaxFolders; ++folder) {
+                total += m_tracks[folder];
+            }
+            respond(answerUs, cmd, total);
+            break;
+        }
+        case QueryFolderCount: {
+            uint16_t folders = 0;
+            for (uint8_t folder = 0; folder < MaxFolders; ++folder) {
+                folders += m_tracks[folder] > 0 ? 1 : 0;
+            }
+            respond(answerUs, cmd, folders);
+            break;
+        }
+        case QueryFolderTracks:
+            // Like the module, a folder that is not on the card is an error.
+            if (para2 == 0 || para2 > MaxFolders || m_tracks[para2 - 1] == 0) {
+                respond(answerUs, ResponseError, ErrorNotFound);
+            } else {
+                respond(answerUs, cmd, m_tracks[para2 - 1]);
+            }
+            break;
+        default:
+            break; // Accepted without an answer
+        }
+    }
+
+    // Queues a frame on the module's TX line, behind anything it is sending.
+    void respond(uint32_t at, uint8_t cmd, uint16_t param)
+    {
+        DfFrame frame;
+        const uint8_t bytes[] = {DfResponseParser::StartByte, DfResponseParser::VersionByte,
+            DfResponseParser::LengthByte, cmd, 0, static_cast<uint8_t>(param >> 8),
+            static_cast<uint8_t>(param & 0xff), 0, 0, DfResponseParser::EndByte};
+        for (uint8_t byte : bytes) {
+            frame.push(byte);
+        }
+        const uint16_t checksum = DfResponseParser::checksum(frame);
+        frame.bytes[DfResponseParser::Checksum1Offset] = checksum >> 8;
+        frame.bytes[DfResponseParser::Checksum2Offset] = checksum & 0xff;
+
+        uint32_t byteAt = later(at, m_moduleWireFreeUs);
+        for (uint8_t byte : frame) {
+            byteAt += m_byteUs;
+            if (m_rxCount == RxBytes) {
+                ++m_rxDropped;
+                continue;
+            }
+            m_rxBytes[(m_rxHead + m_rxCount) % RxBytes] = {byteAt, byte};
+            ++m_rxCount;
+        }
+        m_moduleWireFreeUs = byteAt;
+    }
+
+    uint32_t m_byteUs = 0;
+    bool m_started = false;
+    uint32_t m_hostWireFreeUs = 0;
+    TxFrame m_txFrames[TxFrames];
+    uint8_t m_txHead = 0;
+    uint8_t m_txCount = 0;
+
+    uint32_t m_moduleWireFreeUs = 0;
+    RxByte m_rxBytes[RxBytes];
+    uint32_t m_rxHead = 0;
+    uint32_t m_rxCount = 0;
+    uint32_t m_rxDropped = 0;
+
+    uint32_t m_bootAtUs = 0;
+    bool m_booted = false;
+    uint8_t m_tracks[MaxFolders] = {};
+    uint32_t m_trackUs[MaxFolders] = {};
+    uint8_t m_volume = 30;
+    bool m_playing = false;
+    uint8_t m_playingTrack = 0;
+    uint32_t m_playEndUs = 0;
+    bool m_notifyTrackEnd = true;
+    uint32_t m_ignoredFrames = 0;
+    uint32_t m_cutTracks = 0;
+    uint32_t m_playCommands = 0;
+
+    static inline uint32_t s_nowUs = 0;
+    static inline LatencyStats s_queryLatency;
+};
@@ -0,0 +1,3 @@
+#include "DfPlayerPicoSd.h"
+
+template class DfPlayerSd<PicoUart0Transport>;
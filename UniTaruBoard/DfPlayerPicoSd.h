@@ -0,0 +1,21 @@
+#pragma once
+
+#include "DfPlayerSd.h"
+
+#if UNITARU_DF_LOOPBACK
+// Host tests: the module simulated by DfLoopbackTransport, so TrackIndex and
+// PlaybackScheduler run unchanged against it.
+#include "DfLoopbackTransport.h"
+
+using DfPlayerPicoSd = DfPlayerSd<DfLoopbackTransport>;
+#else
+#include "PicoUartTransport.h"
+
+// DFPlayer on UART 0 with a DMA transmit queue and an interrupt-driven
+// receive queue. A second module would be DfPlayerSd<PicoUart1Transport>
+// on GPIO 8 and 9.
+using DfPlayerPicoSd = DfPlayerSd<PicoUart0Transport>;
+
+// Compiled once in DfPlayerPicoSd.cpp.
+extern template class DfPlayerSd<PicoUart0Transport>;
+#endif
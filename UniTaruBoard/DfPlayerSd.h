@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstdint>
+#include "lib/pico-dfPlayerMini/dfPlayer/dfPlayer.h"
+#include "DfResponseParser.h"
+
+// DFPlayer protocol on top of a serial transport policy. Nothing here waits
+// on the link: commands are queued on the transport, responses are parsed
+// in poll() and handed to callbacks.
+//
+// The transport is a template parameter, so the calls compile down to the
+// concrete UART code with no virtual dispatch. It provides:
+//   static uint32_t nowUs();                    // Free-running microseconds
+//   static void traceQueryLatency(uint32_t us); // Answered query round trip
+//   void begin(uint32_t baudRate);
+//   bool write(const uint8_t* data, uint32_t count); // All or nothing
+//   void start();        // Hold writes until called
+//   bool read(uint8_t& byte);
+//   bool txIdle() const;
+//   uint32_t droppedRxBytes() const;
+//   void onClockChanged(uint32_t baudRate);
+// PicoUartTransport drives a real UART, DfLoopbackTransport simulates the
+// module on the host.
+template <typename Transport>
+class DfPlayerSd : public DfPlayer<DfPlayerSd<Transport>>
+{
+public:
+    using ResponseCallback = void (*)(const DfResponse& response, void* context);
+
+    static constexpr uint8_t QuerySoundCount = 0x47;
+    static constexpr uint8_t ResponseError = 0x40;
+    // param of a ResponseError for a file or folder that is not on the card.
+    static constexpr uint16_t ErrorNotFound = 0x06;
+    static constexpr uint8_t ResponseAck = 0x41;
+    static constexpr uint8_t NotifyReady = 0x3F;
+
+    // Commands are held until the module reports it is ready after power-on,
+    // or until this long after construction when it was already running.
+    static constexpr uint32_t StartupDelayMs = 1000;
+
+    // The module only accepts 9600 baud, so a frame takes about 10.4 ms.
+    static constexpr uint32_t BaudRate = 9600;
+
+    // Queries not answered within this time complete with ResponseError.
+    static constexpr uint32_t QueryTimeoutMs = 500;
+
+    // A command's ResponseError comes within this long of sending it: a few
+    // frames queued ahead of it, its own frame and the module's reaction.
+    static constexpr uint32_t ErrorWindowMs = 150;
+
+    DfPlayerSd();
+
+    // Called by DfPlayer::sendCmd with a complete frame.
+    void uartSend(uint8_t* a_cmd);
+
+    // Parse received bytes and dispatch responses. Call from the main loop.
+    void poll();
+
+    // Receives every valid frame from the module.
+    void setResponseHandler(ResponseCallback callback, void* context = nullptr);
+
+    // The callback receives the count in param, or a ResponseError response.
+    bool requestSoundCount(ResponseCallback callback, void* context = nullptr);
+
+    // Send a query whose answer carries the same command byte. The callback
+    // may start the next query. The module does not say which command a
+    // ResponseError is for, so an error only completes the query when no
+    // other command could have caused it; otherwise the handler alone gets
+    // it and the query times out with an empty frame.
+    bool query(uint8_t cmd, uint16_t param, ResponseCallback callback, void* context = nullptr);
+
+    void playSound(uint8_t soundNumber);
+    void playSound(uint8_t folder, uint8_t soundNumber);
+    void setVolume(uint8_t volume);
+    void setFolder(uint8_t folder) { m_folder = folder; }
+    uint8_t folder() const { return m_folder; }
+
+    // Sets the baud divider again after clk_peri changed. Only call while
+    // txIdle(), a frame in flight would be garbled.
+    void onClockChanged() { m_transport.onClockChanged(BaudRate); }
+
+    uint32_t droppedCommands() const { return m_txDropped; }
+    bool txIdle() const { return m_transport.txIdle(); }
+    bool ready() const { return m_ready; }
+
+    // Ask the module to acknowledge every command with ResponseAck.
+    void setRequestAck(bool requestAck) { m_requestAck = requestAck; }
+    uint32_t droppedRxBytes() const { return m_transport.droppedRxBytes(); }
+    const DfResponseParser& parser() const { return m_parser; }
+
+    Transport& transport() { return m_transport; }
+
+private:
+    struct PendingQuery
+    {
+        uint8_t cmd;
+        ResponseCallback callback;
+        void* context;
+        uint32_t deadlineUs;
+        uint32_t sentUs;
+    };
+
+    static constexpr uint8_t MaxPendingQueries = 4;
+
+    static bool reached(uint32_t deadlineUs)
+    {
+        return static_cast<int32_t>(Transport::nowUs() - deadlineUs) >= 0;
+    }
+
+    void dispatch(const DfResponse& response);
+    bool errorAnswersQuery() const;
+    void completeQuery(uint8_t index, const DfResponse& response);
+    void expireQueries();
+    void setReady();
+
+    Transport m_transport;
+    uint32_t m_txDropped = 0;
+    uint8_t m_folder = 1;
+    bool m_requestAck = false;
+    bool m_ready = false;
+    uint32_t m_readyUs;
+    bool m_sendingQuery = false;
+    bool m_lastSentQuery = false;  // The last command sent was a query
+    uint32_t m_lastCommandUs = 0;  // When the last other command was sent
+
+    PendingQuery m_pending[MaxPendingQueries];
+    uint8_t m_pendingCount = 0;
+    ResponseCallback m_responseHandler = nullptr;
+    void* m_responseContext = nullptr;
+    DfResponseParser m_parser;
+};
+
+template <typename Transport>
+DfPlayerSd<Transport>::DfPlayerSd()
+{
+    m_readyUs = Transport::nowUs() + StartupDelayMs * 1000;
+    m_transport.begin(BaudRate);
+    this->sendCmd(dfPlayer::SPECIFY_PLAYBACK_SRC, 0x0002); // Set to use only SD card.
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::uartSend(uint8_t* a_cmd)
+{
+    if (m_requestAck) {
+        // Same frame layout and checksum as the module's responses.
+        a_cmd[DfResponseParser::FeedbackOffset] = 1;
+        uint16_t sum = 0;
+        for (uint8_t index = 1; index <= DfResponseParser::Para2Offset; ++index) {
+            sum += a_cmd[index];
+        }
+        const uint16_t checksum = 0 - sum;
+        a_cmd[DfResponseParser::Checksum1Offset] = checksum >> 8;
+        a_cmd[DfResponseParser::Checksum2Offset] = checksum & 0xff;
+    }
+
+    if (!m_transport.write(a_cmd, DfResponseParser::FrameSize)) {
+        ++m_txDropped; // Never wait for the link
+        return;
+    }
+    m_lastSentQuery = m_sendingQuery;
+    if (!m_sendingQuery) {
+        m_lastCommandUs = Transport::nowUs();
+    }
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::setReady()
+{
+    // Query timeouts count from when the command can actually go out.
+    const uint32_t now = Transport::nowUs();
+    for (uint8_t index = 0; index < m_pendingCount; ++index) {
+        m_pending[index].deadlineUs = now + QueryTimeoutMs * 1000;
+        m_pending[index].sentUs = now;
+    }
+    m_lastCommandUs = now; // The held commands go out with them
+
+    m_ready = true;
+    m_transport.start();
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::poll()
+{
+    if (!m_ready && reached(m_readyUs)) {
+        setReady();
+    }
+
+    uint8_t byte;
+    while (m_transport.read(byte)) {
+        if (m_parser.feed(byte)) {
+            dispatch(m_parser.response());
+        }
+    }
+    if (m_ready) {
+        expireQueries();
+    }
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::setResponseHandler(ResponseCallback callback, void* context)
+{
+    m_responseHandler = callback;
+    m_responseContext = context;
+}
+
+template <typename Transport>
+bool DfPlayerSd<Transport>::requestSoundCount(ResponseCallback callback, void* context)
+{
+    return query(QuerySoundCount, 0x0000, callback, context);
+}
+
+template <typename Transport>
+bool DfPlayerSd<Transport>::query(uint8_t cmd, uint16_t param, ResponseCallback callback, void* context)
+{
+    if (m_pendingCount == MaxPendingQueries) {
+        return false;
+    }
+    const uint32_t now = Transport::nowUs();
+    m_pending[m_pendingCount++] = {cmd, callback, context, now + QueryTimeoutMs * 1000, now};
+    m_sendingQuery = true;
+    this->sendCmd(cmd, param);
+    m_sendingQuery = false;
+    return true;
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::dispatch(const DfResponse& response)
+{
+    if (response.cmd == NotifyReady && !m_ready) {
+        setReady();
+    }
+    if (m_responseHandler) {
+        m_responseHandler(response, m_responseContext);
+    }
+    if (m_pendingCount == 0 || response.cmd == ResponseAck) {
+        return;
+    }
+
+    // Errors go to the query only when they can be for nothing else,
+    // otherwise match by command.
+    if (response.cmd == ResponseError) {
+        if (errorAnswersQuery()) {
+            completeQuery(0, response);
+        }
+        return;
+    }
+    for (uint8_t index = 0; index < m_pendingCount; ++index) {
+        if (m_pending[index].cmd == response.cmd) {
+            completeQuery(index, response);
+            return;
+        }
+    }
+}
+
+// A play or volume command that fails also answers with ResponseError, for
+// example a missing track. The error is the query's only if the query was
+// sent last, is the only one in flight, and any other command went out more
+// than ErrorWindowMs ago.
+template <typename Transport>
+bool DfPlayerSd<Transport>::errorAnswersQuery() const
+{
+    return m_pendingCount == 1 && m_lastSentQuery && reached(m_lastCommandUs + ErrorWindowMs * 1000);
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::completeQuery(uint8_t index, const DfResponse& response)
+{
+    const PendingQuery query = m_pending[index];
+    for (uint8_t next = index + 1; next < m_pendingCount; ++next) {
+        m_pending[next - 1] = m_pending[next];
+    }
+    --m_pendingCount;
+
+    // Timeouts complete with an empty frame and are not a round trip.
+    if (!response.frame.empty()) {
+        Transport::traceQueryLatency(Transport::nowUs() - query.sentUs);
+    }
+    if (query.callback) {
+        query.callback(response, query.context);
+    }
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::expireQueries()
+{
+    while (m_pendingCount > 0 && reached(m_pending[0].deadlineUs)) {
+        completeQuery(0, {ResponseError, 0, 0, DfFrame()});
+    }
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::playSound(uint8_t soundNumber)
+{
+    playSound(m_folder, soundNumber);
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::playSound(uint8_t folder, uint8_t soundNumber)
+{
+    this->sendCmd(dfPlayer::cmd::SPECIFY_FOLDER_PLAYBACK,
+        folder << 8 | soundNumber);
+}
+
+template <typename Transport>
+void DfPlayerSd<Transport>::setVolume(uint8_t volume)
+{
+    if (volume > 31) {
+        volume = 31; // Clip to maximum volume
+    }
+    this->sendCmd(dfPlayer::cmd::SPECIFY_VOL, volume);
+}
@@ -0,0 +1,72 @@
+#include "DfResponseParser.h"
+
+uint16_t DfResponseParser::checksum(const DfFrame& frame)
+{
+    uint16_t sum = 0;
+    for (uint8_t index = 1; index < Checksum1Offset; ++index) {
+        sum += frame[index];
+    }
+    return static_cast<uint16_t>(0 - sum);
+}
+
+bool DfResponseParser::feed(uint8_t byte)
+{
+    if (m_frame.full()) {
+        m_frame.length = 0; // Previous frame was completed
+    }
+    if (m_frame.empty() && byte != StartByte) {
+        return false; // Out of sync, wait for a start marker
+    }
+    m_frame.push(byte);
+
+    // Reject early on the fixed header bytes.
+    if ((m_frame.length == 2 && byte != VersionByte) || (m_frame.length == 3 && byte != LengthByte)) {
+        ++m_framingErrors;
+        resync();
+        return false;
+    }
+    if (!m_frame.full()) {
+        return false;
+    }
+
+    if (m_frame[EndOffset] != EndByte) {
+        ++m_framingErrors;
+        resync();
+        return false;
+    }
+    const uint16_t expected = m_frame[Checksum1Offset] << 8 | m_frame[Checksum2Offset];
+    if (checksum(m_frame) != expected) {
+        ++m_checksumErrors;
+        resync();
+        return false;
+    }
+
+    return true;
+}
+
+DfResponse DfResponseParser::response() const
+{
+    return {
+        m_frame[CmdOffset],
+        m_frame[FeedbackOffset],
+        static_cast<uint16_t>(m_frame[Para1Offset] << 8 | m_frame[Para2Offset]),
+        m_frame,
+    };
+}
+
+void DfResponseParser::resync()
+{
+    // Restart from the next start marker already received, if any.
+    uint8_t start = 1;
+    while (start < m_frame.length && m_frame[start] != StartByte) {
+        ++start;
+    }
+    const DfFrame received = m_frame;
+
+    // Re-validate the remaining bytes as if they had just arrived.
+    // They are always shorter than a frame, so this cannot complete one.
+    m_frame.length = 0;
+    for (uint8_t index = start; index < received.length; ++index) {
+        feed(received[index]);
+    }
+}
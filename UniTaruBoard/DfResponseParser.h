@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include "DfFrame.h"
+
+// Decoded DFPlayer frame: 7E FF 06 CMD FEEDBACK PARA1 PARA2 CHK_H CHK_L EF
+struct DfResponse
+{
+    uint8_t cmd;
+    uint8_t feedback;
+    uint16_t param;
+    DfFrame frame; // Raw bytes, empty if the module did not answer
+};
+
+// Byte-at-a-time receive state machine for DFPlayer frames.
+// Bytes before a start marker are skipped, and a frame with a bad end marker
+// or checksum is dropped while resyncing on the next 0x7E in the data
+// already received. It has no hardware dependency.
+class DfResponseParser
+{
+public:
+    static constexpr uint8_t FrameSize = DfFrame::Capacity;
+    static constexpr uint8_t StartByte = 0x7E;
+    static constexpr uint8_t VersionByte = 0xFF;
+    static constexpr uint8_t LengthByte = 0x06;
+    static constexpr uint8_t EndByte = 0xEF;
+
+    static constexpr uint8_t CmdOffset = 3;
+    static constexpr uint8_t FeedbackOffset = 4;
+    static constexpr uint8_t Para1Offset = 5;
+    static constexpr uint8_t Para2Offset = 6;
+    static constexpr uint8_t Checksum1Offset = 7;
+    static constexpr uint8_t Checksum2Offset = 8;
+    static constexpr uint8_t EndOffset = 9;
+
+    // Two's complement of the sum of version .. para2.
+    static uint16_t checksum(const DfFrame& frame);
+
+    // Returns true when the byte completes a valid frame.
+    bool feed(uint8_t byte);
+
+    // The last completed frame, valid until the next feed().
+    DfResponse response() const;
+
+    uint32_t checksumErrors() const { return m_checksumErrors; }
+    uint32_t framingErrors() const { return m_framingErrors; }
+
+private:
+    void resync();
+
+    DfFrame m_frame;
+    uint32_t m_checksumErrors = 0;
+    uint32_t m_framingErrors = 0;
+};
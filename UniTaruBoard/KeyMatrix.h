@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "EventQueue.h"
+#include "TraceProbes.h"
+
+#if UNITARU_PIO_SCANNER
+#include "PioMatrixScanner.h"
+#endif
+
+struct KeyEvent
+{
+    uint8_t key;      // Zero-based key index (row * Cols + col)
+    bool pressed;     // true on press, false on release
+    uint32_t time_us; // Time the debounced state changed
+};
+
+// Compile-time list of GPIO numbers.
+template <uint... Pins>
+struct PinList
+{
+    static constexpr uint Count = sizeof...(Pins);
+    static constexpr uint pins[Count] = {Pins...};
+    static constexpr uint32_t Mask = ((1u << Pins) | ...);
+    static constexpr uint First = pins[0];
+
+    // true when the pins are consecutive and ascending, so a group of them
+    // can be taken from gpio_get_all() with a single shift.
+    static constexpr bool Contiguous = Mask == (((1u << Count) - 1) << First);
+};
+
+// Scans an N x M key matrix from a repeating timer.
+//
+// Each tick reads all columns of the row driven on the previous tick with one
+// gpio_get_all(), so the row has a full tick to settle and no sleep is needed.
+// Rows are debounced as bit masks with a two-bit vertical counter, which
+// accepts a new state after four equal samples without branching per key.
+// A row that shares two or more pressed columns with another row cannot be
+// told apart from a ghost key and keeps its previous state until it clears.
+template <typename RowPins, typename ColPins>
+class KeyMatrix
+{
+public:
+    static constexpr uint Rows = RowPins::Count;
+    static constexpr uint Cols = ColPins::Count;
+    static constexpr uint KeyCount = Rows * Cols;
+
+    static_assert(Cols <= 32, "Too many columns");
+    static_assert(KeyCount <= 64, "Too many keys");
+
+    using KeyBitmap = std::conditional_t<(KeyCount <= 32), uint32_t, uint64_t>;
+
+    KeyMatrix()
+    {
+        gpio_init_mask(RowPins::Mask | ColPins::Mask);
+        gpio_set_dir_out_masked(RowPins::Mask);
+        gpio_clr_mask(RowPins::Mask);
+        gpio_set_dir_in_masked(ColPins::Mask);
+        for (const uint pin : ColPins::pins) {
+            gpio_pull_down(pin);
+        }
+        for (uint row = 0; row < Rows; ++row) {
+            m_count0[row] = ~0u; // Counters idle at all ones
+            m_count1[row] = ~0u;
+        }
+    }
+
+    // Start scanning. One row is handled per tick. The timer runs on the
+    // core that owns the alarm pool (the default pool is on core 0).
+    bool start(int64_t tickUs = 250, alarm_pool_t* pool = nullptr)
+    {
+        m_tickUs = tickUs;
+        m_row = 0;
+        driveRow(m_row);
+
+        // A negative delay keeps the period fixed regardless of callback time.
+        if (pool) {
+            return alarm_pool_add_repeating_timer_us(pool, -tickUs, &KeyMatrix::onTimer, this, &m_timer);
+        }
+        return add_repeating_timer_us(-tickUs, &KeyMatrix::onTimer, this, &m_timer);
+    }
+
+#if UNITARU_PIO_SCANNER
+    // Let PIO and DMA strobe the rows continuously, and only debounce the
+    // latest snapshots on a timer. Rows and columns must be consecutive.
+    bool startPio(PIO pio, uint settleUs = 10, int64_t pollUs = 1000, alarm_pool_t* pool = nullptr)
+    {
+        static_assert(RowPins::Contiguous && ColPins::Contiguous, "PIO scanning needs consecutive pins");
+        if (!m_pio.start(pio, RowPins::First, Rows, ColPins::First, Cols, settleUs)) {
+            return false;
+        }
+        if (pool) {
+            return alarm_pool_add_repeating_timer_us(pool, -pollUs, &KeyMatrix::onPioTimer, this, &m_timer);
+        }
+        return add_repeating_timer_us(-pollUs, &KeyMatrix::onPioTimer, this, &m_timer);
+    }
+#endif
+
+    // Stop the timer scan and drive every row, so a press raises its column
+    // without any clock running. Returns the column pins to wake on.
+    uint32_t suspend()
+    {
+        cancel_repeating_timer(&m_timer);
+        gpio_set_mask(RowPins::Mask);
+        return ColPins::Mask;
+    }
+
+    // Scan again after suspend(). The debounced state is kept, so the key
+    // that woke the chip is reported once it has been stable for four ticks.
+    bool resume() { return start(m_tickUs); }
+
+    // Call after clk_sys changed. The timers run from the 1 MHz tick and
+    // need nothing; the PIO program's divider is set again.
+    void onClockChanged()
+    {
+#if UNITARU_PIO_SCANNER
+        m_pio.onClockChanged();
+#endif
+    }
+
+    bool popEvent(KeyEvent& event) { return m_events.pop(event); }
+
+    // Debounced state of all keys, bit n set while key n is held.
+    KeyBitmap pressedKeys() const
+    {
+        KeyBitmap keys = 0;
+        for (uint row = 0; row < Rows; ++row) {
+            keys |= static_cast<KeyBitmap>(m_state[row]) << (row * Cols);
+        }
+        return keys;
+    }
+
+    uint32_t droppedEvents() const { return m_events.dropped(); }
+    uint32_t ghostedScans() const { return m_ghosted; }
+
+    // Feed the raw column bitmap of one row, bit n for column n.
+    void processRow(uint row, uint32_t columns)
+    {
+        m_raw[row] = columns;
+        if (isGhosted(row)) {
+            ++m_ghosted;
+            return;
+        }
+
+        // Vertical counter: bits count equal samples of a changed key.
+        uint32_t toggle = m_state[row] ^ columns;
+        m_count0[row] = ~(m_count0[row] & toggle);
+        m_count1[row] = m_count0[row] ^ (m_count1[row] & toggle);
+        toggle &= m_count0[row] & m_count1[row];
+        if (toggle == 0) {
+            return;
+        }
+
+        m_state[row] ^= toggle;
+        const uint32_t now = time_us_32();
+        for (uint col = 0; col < Cols; ++col) {
+            if (toggle & (1u << col)) {
+                const bool pressed = (m_state[row] >> col) & 1u;
+                m_events.push({static_cast<uint8_t>(row * Cols + col), pressed, now});
+            }
+        }
+        __sev(); // Wake the consumer if it waits in __wfe on the other core
+    }
+
+private:
+    static constexpr uint32_t ColumnMask = Cols == 32 ? ~0u : (1u << Cols) - 1;
+
+    static bool onTimer(repeating_timer_t* timer)
+    {
+        static_cast<KeyMatrix*>(timer->user_data)->tick();
+        return true;
+    }
+
+#if UNITARU_PIO_SCANNER
+    static bool onPioTimer(repeating_timer_t* timer)
+    {
+        const uint32_t begin = trace_begin();
+        auto* matrix = static_cast<KeyMatrix*>(timer->user_data);
+        for (uint row = 0; row < Rows; ++row) {
+            matrix->processRow(row, matrix->m_pio.row(row) & ColumnMask);
+        }
+        matrix->m_pio.service();
+        trace_end(TraceMatrixScan, begin);
+        return true;
+    }
+#endif
+
+    static void driveRow(uint row)
+    {
+        gpio_put_masked(RowPins::Mask, 1u << RowPins::pins[row]);
+    }
+
+    // Column bits gathered from a gpio_get_all() snapshot.
+    static uint32_t readColumns(uint32_t gpios)
+    {
+        if constexpr (ColPins::Contiguous) {
+            return (gpios >> ColPins::First) & ColumnMask;
+        } else {
+            uint32_t columns = 0;
+            for (uint col = 0; col < Cols; ++col) {
+                columns |= ((gpios >> ColPins::pins[col]) & 1u) << col;
+            }
+            return columns;
+        }
+    }
+
+    bool isGhosted(uint row) const
+    {
+        for (uint other = 0; other < Rows; ++other) {
+            const uint32_t shared = m_raw[row] & m_raw[other];
+            if (other != row && (shared & (shared - 1)) != 0) {
+                return true; // Two or more shared columns
+            }
+        }
+        return false;
+    }
+
+    void tick()
+    {
+        const uint32_t begin = trace_begin();
+
+        // The current row has been driven since the previous tick.
+        processRow(m_row, readColumns(gpio_get_all()));
+
+        // Move on to the next row; it settles until the next tick.
+        m_row = (m_row + 1) % Rows;
+        driveRow(m_row);
+        trace_end(TraceMatrixScan, begin);
+    }
+
+    uint m_row = 0;
+    int64_t m_tickUs = 250;
+    uint32_t m_raw[Rows] = {};
+    uint32_t m_state[Rows] = {};
+    uint32_t m_count0[Rows];
+    uint32_t m_count1[Rows];
+    uint32_t m_ghosted = 0;
+    repeating_timer_t m_timer;
+    EventQueue<KeyEvent, 32> m_events;
+#if UNITARU_PIO_SCANNER
+    PioMatrixScanner m_pio;
+#endif
+};
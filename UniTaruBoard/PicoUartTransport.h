@@ -0,0 +1,148 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "EventQueue.h"
+#include "TraceProbes.h"
+
+// Serial transport for DfPlayerSd on one of the RP2040 UARTs.
+//
+// Bytes are queued in a ring buffer and streamed out by DMA, and received
+// bytes are buffered by the RX interrupt. Nothing goes out until start(),
+// so frames queued before the module is ready wait in the ring. Each
+// UartIndex has its own interrupt handlers and receive queue, so one
+// transport per UART can run side by side.
+template <uint UartIndex, uint TxPin, uint RxPin>
+class PicoUartTransport
+{
+    static_assert(UartIndex < NUM_UARTS, "No such UART");
+
+public:
+    static constexpr uint32_t TxBufferBits = 7;
+    static constexpr uint32_t TxBufferSize = 1u << TxBufferBits;
+    static constexpr uint32_t RxBufferSize = 64; // Power of two
+
+    static uint32_t nowUs() { return time_us_32(); }
+    static void traceQueryLatency(uint32_t us) { trace_record(TraceQueryLatency, us); }
+
+    void begin(uint baudRate)
+    {
+        s_instance = this;
+        uart_init(uart(), baudRate);
+        gpio_set_function(TxPin, GPIO_FUNC_UART);
+        gpio_set_function(RxPin, GPIO_FUNC_UART);
+
+        const uint uartIrq = UartIndex == 0 ? UART0_IRQ : UART1_IRQ;
+        irq_set_exclusive_handler(uartIrq, &PicoUartTransport::onUartIrq);
+        irq_set_enabled(uartIrq, true);
+        uart_set_irq_enables(uart(), true, false);
+
+        // Transmit from the ring buffer by DMA; the ring wraps on its alignment.
+        m_txDma = dma_claim_unused_channel(true);
+        dma_channel_config config = dma_channel_get_default_config(m_txDma);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_ring(&config, false, TxBufferBits);
+        channel_config_set_dreq(&config, uart_get_dreq(uart(), true));
+        dma_channel_configure(m_txDma, &config, &uart_get_hw(uart())->dr, m_txBuffer, 0, false);
+
+        dma_channel_set_irq1_enabled(m_txDma, true);
+        irq_add_shared_handler(DMA_IRQ_1, &PicoUartTransport::onDmaIrq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+
+    // Queues the bytes as a whole; false if the ring has no room for them.
+    bool write(const uint8_t* data, uint32_t count)
+    {
+        const uint32_t interrupts = save_and_disable_interrupts();
+        const bool fits = TxBufferSize - (m_txHead - m_txTail) >= count;
+        if (fits) {
+            for (uint32_t index = 0; index < count; ++index) {
+                m_txBuffer[(m_txHead + index) & (TxBufferSize - 1)] = data[index];
+            }
+            m_txHead = m_txHead + count;
+            startTx();
+        }
+        restore_interrupts(interrupts);
+        return fits;
+    }
+
+    // Sends what is queued and everything written from now on.
+    void start()
+    {
+        const uint32_t interrupts = save_and_disable_interrupts();
+        m_started = true;
+        startTx();
+        restore_interrupts(interrupts);
+    }
+
+    bool read(uint8_t& byte) { return s_rxBytes.pop(byte); }
+
+    // The ring is empty and the UART has shifted out the last stop bit; the
+    // DMA finishing only means the last byte reached the TX FIFO.
+    bool txIdle() const
+    {
+        const uint32_t flags = uart_get_hw(uart())->fr;
+        return m_txHead == m_txTail && (flags & UART_UARTFR_TXFE_BITS) && !(flags & UART_UARTFR_BUSY_BITS);
+    }
+    uint32_t droppedRxBytes() const { return s_rxBytes.dropped(); }
+
+    // Sets the baud divider again after clk_peri changed.
+    void onClockChanged(uint baudRate) { uart_set_baudrate(uart(), baudRate); }
+
+private:
+    static uart_inst_t* uart() { return UART_INSTANCE(UartIndex); }
+
+    // Sends everything queued so far as one DMA transfer, so frames queued
+    // together (e.g. at startup) go out back-to-back. Call with interrupts off.
+    void startTx()
+    {
+        if (!m_started || m_txInFlight != 0) {
+            return;
+        }
+        const uint32_t count = m_txHead - m_txTail;
+        if (count == 0) {
+            return;
+        }
+        m_txInFlight = count;
+        dma_channel_transfer_from_buffer_now(m_txDma, &m_txBuffer[m_txTail & (TxBufferSize - 1)], count);
+    }
+
+    static void onDmaIrq()
+    {
+        PicoUartTransport* transport = s_instance;
+        if (!dma_channel_get_irq1_status(transport->m_txDma)) {
+            return; // Another channel sharing the interrupt
+        }
+        dma_channel_acknowledge_irq1(transport->m_txDma);
+        transport->m_txTail = transport->m_txTail + transport->m_txInFlight;
+        transport->m_txInFlight = 0;
+        transport->startTx();
+    }
+
+    static void onUartIrq()
+    {
+        while (uart_is_readable(uart())) {
+            s_rxBytes.push(uart_getc(uart()));
+        }
+    }
+
+    alignas(TxBufferSize) uint8_t m_txBuffer[TxBufferSize];
+    volatile uint32_t m_txHead = 0;     // Written by write
+    volatile uint32_t m_txTail = 0;     // Written by the DMA interrupt
+    volatile uint32_t m_txInFlight = 0; // Bytes in the running transfer
+    uint m_txDma;
+    volatile bool m_started = false;
+
+    static inline EventQueue<uint8_t, RxBufferSize> s_rxBytes;
+    static inline PicoUartTransport* s_instance = nullptr;
+};
+
+// The module on UART 0 - 0 is TX, 1 is RX.
+using PicoUart0Transport = PicoUartTransport<0, 0, 1>;
+// A second module on UART 1 - 8 is TX, 9 is RX, clear of the key matrix
+// (2 to 5) and the PWM audio pin (18).
+using PicoUart1Transport = PicoUartTransport<1, 8, 9>;
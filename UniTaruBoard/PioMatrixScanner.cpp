@@ -0,0 +1,92 @@
+#include "PioMatrixScanner.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "key_matrix.pio.h"
+
+// A multiple of every supported row count, so the rings restart on row 0.
+static constexpr uint32_t DmaTransferCount = 0xfffffff0u;
+
+bool PioMatrixScanner::start(PIO pio, uint rowBase, uint rowCount, uint colBase, uint colCount, uint settleUs)
+{
+    if (rowCount == 0 || rowCount > MaxRows || (rowCount & (rowCount - 1)) != 0) {
+        return false;
+    }
+    if (!pio_can_add_program(pio, &key_matrix_program)) {
+        return false;
+    }
+    const int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return false;
+    }
+
+    m_pio = pio;
+    m_sm = sm;
+    m_rowCount = rowCount;
+    m_ringBits = 0;
+    while ((1u << m_ringBits) < rowCount * sizeof(uint32_t)) {
+        ++m_ringBits;
+    }
+    for (uint row = 0; row < rowCount; ++row) {
+        m_patterns[row] = 1u << row;
+    }
+
+    const uint offset = pio_add_program(pio, &key_matrix_program);
+    key_matrix_program_init(pio, sm, offset, rowBase, rowCount, colBase, colCount, clockDivider());
+
+    // Y = settle time, loaded through the TX FIFO before DMA takes it over.
+    pio_sm_put_blocking(pio, sm, settleUs);
+    pio_sm_exec(pio, sm, pio_encode_pull(false, false));
+    pio_sm_exec(pio, sm, pio_encode_mov(pio_y, pio_osr));
+
+    m_patternDma = dma_claim_unused_channel(true);
+    m_rowDma = dma_claim_unused_channel(true);
+    startDma();
+
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+// Run the program at 1 MHz so the settle loop counts microseconds.
+float PioMatrixScanner::clockDivider()
+{
+    return clock_get_hz(clk_sys) / 1000000.0f;
+}
+
+void PioMatrixScanner::onClockChanged()
+{
+    if (m_pio) {
+        pio_sm_set_clkdiv(m_pio, m_sm, clockDivider());
+    }
+}
+
+void PioMatrixScanner::startDma()
+{
+    // Row patterns: read ring over the pattern table into the TX FIFO.
+    dma_channel_config config = dma_channel_get_default_config(m_patternDma);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, m_ringBits);
+    channel_config_set_dreq(&config, pio_get_dreq(m_pio, m_sm, true));
+    dma_channel_configure(m_patternDma, &config, &m_pio->txf[m_sm], m_patterns, DmaTransferCount, false);
+
+    // Column snapshots: RX FIFO into a write ring, one word per row.
+    config = dma_channel_get_default_config(m_rowDma);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, m_ringBits);
+    channel_config_set_dreq(&config, pio_get_dreq(m_pio, m_sm, false));
+    dma_channel_configure(m_rowDma, &config, m_rows, &m_pio->rxf[m_sm], DmaTransferCount, false);
+
+    dma_start_channel_mask((1u << m_patternDma) | (1u << m_rowDma));
+}
+
+void PioMatrixScanner::service()
+{
+    // The state machine stalls on an empty TX FIFO once the patterns run out,
+    // after which the last snapshot completes the row channel too.
+    if (!dma_channel_is_busy(m_patternDma) && !dma_channel_is_busy(m_rowDma)) {
+        startDma();
+    }
+}
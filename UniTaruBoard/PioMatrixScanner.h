@@ -0,0 +1,42 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Scans a key matrix entirely in PIO and DMA.
+// One DMA channel feeds one-hot row patterns to the key_matrix program and a
+// second stores each row's column snapshot, so the latest bitmap of every row
+// is always in memory without any CPU work. Rows and columns must each be
+// consecutive GPIOs, and the row count a power of two.
+class PioMatrixScanner
+{
+public:
+    static constexpr uint MaxRows = 8;
+
+    bool start(PIO pio, uint rowBase, uint rowCount, uint colBase, uint colCount, uint settleUs);
+
+    // Latest column snapshot of a row, bit n for GPIO colBase + n.
+    uint32_t row(uint index) const { return m_rows[index]; }
+
+    // Restarts the DMA channels when their transfer count runs out.
+    void service();
+
+    // Sets the divider again after clk_sys changed, so the settle time and
+    // the row rate stay in microseconds.
+    void onClockChanged();
+
+private:
+    void startDma();
+    static float clockDivider();
+
+    static constexpr uint RingBytes = MaxRows * sizeof(uint32_t);
+
+    PIO m_pio = nullptr;
+    uint m_sm = 0;
+    uint m_rowCount = 0;
+    uint m_ringBits = 0;
+    int m_patternDma = -1;
+    int m_rowDma = -1;
+    alignas(RingBytes) uint32_t m_patterns[MaxRows] = {};
+    alignas(RingBytes) volatile uint32_t m_rows[MaxRows] = {};
+};
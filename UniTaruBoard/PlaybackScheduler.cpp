@@ -0,0 +1,110 @@
+#include "PlaybackScheduler.h"
+#include "TraceProbes.h"
+
+PlaybackScheduler::Policy PlaybackScheduler::policyFromValue(uint32_t value)
+{
+    switch (value) {
+    case static_cast<uint32_t>(Policy::Queue):
+        return Policy::Queue;
+    default:
+        return Policy::Interrupt;
+    }
+}
+
+void PlaybackScheduler::setBusyPin(uint pin)
+{
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
+    m_busyPin = static_cast<int>(pin);
+}
+
+bool PlaybackScheduler::request(uint8_t folder, uint8_t track, uint8_t priority)
+{
+    const uint32_t now = time_us_32();
+
+    if (m_policy == Policy::Interrupt) {
+        // Anything not sent yet is superseded by the newest press.
+        m_coalesced += m_count;
+        m_head = 0;
+        m_count = 1;
+        m_queue[0] = {folder, track, priority, true, now};
+        return true;
+    }
+
+    // A request that outranks the playing track may cut it off, and one that
+    // outranks everything queued goes to the front.
+    const Request queued = {folder, track, priority, m_playing && priority > m_playingPriority, now};
+    bool first = m_count > 0;
+    for (uint8_t index = 0; index < m_count && first; ++index) {
+        first = priority > at(index).priority;
+    }
+
+    if (m_count == QueueDepth) {
+        ++m_dropped;
+        if (!first) {
+            return false;
+        }
+        --m_count; // Make room by dropping the last one
+    }
+    if (first) {
+        m_head = (m_head + QueueDepth - 1) % QueueDepth;
+        ++m_count;
+        at(0) = queued;
+    } else {
+        ++m_count;
+        at(m_count - 1) = queued;
+    }
+    return true;
+}
+
+void PlaybackScheduler::onResponse(const DfResponse& response)
+{
+    // The module may report the same track end twice; both mean idle.
+    if (response.cmd == NotifyTrackFinished) {
+        m_playing = false;
+    }
+}
+
+void PlaybackScheduler::updatePlaying()
+{
+    if (!m_playing) {
+        return;
+    }
+    const uint32_t sinceSendUs = time_us_32() - m_lastSendUs;
+    if (m_busyPin < 0) {
+        if (sinceSendUs >= MaxPlayUs) {
+            m_playing = false; // The 0x3D notification never came
+            ++m_playTimeouts;
+        }
+        return;
+    }
+    if (sinceSendUs >= BusySettleUs && gpio_get(m_busyPin)) {
+        m_playing = false;
+    }
+}
+
+void PlaybackScheduler::poll(DfPlayerPicoSd& player)
+{
+    updatePlaying();
+
+    if (m_count == 0) {
+        return;
+    }
+    const uint32_t now = time_us_32();
+    if (now - m_lastSendUs < MinCommandIntervalUs) {
+        return; // Requests keep coalescing meanwhile
+    }
+    const Request& next = at(0);
+    if (m_playing && !next.interrupt) {
+        return;
+    }
+
+    player.playSound(next.folder, next.track);
+    trace_record(TraceKeyToPlay, now - next.queuedUs);
+    m_playing = true;
+    m_playingPriority = next.priority;
+    m_lastSendUs = now;
+    m_head = (m_head + 1) % QueueDepth;
+    --m_count;
+}
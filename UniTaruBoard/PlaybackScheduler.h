@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include "pico/stdlib.h"
+#include "DfPlayerPicoSd.h"
+
+// Decides when key presses turn into DFPlayer play commands.
+//
+// The module takes a command every MinCommandIntervalUs at most; presses
+// arriving faster are coalesced instead of piling up in the UART queue.
+// With Policy::Interrupt the latest request replaces anything pending and
+// cuts off the current track. With Policy::Queue requests wait for the
+// current track to end, unless their priority is higher than the playing
+// one. Track end comes from the module's 0x3D notification, or from the
+// BUSY pin when one is wired. Without BUSY a track counts as ended after
+// MaxPlayUs too, so a lost notification cannot hold the queue forever.
+class PlaybackScheduler
+{
+public:
+    enum class Policy : uint8_t
+    {
+        Interrupt,
+        Queue,
+    };
+
+    static constexpr uint8_t NotifyTrackFinished = 0x3D;
+    static constexpr uint32_t MinCommandIntervalUs = 30000;
+    // BUSY goes low this long after a play command at the latest.
+    static constexpr uint32_t BusySettleUs = 200000;
+    // Longer than any sound on the card.
+    static constexpr uint32_t MaxPlayUs = 30000000;
+    static constexpr uint8_t QueueDepth = 8;
+
+    // Policy stored as a config value; unknown values give Policy::Interrupt.
+    static Policy policyFromValue(uint32_t value);
+
+    void setPolicy(Policy policy) { m_policy = policy; }
+
+    // BUSY output of the module, low while playing.
+    void setBusyPin(uint pin);
+
+    // Returns false if the request was dropped because the queue is full.
+    bool request(uint8_t folder, uint8_t track, uint8_t priority = 0);
+
+    void onResponse(const DfResponse& response);
+
+    // Sends the next play command when the module can take it.
+    void poll(DfPlayerPicoSd& player);
+
+    bool playing() const { return m_playing; }
+    uint32_t coalescedRequests() const { return m_coalesced; }
+    uint32_t droppedRequests() const { return m_dropped; }
+    uint32_t playTimeouts() const { return m_playTimeouts; }
+
+private:
+    struct Request
+    {
+        uint8_t folder;
+        uint8_t track;
+        uint8_t priority;
+        bool interrupt;    // May cut off the playing track
+        uint32_t queuedUs; // For the key-to-play latency probe
+    };
+
+    Request& at(uint8_t index) { return m_queue[(m_head + index) % QueueDepth]; }
+    void updatePlaying();
+
+    Policy m_policy = Policy::Interrupt;
+    int m_busyPin = -1;
+    Request m_queue[QueueDepth];
+    uint8_t m_head = 0;
+    uint8_t m_count = 0;
+    bool m_playing = false;
+    uint8_t m_playingPriority = 0;
+    uint32_t m_lastSendUs = 0;
+    uint32_t m_coalesced = 0;
+    uint32_t m_dropped = 0;
+    uint32_t m_playTimeouts = 0;
+};
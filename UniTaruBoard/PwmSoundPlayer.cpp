@@ -0,0 +1,132 @@
+#include "PwmSoundPlayer.h"
+#include "SoundBank.h"
+#include "TraceProbes.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+PwmSoundPlayer* PwmSoundPlayer::s_instance = nullptr;
+
+PwmSoundPlayer::PwmSoundPlayer()
+{
+    s_instance = this;
+
+    gpio_set_function(AudioPin, GPIO_FUNC_PWM);
+    m_slice = pwm_gpio_to_slice_num(AudioPin);
+    pwm_config pwm = pwm_get_default_config();
+    pwm_config_set_wrap(&pwm, PwmWrap);
+    pwm_init(m_slice, &pwm, true);
+
+    // Both buffers start as silence at the midpoint.
+    for (auto& buffer : m_buffers) {
+        fill(buffer);
+    }
+
+    m_timer = dma_claim_unused_timer(true);
+    onClockChanged();
+
+    m_dma[0] = dma_claim_unused_channel(true);
+    m_dma[1] = dma_claim_unused_channel(true);
+    for (uint index = 0; index < 2; ++index) {
+        // A 16-bit write reaches both halves of CC; only channel A is used.
+        dma_channel_config config = dma_channel_get_default_config(m_dma[index]);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_dreq(&config, dma_get_timer_dreq(m_timer));
+        channel_config_set_chain_to(&config, m_dma[1 - index]);
+        dma_channel_configure(m_dma[index], &config, &pwm_hw->slice[m_slice].cc, m_buffers[index], BufferSamples,
+                              false);
+        dma_channel_set_irq0_enabled(m_dma[index], true);
+    }
+    irq_add_shared_handler(DMA_IRQ_0, &PwmSoundPlayer::onDmaIrq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    dma_channel_start(m_dma[0]);
+}
+
+void PwmSoundPlayer::onClockChanged()
+{
+    // clk_sys * 1 / den, rounded to the nearest sample rate.
+    const uint32_t clock = clock_get_hz(clk_sys);
+    const uint32_t den = (clock + SoundMixer::SampleRate / 2) / SoundMixer::SampleRate;
+    dma_timer_set_fraction(m_timer, 1, static_cast<uint16_t>(den));
+}
+
+void PwmSoundPlayer::setResponseHandler(ResponseCallback callback, void* context)
+{
+    m_responseHandler = callback;
+    m_responseContext = context;
+}
+
+bool PwmSoundPlayer::hasSound(uint8_t folder, uint8_t track) const
+{
+    return findSound(folder, track) != nullptr;
+}
+
+void PwmSoundPlayer::playSound(uint8_t folder, uint8_t soundNumber)
+{
+    const SoundClip* clip = findSound(folder, soundNumber);
+    if (!clip) return;
+
+    // The mixer runs in the DMA interrupt.
+    const uint32_t interrupts = save_and_disable_interrupts();
+    const uint8_t voice = m_mixer.play(*clip, soundNumber, SoundMixer::UnityGain, time_us_32());
+    m_voiceFolder[voice] = folder;
+    restore_interrupts(interrupts);
+}
+
+void PwmSoundPlayer::setVolume(uint8_t volume)
+{
+    if (volume > MaxVolume) volume = MaxVolume;
+    m_mixer.setVolume(volume * SoundMixer::UnityGain / MaxVolume);
+}
+
+void PwmSoundPlayer::poll()
+{
+    Finished finished;
+    while (m_finished.pop(finished)) {
+        if (!m_responseHandler) continue;
+        DfResponse response = {NotifyTrackFinished, 0, finished.track, {}};
+        m_responseHandler(response, m_responseContext);
+    }
+}
+
+void PwmSoundPlayer::fill(uint16_t* buffer)
+{
+    const uint32_t ended = m_mixer.render(m_mix, BufferSamples);
+
+    // Signed samples to PWM levels around the midpoint.
+    for (uint32_t index = 0; index < BufferSamples; ++index) {
+        buffer[index] = static_cast<uint16_t>((m_mix[index] + 32768) >> 6);
+    }
+
+    // This buffer starts playing once the other one is done, within one
+    // buffer period.
+    constexpr uint32_t BufferUs = BufferSamples * 1000000 / SoundMixer::SampleRate;
+    const uint32_t now = time_us_32();
+    for (uint8_t voice = 0; voice < SoundMixer::Voices; ++voice) {
+        if (m_mixer.startedVoices() & (1u << voice)) {
+            trace_record(TraceKeyToPlay, now - m_mixer.voiceStartUs(voice) + BufferUs);
+        }
+        if (ended & (1u << voice)) {
+            m_finished.push({m_voiceFolder[voice], m_mixer.voiceId(voice)});
+        }
+    }
+}
+
+void PwmSoundPlayer::onDmaIrq()
+{
+    PwmSoundPlayer* player = s_instance;
+    for (uint index = 0; index < 2; ++index) {
+        const uint channel = player->m_dma[index];
+        if (!dma_channel_get_irq0_status(channel)) continue;
+        dma_channel_acknowledge_irq0(channel);
+
+        // The other channel plays now; this one restarts when it is chained
+        // to again, with the transfer count it was configured with.
+        player->fill(player->m_buffers[index]);
+        dma_channel_set_read_addr(channel, player->m_buffers[index], false);
+    }
+}
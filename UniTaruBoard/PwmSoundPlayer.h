@@ -0,0 +1,74 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "DfResponseParser.h"
+#include "EventQueue.h"
+#include "SoundMixer.h"
+
+// Plays the built-in SoundBank through PWM instead of a DFPlayer module
+// (UNITARU_PCM_BACKEND builds).
+//
+// Two DMA channels chained to each other feed the PWM compare register from
+// two buffers at the sample rate, paced by a DMA timer. Whenever one buffer
+// finishes, its interrupt mixes the next samples into it while the other
+// plays, so a new sound is heard within two buffers (about 3 ms). The public
+// interface follows DfPlayerPicoSd, and a voice that ends is reported as
+// the module's track finished notification.
+class PwmSoundPlayer
+{
+public:
+    using ResponseCallback = void (*)(const DfResponse& response, void* context);
+
+    static constexpr uint AudioPin = 18;
+    static constexpr uint32_t BufferSamples = 32;
+    static constexpr uint16_t PwmWrap = 1023; // 10-bit output
+    static constexpr uint8_t NotifyTrackFinished = 0x3D;
+    static constexpr uint8_t MaxVolume = 30;  // DFPlayer scale
+
+    PwmSoundPlayer();
+
+    // Reports finished voices. Call from the main loop.
+    void poll();
+
+    void setResponseHandler(ResponseCallback callback, void* context = nullptr);
+
+    void playSound(uint8_t soundNumber) { playSound(m_folder, soundNumber); }
+    void playSound(uint8_t folder, uint8_t soundNumber);
+    void setVolume(uint8_t volume);
+    void setFolder(uint8_t folder) { m_folder = folder; }
+    uint8_t folder() const { return m_folder; }
+
+    bool hasSound(uint8_t folder, uint8_t track) const;
+
+    // Commands take effect at once; there is no link to wait for.
+    bool txIdle() const { return true; }
+
+    // Sets the sample rate timer again after clk_sys changed.
+    void onClockChanged();
+
+    bool playing() const { return m_mixer.active(); }
+
+private:
+    struct Finished
+    {
+        uint8_t folder;
+        uint8_t track;
+    };
+
+    void fill(uint16_t* buffer);
+    static void onDmaIrq();
+
+    SoundMixer m_mixer;
+    alignas(4) uint16_t m_buffers[2][BufferSamples];
+    int16_t m_mix[BufferSamples];
+    uint m_dma[2];
+    int m_timer;
+    uint m_slice;
+    uint8_t m_folder = 1;
+    uint8_t m_voiceFolder[SoundMixer::Voices] = {};
+    ResponseCallback m_responseHandler = nullptr;
+    void* m_responseContext = nullptr;
+    EventQueue<Finished, 8> m_finished;
+
+    static PwmSoundPlayer* s_instance;
+};
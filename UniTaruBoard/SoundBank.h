@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include "SoundMixer.h"
+
+// Sounds built into the firmware, addressed like files on the DFPlayer's
+// card. SoundBankData.h is written by convert_sounds.py.
+struct SoundBankEntry
+{
+    uint8_t folder;
+    uint8_t track;
+    SoundClip clip;
+};
+
+#include "SoundBankData.h"
+
+constexpr const SoundClip* findSound(uint8_t folder, uint8_t track)
+{
+    for (const SoundBankEntry& entry : SoundBank) {
+        if (entry.folder == folder && entry.track == track) return &entry.clip;
+    }
+    return nullptr;
+}
@@ -0,0 +1,358 @@
+#pragma once
+
+// Generated by convert_sounds.py: 1:1=tone:523:120 1:2=tone:659:120 1:3=tone:784:120 1:4=tone:1047:120
+
+// tone:523:120, 2646 samples
+alignas(4) inline constexpr uint8_t Sound01_001[] = {
+    0x70, 0x77, 0x37, 0x43, 0x24, 0x23, 0x12, 0x90, 0xcc, 0xcd, 0xcc, 0xcb, 0xcb, 0xbb, 0xac, 0xaa,
+    0x88, 0x10, 0x44, 0x44, 0x44, 0x43, 0x33, 0x34, 0x33, 0x22, 0x12, 0x98, 0xda, 0xdc, 0xcb, 0xbc,
+    0xbc, 0xac, 0xbb, 0xab, 0x9a, 0x09, 0x31, 0x54, 0x44, 0x53, 0x33, 0x34, 0x43, 0x22, 0x22, 0x01,
+    0x90, 0xca, 0xbd, 0xbd, 0xbc, 0xbc, 0xbc, 0xba, 0xaa, 0x9a, 0x00, 0x31, 0x54, 0x53, 0x43, 0x24,
+    0x33, 0x24, 0x32, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x99, 0x88,
+    0x22, 0x44, 0x34, 0x35, 0x34, 0x43, 0x32, 0x23, 0x22, 0x01, 0x98, 0xda, 0xdb, 0xbc, 0xbc, 0xbc,
+    0xbb, 0xac, 0xaa, 0x9a, 0x08, 0x21, 0x63, 0x53, 0x43, 0x43, 0x33, 0x43, 0x22, 0x13, 0x01, 0x90,
+    0xca, 0xbc, 0xcd, 0xbb, 0xad, 0xbb, 0xcb, 0x9a, 0x9a, 0x88, 0x21, 0x53, 0x53, 0x34, 0x43, 0x24,
+    0x33, 0x23, 0x13, 0x02, 0x90, 0xca, 0xcc, 0xbc, 0xbd, 0xcb, 0xca, 0xaa, 0xaa, 0x9a, 0x88, 0x11,
+    0x53, 0x53, 0x34, 0x43, 0x24, 0x33, 0x23, 0x23, 0x11, 0x90, 0xba, 0xbe, 0xcd, 0xbb, 0xbc, 0xbc,
+    0xbb, 0xba, 0x9a, 0x89, 0x11, 0x44, 0x34, 0x35, 0x44, 0x32, 0x43, 0x22, 0x22, 0x11, 0x90, 0xb9,
+    0xcc, 0xcc, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0x9a, 0x89, 0x11, 0x42, 0x35, 0x44, 0x43, 0x33, 0x43,
+    0x23, 0x13, 0x12, 0x80, 0xaa, 0xcd, 0xdb, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0x9a, 0x89, 0x10, 0x42,
+    0x44, 0x34, 0x34, 0x34, 0x33, 0x43, 0x22, 0x11, 0x00, 0xaa, 0xcc, 0xbc, 0xbd, 0xbc, 0xbb, 0xbc,
+    0xba, 0xaa, 0x89, 0x10, 0x42, 0x35, 0x35, 0x34, 0x34, 0x33, 0x24, 0x22, 0x12, 0x00, 0xa9, 0xcc,
+    0xbc, 0xbd, 0xdb, 0xba, 0xbb, 0xac, 0xa9, 0x89, 0x00, 0x32, 0x45, 0x53, 0x33, 0x44, 0x32, 0x33,
+    0x22, 0x22, 0x00, 0xa9, 0xcc, 0xcc, 0xbc, 0xcb, 0xac, 0xbb, 0xab, 0x9b, 0x8a, 0x18, 0x32, 0x46,
+    0x43, 0x34, 0x34, 0x43, 0x32, 0x22, 0x12, 0x01, 0xa9, 0xdb, 0xcc, 0xcb, 0xbc, 0xcb, 0xab, 0xbb,
+    0xba, 0x99, 0x00, 0x32, 0x36, 0x35, 0x35, 0x43, 0x42, 0x22, 0x13, 0x12, 0x01, 0xa8, 0xcb, 0xcc,
+    0xbc, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x99, 0x00, 0x31, 0x44, 0x44, 0x43, 0x43, 0x33, 0x43, 0x22,
+    0x12, 0x01, 0xa8, 0xca, 0xcc, 0xbc, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x8a, 0x08, 0x21, 0x44, 0x44,
+    0x43, 0x43, 0x33, 0x43, 0x22, 0x22, 0x00, 0x90, 0xcb, 0xcc, 0xdb, 0xcb, 0xbb, 0xcb, 0xbb, 0xaa,
+    0x9a, 0x08, 0x21, 0x35, 0x45, 0x43, 0x43, 0x33, 0x43, 0x22, 0x22, 0x01, 0x88, 0xbb, 0xbe, 0xbd,
+    0xbc, 0xbc, 0xbb, 0xac, 0xba, 0x99, 0x88, 0x21, 0x44, 0x53, 0x34, 0x53, 0x32, 0x33, 0x24, 0x21,
+    0x01, 0x90, 0xba, 0xbd, 0xcd, 0xbb, 0xcc, 0xba, 0xbb, 0xba, 0xa9, 0x88, 0x21, 0x44, 0x44, 0x53,
+    0x33, 0x53, 0x32, 0x22, 0x13, 0x02, 0x90, 0xba, 0xcd, 0xbc, 0xcc, 0xbb, 0xbc, 0xba, 0xab, 0xaa,
+    0x09, 0x20, 0x44, 0x44, 0x43, 0x34, 0x43, 0x32, 0x33, 0x32, 0x11, 0x90, 0xba, 0xdd, 0xcb, 0xbc,
+    0xbc, 0xbb, 0xbc, 0xaa, 0xaa, 0x88, 0x10, 0x53, 0x44, 0x43, 0x34, 0x33, 0x34, 0x33, 0x23, 0x11,
+    0x80, 0xc9, 0xdb, 0xcc, 0xcb, 0xcb, 0xbb, 0xac, 0xaa, 0xaa, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+    0x34, 0x33, 0x24, 0x22, 0x02, 0x00, 0xb9, 0xcc, 0xcc, 0xcb, 0xcb, 0xbb, 0xbb, 0xac, 0x9a, 0x89,
+    0x18, 0x43, 0x44, 0x53, 0x43, 0x33, 0x43, 0x23, 0x23, 0x12, 0x80, 0xa9, 0xdc, 0xdb, 0xcb, 0xcb,
+    0xbb, 0xcb, 0xaa, 0xaa, 0x89, 0x18, 0x42, 0x44, 0x53, 0x43, 0x33, 0x43, 0x33, 0x22, 0x12, 0x81,
+    0xb8, 0xcc, 0xcc, 0xdb, 0xbb, 0xbc, 0xbb, 0xbb, 0xaa, 0x8a, 0x18, 0x52, 0x63, 0x43, 0x43, 0x43,
+    0x33, 0x33, 0x33, 0x22, 0x00, 0xa9, 0xdc, 0xdb, 0xdb, 0xbb, 0xbc, 0xbb, 0xbb, 0xab, 0x99, 0x18,
+    0x42, 0x54, 0x53, 0x33, 0x44, 0x32, 0x33, 0x32, 0x12, 0x01, 0xa8, 0xcc, 0xcc, 0xcb, 0xbc, 0xcb,
+    0xba, 0xbb, 0xab, 0x99, 0x18, 0x41, 0x34, 0x36, 0x53, 0x33, 0x34, 0x32, 0x33, 0x22, 0x81, 0x98,
+    0xbc, 0xbe, 0xcc, 0xcb, 0xbb, 0xcb, 0xab, 0xab, 0x99, 0x08, 0x32, 0x54, 0x53, 0x43, 0x43, 0x33,
+    0x43, 0x22, 0x22, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x8a, 0x88, 0x31,
+    0x44, 0x34, 0x35, 0x34, 0x33, 0x34, 0x32, 0x22, 0x01, 0x98, 0xda, 0xdb, 0xbc, 0xbc, 0xbc, 0xbb,
+    0xac, 0xaa, 0x9a, 0x08, 0x21, 0x63, 0x53, 0x43, 0x43, 0x33, 0x43, 0x22, 0x13, 0x01, 0x90, 0xca,
+    0xeb, 0xcb, 0xcb, 0xac, 0xbb, 0xbb, 0xbb, 0xaa, 0x88, 0x31, 0x54, 0x34, 0x44, 0x43, 0x33, 0x24,
+    0x23, 0x22, 0x01, 0x90, 0xc9, 0xbc, 0xcd, 0xbb, 0xcc, 0xba, 0xbb, 0xba, 0x9a, 0x88, 0x30, 0x63,
+    0x53, 0x34, 0x43, 0x43, 0x33, 0x23, 0x23, 0x11, 0x88, 0xba, 0xbe, 0xcd, 0xbb, 0xbc, 0xbc, 0xbb,
+    0xba, 0x9a, 0x89, 0x20, 0x44, 0x34, 0x35, 0x44, 0x32, 0x43, 0x22, 0x22, 0x11, 0x90, 0xb9, 0xcc,
+    0xcc, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0x9a, 0x89, 0x11, 0x42, 0x35, 0x44, 0x43, 0x33, 0x43, 0x23,
+    0x32, 0x11, 0x80, 0xb9, 0xcd, 0xdb, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0x9a, 0x89, 0x28, 0x42, 0x44,
+    0x53, 0x43, 0x33, 0x24, 0x33, 0x22, 0x12, 0x80, 0xb9, 0xcc, 0xcc, 0xbc, 0xbc, 0xbb, 0xbc, 0xab,
+    0xaa, 0x89, 0x00, 0x43, 0x54, 0x43, 0x43, 0x24, 0x33, 0x33, 0x33, 0x12, 0x81, 0xb9, 0xbd, 0xbe,
+    0xbc, 0xcc, 0xba, 0xbb, 0xac, 0xa9, 0x89, 0x00, 0x32, 0x45, 0x43, 0x34, 0x34, 0x43, 0x32, 0x22,
+    0x12, 0x00, 0xa9, 0xdb, 0xcc, 0xbc, 0xcb, 0xac, 0xbb, 0xab, 0x9b, 0x8a, 0x18, 0x32, 0x36, 0x45,
+    0x33, 0x44, 0x32, 0x33, 0x32, 0x12, 0x01, 0xa9, 0xcc, 0xbc, 0xcd, 0xca, 0xba, 0xac, 0xaa, 0xaa,
+    0x99, 0x00, 0x31, 0x54, 0x43, 0x34, 0x34, 0x43, 0x32, 0x32, 0x21, 0x00, 0x98, 0xdb, 0xcc, 0xcb,
+    0xbc, 0xcb, 0xba, 0xbb, 0xab, 0x8a, 0x08, 0x41, 0x63, 0x43, 0x34, 0x34, 0x33, 0x34, 0x32, 0x12,
+    0x01, 0xa8, 0xda, 0xbc, 0xbd, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43,
+    0x43, 0x33, 0x43, 0x22, 0x12, 0x01, 0x90, 0xcb, 0xcc, 0xdb, 0xcb, 0xbb, 0xcb, 0xab, 0xab, 0x9a,
+    0x08, 0x21, 0x35, 0x45, 0x43, 0x43, 0x33, 0x43, 0x22, 0x22, 0x01, 0x98, 0xba, 0xbe, 0xbd, 0xbc,
+    0xbc, 0xbb, 0xac, 0xaa, 0x9a, 0x88, 0x21, 0x63, 0x53, 0x43, 0x43, 0x33, 0x43, 0x22, 0x13, 0x11,
+    0x98, 0xc9, 0xbc, 0xcd, 0xbb, 0xcc, 0xba, 0xbb, 0xba, 0xa9, 0x88, 0x21, 0x44, 0x44, 0x43, 0x34,
+    0x43, 0x23, 0x33, 0x22, 0x02, 0x90, 0xba, 0xbe, 0xcd, 0xbb, 0xcc, 0xba, 0xbb, 0xba, 0x9a, 0x89,
+    0x21, 0x63, 0x53, 0x53, 0x33, 0x53, 0x32, 0x32, 0x22, 0x11, 0x90, 0xb9, 0xcd, 0xbc, 0xcc, 0xbb,
+    0xac, 0xbb, 0xbb, 0xaa, 0x88, 0x20, 0x53, 0x44, 0x34, 0x44, 0x32, 0x43, 0x22, 0x22, 0x11, 0x80,
+    0xb9, 0xcc, 0xcc, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0x9a, 0x89, 0x10, 0x43, 0x44, 0x53, 0x43, 0x33,
+    0x24, 0x33, 0x22, 0x12, 0x80, 0xaa, 0xbd, 0xcd, 0xcb, 0xcb, 0xbb, 0xcb, 0xaa, 0xaa, 0x89, 0x10,
+    0x42, 0x44, 0x34, 0x34, 0x34, 0x33, 0x24, 0x22, 0x12, 0x80, 0xa9, 0xcc, 0xdb, 0xbc, 0xbc, 0xbb,
+    0xbc, 0xab, 0xaa, 0x99, 0x10, 0x42, 0x35, 0x44, 0x34, 0x43, 0x42, 0x22, 0x22, 0x11, 0x00, 0x99,
+    0xbc, 0xbd, 0xbd, 0xcb, 0xac, 0xbb, 0xab, 0x9b, 0x8a, 0x18, 0x42, 0x44, 0x34, 0x35, 0x43, 0x33,
+    0x33, 0x23, 0x13, 0x81, 0xb8, 0xcc, 0xbd, 0xcc, 0xcb, 0xbb, 0xac, 0xab, 0xaa, 0x99, 0x18, 0x41,
+    0x53, 0x34, 0x35, 0x33, 0x25, 0x23, 0x23, 0x12, 0x81, 0xa8, 0xcb, 0xcd, 0xcb, 0xbc, 0xcb, 0xab,
+    0xbb, 0xab, 0x99, 0x08, 0x32, 0x55, 0x43, 0x34, 0x34, 0x33, 0x34, 0x22, 0x22, 0x01, 0x99, 0xcb,
+    0xcd, 0xcb, 0xbc, 0xcb, 0xba, 0xbb, 0xab, 0x9a, 0x08, 0x32, 0x45, 0x44, 0x43, 0x43, 0x33, 0x43,
+    0x22, 0x12, 0x01, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xbc, 0xbb, 0xac, 0xaa, 0x8a, 0x88, 0x31, 0x44,
+    0x34, 0x35, 0x34, 0x33, 0x34, 0x32, 0x22, 0x01, 0x98, 0xca, 0xbd, 0xbd, 0xbc, 0xbc, 0xbb, 0xac,
+    0xaa, 0x9a, 0x88, 0x21, 0x44, 0x34, 0x35, 0x34, 0x33, 0x34, 0x23, 0x22, 0x11, 0x98, 0xca, 0xcc,
+    0xcc, 0xbb, 0xcc, 0xba, 0xbb, 0xaa, 0xaa, 0x08, 0x20, 0x44, 0x44, 0x34, 0x43, 0x24, 0x33, 0x23,
+    0x23, 0x01, 0x90, 0xca, 0xcc, 0xbc, 0xcc, 0xbb, 0xbc, 0xba, 0xab, 0xaa, 0x88, 0x21, 0x63, 0x53,
+    0x34, 0x43, 0x43, 0x33, 0x23, 0x23, 0x11, 0x90, 0xba, 0xbe, 0xbd, 0xbd, 0xbb, 0xad, 0xab, 0xab,
+    0x9a, 0x89, 0x11, 0x53, 0x44, 0x43, 0x34, 0x43, 0x32, 0x33, 0x23, 0x11, 0x80, 0xba, 0xcd, 0xcc,
+    0xcb, 0xcb, 0xbb, 0xac, 0xaa, 0x9a, 0x89, 0x10, 0x43, 0x44, 0x34, 0x34, 0x34, 0x33, 0x24, 0x22,
+    0x11, 0x80, 0xa9, 0xdc, 0xcb, 0xbc, 0xdb, 0xba, 0xbb, 0xbb, 0xaa, 0x89, 0x10, 0x53, 0x44, 0x34,
+    0x34, 0x34, 0x33, 0x24, 0x22, 0x01, 0x80, 0xaa, 0xcc, 0xbc, 0xcc, 0xca, 0xba, 0xba, 0xaa, 0x9a,
+    0x89, 0x11, 0x43, 0x44, 0x34, 0x53, 0x32, 0x33, 0x33, 0x22, 0x11, 0x90, 0xba, 0xbd, 0xcd, 0xbb,
+    0xbc, 0xcb, 0xba, 0xaa, 0x99, 0x88, 0x21, 0x42, 0x34, 0x35, 0x33, 0x34, 0x32, 0x32, 0x11, 0x81,
+    0x98, 0xcb, 0xcb, 0xac, 0xcb, 0xaa, 0x9a, 0x99, 0x00, 0x21, 0x43,
+};
+
+// tone:659:120, 2646 samples
+alignas(4) inline constexpr uint8_t Sound01_002[] = {
+    0x70, 0x77, 0x57, 0x22, 0x13, 0x02, 0xb9, 0xce, 0xbd, 0xbd, 0xcb, 0xab, 0xaa, 0x08, 0x42, 0x45,
+    0x44, 0x43, 0x33, 0x24, 0x12, 0x81, 0xb8, 0xcd, 0xbc, 0xbd, 0xcb, 0xbb, 0xaa, 0x89, 0x20, 0x63,
+    0x44, 0x43, 0x34, 0x32, 0x23, 0x12, 0x90, 0xda, 0xcc, 0xbc, 0xbc, 0xac, 0xab, 0x9a, 0x09, 0x31,
+    0x45, 0x53, 0x43, 0x43, 0x32, 0x12, 0x01, 0xa8, 0xdb, 0xcc, 0xcb, 0xbb, 0xac, 0xaa, 0x99, 0x00,
+    0x42, 0x44, 0x43, 0x34, 0x32, 0x33, 0x12, 0x81, 0xba, 0xdc, 0xcc, 0xbb, 0xbc, 0xab, 0xab, 0x89,
+    0x11, 0x44, 0x34, 0x35, 0x43, 0x33, 0x22, 0x12, 0x88, 0xca, 0xcc, 0xbc, 0xbc, 0xcb, 0xaa, 0x9a,
+    0x09, 0x30, 0x63, 0x53, 0x33, 0x34, 0x33, 0x22, 0x02, 0xa8, 0xdb, 0xcc, 0xbc, 0xcb, 0xbb, 0xba,
+    0x99, 0x08, 0x32, 0x36, 0x35, 0x34, 0x24, 0x23, 0x12, 0x81, 0x99, 0xcc, 0xbc, 0xcc, 0xba, 0xbb,
+    0xab, 0x8a, 0x10, 0x43, 0x45, 0x34, 0x43, 0x33, 0x32, 0x12, 0x80, 0xba, 0xcd, 0xcc, 0xbb, 0xbc,
+    0xab, 0x9b, 0x89, 0x11, 0x44, 0x44, 0x43, 0x33, 0x24, 0x13, 0x02, 0x90, 0xca, 0xcc, 0xcb, 0xac,
+    0xbb, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x44, 0x33, 0x34, 0x23, 0x23, 0x01, 0xa8, 0xcc, 0xeb, 0xbb,
+    0xbc, 0xbb, 0xbb, 0x99, 0x18, 0x42, 0x35, 0x35, 0x34, 0x24, 0x23, 0x21, 0x80, 0xb8, 0xeb, 0xdb,
+    0xbb, 0xbc, 0xbb, 0xaa, 0x99, 0x20, 0x53, 0x44, 0x53, 0x33, 0x33, 0x33, 0x12, 0x90, 0xca, 0xdc,
+    0xcb, 0xcb, 0xbb, 0xac, 0x99, 0x89, 0x21, 0x43, 0x35, 0x44, 0x23, 0x24, 0x12, 0x01, 0x90, 0xca,
+    0xdb, 0xbc, 0xcb, 0xbb, 0xba, 0x9a, 0x08, 0x41, 0x63, 0x43, 0x43, 0x33, 0x24, 0x12, 0x81, 0x98,
+    0xdb, 0xdb, 0xcb, 0xcb, 0xba, 0xaa, 0x89, 0x18, 0x32, 0x36, 0x44, 0x43, 0x32, 0x23, 0x12, 0x80,
+    0xa9, 0xbd, 0xcd, 0xbb, 0xbc, 0xbb, 0xaa, 0x89, 0x20, 0x63, 0x53, 0x43, 0x33, 0x24, 0x23, 0x11,
+    0x90, 0xba, 0xcd, 0xbc, 0xbc, 0xcb, 0xaa, 0xaa, 0x08, 0x20, 0x44, 0x34, 0x44, 0x33, 0x32, 0x23,
+    0x11, 0xa8, 0xdb, 0xcc, 0xdb, 0xbb, 0xbb, 0xbb, 0x9a, 0x18, 0x32, 0x46, 0x34, 0x34, 0x43, 0x32,
+    0x12, 0x00, 0xa8, 0xcc, 0xdb, 0xcb, 0xcb, 0xaa, 0x9b, 0x99, 0x10, 0x42, 0x44, 0x43, 0x24, 0x33,
+    0x33, 0x12, 0x80, 0xc9, 0xeb, 0xcb, 0xcb, 0xbb, 0xac, 0x9a, 0x09, 0x10, 0x53, 0x53, 0x43, 0x33,
+    0x24, 0x23, 0x01, 0x90, 0xba, 0xcd, 0xbc, 0xbc, 0xac, 0xab, 0x99, 0x09, 0x21, 0x44, 0x44, 0x33,
+    0x34, 0x33, 0x22, 0x01, 0xa8, 0xdb, 0xcc, 0xbc, 0xcb, 0xbb, 0xba, 0x99, 0x08, 0x33, 0x36, 0x35,
+    0x34, 0x24, 0x23, 0x12, 0x00, 0xa9, 0xcc, 0xbc, 0xcc, 0xba, 0xbb, 0xab, 0x99, 0x10, 0x34, 0x45,
+    0x34, 0x43, 0x33, 0x32, 0x12, 0x90, 0xc9, 0xcc, 0xdb, 0xbb, 0xbc, 0xab, 0x9b, 0x09, 0x20, 0x44,
+    0x44, 0x43, 0x33, 0x24, 0x22, 0x11, 0x88, 0xbb, 0xbe, 0xbd, 0xcb, 0xbb, 0xab, 0xaa, 0x08, 0x32,
+    0x45, 0x44, 0x33, 0x34, 0x23, 0x13, 0x01, 0xa8, 0xeb, 0xdb, 0xcb, 0xcb, 0xba, 0xaa, 0x99, 0x00,
+    0x33, 0x45, 0x34, 0x34, 0x24, 0x32, 0x11, 0x81, 0xa9, 0xcc, 0xbc, 0xbd, 0xbb, 0xbb, 0xab, 0x99,
+    0x20, 0x44, 0x44, 0x34, 0x43, 0x33, 0x32, 0x11, 0x80, 0xca, 0xcc, 0xbc, 0xbc, 0xcb, 0xaa, 0xaa,
+    0x88, 0x21, 0x44, 0x53, 0x24, 0x43, 0x32, 0x12, 0x01, 0x90, 0xcb, 0xcc, 0xcb, 0xbc, 0xba, 0xbb,
+    0xa9, 0x18, 0x41, 0x44, 0x53, 0x33, 0x34, 0x23, 0x22, 0x01, 0xa9, 0xcc, 0xcc, 0xcb, 0xbb, 0xac,
+    0xaa, 0x99, 0x10, 0x32, 0x36, 0x35, 0x43, 0x33, 0x23, 0x22, 0x80, 0xba, 0xcd, 0xbc, 0xbd, 0xbb,
+    0xbb, 0xab, 0x89, 0x21, 0x44, 0x44, 0x34, 0x24, 0x33, 0x32, 0x11, 0x88, 0xca, 0xcc, 0xbc, 0xbc,
+    0xac, 0xba, 0xa9, 0x08, 0x21, 0x44, 0x34, 0x44, 0x23, 0x33, 0x23, 0x01, 0xa8, 0xdb, 0xcc, 0xbc,
+    0xcb, 0xbb, 0xba, 0x99, 0x08, 0x42, 0x44, 0x34, 0x34, 0x43, 0x22, 0x22, 0x00, 0xa9, 0xbc, 0xbe,
+    0xbc, 0xcb, 0xab, 0xaa, 0x8a, 0x10, 0x43, 0x35, 0x35, 0x43, 0x33, 0x32, 0x12, 0x80, 0xba, 0xdd,
+    0xcb, 0xcb, 0xbb, 0xac, 0xa9, 0x88, 0x20, 0x43, 0x35, 0x44, 0x23, 0x24, 0x12, 0x11, 0x98, 0xc9,
+    0xdb, 0xdb, 0xca, 0xaa, 0xab, 0x99, 0x09, 0x31, 0x44, 0x44, 0x33, 0x34, 0x23, 0x13, 0x02, 0xa9,
+    0xdb, 0xbd, 0xbc, 0xbc, 0xcb, 0x9a, 0x8a, 0x18, 0x41, 0x53, 0x43, 0x24, 0x33, 0x33, 0x22, 0x81,
+    0xb9, 0xcd, 0xbc, 0xcc, 0xab, 0xbb, 0xab, 0x89, 0x10, 0x34, 0x45, 0x34, 0x43, 0x33, 0x32, 0x02,
+    0x80, 0xba, 0xbe, 0xbd, 0xbc, 0xac, 0xab, 0x9a, 0x88, 0x11, 0x44, 0x34, 0x44, 0x32, 0x33, 0x23,
+    0x02, 0x98, 0xcb, 0xcd, 0xbc, 0xcb, 0xbb, 0xba, 0x9a, 0x08, 0x32, 0x45, 0x44, 0x33, 0x34, 0x23,
+    0x13, 0x01, 0xa9, 0xeb, 0xdb, 0xcb, 0xcb, 0xba, 0xaa, 0x89, 0x18, 0x42, 0x44, 0x43, 0x24, 0x33,
+    0x33, 0x12, 0x81, 0xc9, 0xdb, 0xcc, 0xbb, 0xbc, 0xab, 0xab, 0x89, 0x11, 0x44, 0x34, 0x35, 0x43,
+    0x33, 0x22, 0x12, 0x90, 0xca, 0xcc, 0xbc, 0xbc, 0xcb, 0xaa, 0x9a, 0x09, 0x30, 0x63, 0x53, 0x33,
+    0x34, 0x33, 0x22, 0x02, 0xa8, 0xdb, 0xcc, 0xbc, 0xcb, 0xbb, 0xba, 0x99, 0x08, 0x32, 0x36, 0x35,
+    0x34, 0x24, 0x23, 0x12, 0x81, 0xa8, 0xcc, 0xbc, 0xcc, 0xba, 0xbb, 0xab, 0x8a, 0x28, 0x43, 0x45,
+    0x53, 0x33, 0x33, 0x33, 0x12, 0x81, 0xca, 0xcc, 0xcc, 0xbb, 0xbc, 0xab, 0x9b, 0x89, 0x20, 0x44,
+    0x44, 0x43, 0x33, 0x24, 0x22, 0x02, 0x90, 0xca, 0xbc, 0xbd, 0xbc, 0xac, 0xba, 0x99, 0x09, 0x31,
+    0x44, 0x34, 0x25, 0x24, 0x22, 0x22, 0x01, 0x99, 0xda, 0xdb, 0xcb, 0xbb, 0xac, 0xab, 0x99, 0x18,
+    0x32, 0x45, 0x34, 0x34, 0x43, 0x22, 0x22, 0x80, 0xb8, 0xeb, 0xdb, 0xbb, 0xbc, 0xbb, 0xaa, 0x99,
+    0x20, 0x53, 0x44, 0x53, 0x33, 0x33, 0x23, 0x13, 0x90, 0xca, 0xcc, 0xcc, 0xbb, 0xbc, 0xab, 0xaa,
+    0x09, 0x20, 0x44, 0x44, 0x43, 0x43, 0x32, 0x12, 0x11, 0x98, 0xca, 0xcc, 0xcb, 0xbc, 0xba, 0xbb,
+    0x9a, 0x08, 0x32, 0x45, 0x44, 0x33, 0x34, 0x23, 0x13, 0x01, 0xa8, 0xcc, 0xcc, 0xcb, 0xbb, 0xac,
+    0xaa, 0x8a, 0x18, 0x42, 0x63, 0x43, 0x33, 0x34, 0x22, 0x22, 0x80, 0xb9, 0xcc, 0xbd, 0xbc, 0xcb,
+    0xba, 0xaa, 0x89, 0x20, 0x43, 0x45, 0x43, 0x33, 0x24, 0x23, 0x11, 0x88, 0xba, 0xcd, 0xbc, 0xbc,
+    0xcb, 0xaa, 0xaa, 0x08, 0x20, 0x44, 0x34, 0x44, 0x33, 0x32, 0x23, 0x11, 0xa8, 0xdb, 0xcc, 0xdb,
+    0xbb, 0xbb, 0xbb, 0x9a, 0x18, 0x32, 0x46, 0x34, 0x34, 0x43, 0x32, 0x12, 0x81, 0xa8, 0xcc, 0xdb,
+    0xcb, 0xcb, 0xaa, 0x9b, 0x99, 0x10, 0x32, 0x36, 0x35, 0x43, 0x33, 0x23, 0x22, 0x80, 0xba, 0xcd,
+    0xcc, 0xbb, 0xbc, 0xab, 0x9b, 0x89, 0x20, 0x63, 0x53, 0x43, 0x43, 0x32, 0x22, 0x01, 0x80, 0xbb,
+    0xcd, 0xbc, 0xbc, 0xac, 0xba, 0x99, 0x09, 0x21, 0x44, 0x44, 0x33, 0x34, 0x23, 0x23, 0x01, 0xa8,
+    0xdb, 0xcc, 0xbc, 0xcb, 0xbb, 0xba, 0x99, 0x18, 0x32, 0x36, 0x35, 0x34, 0x24, 0x23, 0x12, 0x00,
+    0xa9, 0xcc, 0xbc, 0xcc, 0xba, 0xbb, 0xab, 0x99, 0x10, 0x34, 0x45, 0x34, 0x43, 0x33, 0x32, 0x12,
+    0x90, 0xc9, 0xcc, 0xdb, 0xbb, 0xbc, 0xab, 0xaa, 0x89, 0x21, 0x44, 0x44, 0x43, 0x33, 0x24, 0x22,
+    0x11, 0x88, 0xbb, 0xbe, 0xbd, 0xcb, 0xbb, 0xab, 0xaa, 0x08, 0x32, 0x45, 0x44, 0x33, 0x34, 0x23,
+    0x13, 0x01, 0xa8, 0xeb, 0xdb, 0xcb, 0xcb, 0xba, 0xaa, 0x99, 0x00, 0x42, 0x44, 0x43, 0x24, 0x33,
+    0x33, 0x22, 0x00, 0xaa, 0xcd, 0xcc, 0xbb, 0xbc, 0xab, 0xab, 0x89, 0x10, 0x34, 0x36, 0x34, 0x34,
+    0x24, 0x22, 0x11, 0x88, 0xb9, 0xbd, 0xbd, 0xbc, 0xac, 0xab, 0x9a, 0x88, 0x21, 0x34, 0x36, 0x34,
+    0x43, 0x23, 0x22, 0x02, 0x98, 0xcb, 0xbd, 0xbd, 0xcb, 0xbb, 0xab, 0x9a, 0x08, 0x32, 0x36, 0x35,
+    0x34, 0x43, 0x32, 0x12, 0x01, 0xa9, 0xdb, 0xcc, 0xcb, 0xbb, 0xac, 0x9b, 0x99, 0x00, 0x33, 0x36,
+    0x44, 0x43, 0x32, 0x23, 0x12, 0x80, 0xb9, 0xbd, 0xcd, 0xbb, 0xbc, 0xbb, 0xaa, 0x89, 0x21, 0x53,
+    0x35, 0x34, 0x34, 0x43, 0x12, 0x02, 0x90, 0xc9, 0xdb, 0xcb, 0xac, 0xcb, 0xaa, 0x99, 0x88, 0x21,
+    0x53, 0x44, 0x33, 0x34, 0x23, 0x23, 0x01, 0x98, 0xdb, 0xcc, 0xbc, 0xcb, 0xbb, 0xba, 0x8a, 0x08,
+    0x42, 0x44, 0x53, 0x33, 0x34, 0x23, 0x22, 0x00, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xaa, 0x9b, 0x99,
+    0x10, 0x33, 0x46, 0x33, 0x35, 0x32, 0x33, 0x12, 0x90, 0xb9, 0xbe, 0xbd, 0xbc, 0xcb, 0xba, 0x9a,
+    0x89, 0x21, 0x53, 0x44, 0x43, 0x33, 0x24, 0x22, 0x11, 0x88, 0xca, 0xcc, 0xcb, 0xbc, 0xca, 0x9a,
+    0x9a, 0x08, 0x21, 0x34, 0x45, 0x33, 0x34, 0x33, 0x22, 0x01, 0x99, 0xcc, 0xbc, 0xbd, 0xcb, 0xbb,
+    0xba, 0x99, 0x00, 0x42, 0x44, 0x34, 0x34, 0x24, 0x32, 0x11, 0x81, 0xa9, 0xeb, 0xdb, 0xbb, 0xbc,
+    0xbb, 0xaa, 0x8a, 0x20, 0x53, 0x44, 0x34, 0x43, 0x33, 0x32, 0x11, 0x80, 0xba, 0xbe, 0xbd, 0xbc,
+    0xac, 0xab, 0x9a, 0x88, 0x21, 0x44, 0x53, 0x43, 0x23, 0x33, 0x13, 0x11, 0x99, 0xdb, 0xbc, 0xbd,
+    0xbb, 0xac, 0x9b, 0x8a, 0x08, 0x32, 0x54, 0x43, 0x43, 0x32, 0x32, 0x21, 0x80, 0xa9, 0xbc, 0xbd,
+    0xcc, 0xba, 0xaa, 0xaa, 0x88, 0x10, 0x33, 0x36, 0x43, 0x24, 0x22, 0x22, 0x01, 0x98, 0xb9, 0xcc,
+    0xbb, 0xcb, 0xab, 0xa9, 0x88, 0x10, 0x32, 0x43, 0x23, 0x13, 0x00,
+};
+
+// tone:784:120, 2646 samples
+alignas(4) inline constexpr uint8_t Sound01_003[] = {
+    0x70, 0x77, 0x67, 0x12, 0x01, 0xa8, 0xcc, 0xcd, 0xcb, 0xbb, 0xaa, 0x08, 0x53, 0x45, 0x34, 0x34,
+    0x33, 0x12, 0x90, 0xdb, 0xcd, 0xbc, 0xcb, 0xba, 0x99, 0x18, 0x43, 0x45, 0x34, 0x43, 0x32, 0x11,
+    0x88, 0xcb, 0xcd, 0xcb, 0xbb, 0xac, 0x99, 0x00, 0x42, 0x35, 0x44, 0x32, 0x33, 0x02, 0x90, 0xda,
+    0xcc, 0xbc, 0xbb, 0xac, 0x99, 0x18, 0x42, 0x44, 0x34, 0x43, 0x22, 0x11, 0x88, 0xbb, 0xbe, 0xcc,
+    0xba, 0xab, 0x99, 0x18, 0x42, 0x35, 0x34, 0x34, 0x23, 0x11, 0x90, 0xca, 0xcc, 0xbc, 0xcb, 0xaa,
+    0x8a, 0x08, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd, 0xbc, 0xcb, 0xaa, 0x9a, 0x18,
+    0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xdb, 0xab, 0xbb, 0x9a, 0x18, 0x41, 0x44,
+    0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9, 0x08, 0x32, 0x35, 0x45, 0x32,
+    0x33, 0x12, 0x81, 0xba, 0xcd, 0xcc, 0xba, 0xbb, 0xaa, 0x08, 0x41, 0x63, 0x43, 0x33, 0x33, 0x13,
+    0x81, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x34, 0x34, 0x33, 0x22, 0x00, 0xba,
+    0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x09, 0x31, 0x45, 0x34, 0x34, 0x23, 0x23, 0x81, 0xb9, 0xdc, 0xbc,
+    0xbc, 0xbb, 0xaa, 0x89, 0x31, 0x54, 0x34, 0x34, 0x33, 0x22, 0x01, 0xa9, 0xcd, 0xdb, 0xbb, 0xac,
+    0xaa, 0x09, 0x20, 0x44, 0x53, 0x33, 0x24, 0x22, 0x81, 0xa8, 0xdb, 0xcc, 0xbb, 0xac, 0xaa, 0x89,
+    0x11, 0x34, 0x45, 0x33, 0x24, 0x22, 0x01, 0xa8, 0xdb, 0xbc, 0xbd, 0xba, 0xab, 0x89, 0x11, 0x44,
+    0x34, 0x25, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x20, 0x43, 0x45, 0x33,
+    0x24, 0x13, 0x02, 0x98, 0xdb, 0xbc, 0xad, 0xbb, 0xab, 0x8a, 0x10, 0x34, 0x36, 0x34, 0x33, 0x33,
+    0x11, 0x98, 0xcc, 0xcc, 0xcb, 0xbb, 0xab, 0x99, 0x10, 0x53, 0x44, 0x43, 0x33, 0x23, 0x02, 0xa0,
+    0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x10, 0x53, 0x34, 0x35, 0x43, 0x22, 0x11, 0x90, 0xca, 0xcc,
+    0xcb, 0xbb, 0xab, 0x9a, 0x18, 0x53, 0x34, 0x35, 0x43, 0x22, 0x02, 0x90, 0xba, 0xcd, 0xbc, 0xcb,
+    0xaa, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd, 0xbc, 0xcb, 0xaa, 0x9a,
+    0x18, 0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xbc, 0xbb, 0xac, 0x9a, 0x08, 0x32,
+    0x45, 0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9, 0x08, 0x32, 0x54, 0x34,
+    0x43, 0x32, 0x21, 0x80, 0xb9, 0xcd, 0xdb, 0xba, 0xbb, 0xaa, 0x08, 0x41, 0x63, 0x43, 0x33, 0x33,
+    0x13, 0x81, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x34, 0x34, 0x33, 0x22, 0x80,
+    0xb9, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x09, 0x31, 0x45, 0x34, 0x34, 0x23, 0x23, 0x81, 0xb9, 0xdc,
+    0xbc, 0xbc, 0xbb, 0xaa, 0x89, 0x31, 0x54, 0x34, 0x34, 0x33, 0x22, 0x01, 0xa9, 0xcd, 0xdb, 0xbb,
+    0xac, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x33, 0x24, 0x22, 0x81, 0xa8, 0xdb, 0xcc, 0xbb, 0xac, 0xaa,
+    0x89, 0x11, 0x34, 0x45, 0x33, 0x24, 0x22, 0x01, 0xa8, 0xdb, 0xbc, 0xbd, 0xba, 0xab, 0x89, 0x11,
+    0x44, 0x34, 0x25, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x20, 0x53, 0x53,
+    0x24, 0x33, 0x23, 0x11, 0xa8, 0xdb, 0xcc, 0xac, 0xbb, 0xab, 0x8a, 0x10, 0x34, 0x36, 0x34, 0x33,
+    0x33, 0x11, 0x98, 0xcc, 0xcc, 0xcb, 0xbb, 0xab, 0x99, 0x10, 0x53, 0x44, 0x43, 0x33, 0x23, 0x02,
+    0xa0, 0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x10, 0x53, 0x34, 0x35, 0x43, 0x22, 0x11, 0x90, 0xca,
+    0xcc, 0xcb, 0xbb, 0xab, 0x9a, 0x18, 0x53, 0x34, 0x35, 0x43, 0x22, 0x02, 0x90, 0xba, 0xcd, 0xbc,
+    0xcb, 0xaa, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd, 0xbc, 0xcb, 0xaa,
+    0x9a, 0x18, 0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xdb, 0xba, 0xbb, 0x9a, 0x08,
+    0x42, 0x44, 0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9, 0x08, 0x32, 0x54,
+    0x34, 0x43, 0x32, 0x21, 0x80, 0xb9, 0xcd, 0xdb, 0xba, 0xbb, 0xaa, 0x08, 0x41, 0x63, 0x43, 0x33,
+    0x33, 0x13, 0x81, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x34, 0x34, 0x33, 0x12,
+    0x01, 0xba, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x09, 0x31, 0x45, 0x34, 0x34, 0x23, 0x23, 0x81, 0xb9,
+    0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x89, 0x31, 0x54, 0x34, 0x34, 0x33, 0x22, 0x01, 0xa9, 0xcd, 0xdb,
+    0xbb, 0xac, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x33, 0x24, 0x22, 0x81, 0xa8, 0xdb, 0xcc, 0xbb, 0xac,
+    0xaa, 0x89, 0x11, 0x34, 0x45, 0x33, 0x24, 0x22, 0x01, 0xa8, 0xdb, 0xbc, 0xbd, 0xba, 0xab, 0x89,
+    0x11, 0x44, 0x34, 0x25, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x20, 0x53,
+    0x53, 0x24, 0x33, 0x23, 0x11, 0xa8, 0xdb, 0xcc, 0xac, 0xbb, 0xab, 0x8a, 0x10, 0x34, 0x36, 0x34,
+    0x33, 0x33, 0x11, 0x98, 0xcc, 0xcc, 0xcb, 0xbb, 0xab, 0x99, 0x10, 0x53, 0x44, 0x43, 0x33, 0x23,
+    0x02, 0xa0, 0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x10, 0x53, 0x34, 0x35, 0x43, 0x22, 0x11, 0x90,
+    0xca, 0xcc, 0xcb, 0xbb, 0xab, 0x9a, 0x18, 0x53, 0x34, 0x35, 0x43, 0x22, 0x02, 0x90, 0xba, 0xcd,
+    0xbc, 0xcb, 0xaa, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd, 0xbc, 0xcb,
+    0xaa, 0x9a, 0x18, 0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xdb, 0xba, 0xbb, 0x9a,
+    0x08, 0x42, 0x44, 0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9, 0x08, 0x32,
+    0x54, 0x34, 0x43, 0x32, 0x21, 0x80, 0xb9, 0xcd, 0xdb, 0xba, 0xbb, 0xaa, 0x08, 0x41, 0x63, 0x43,
+    0x33, 0x33, 0x13, 0x81, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x34, 0x34, 0x33,
+    0x12, 0x01, 0xba, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x09, 0x31, 0x45, 0x34, 0x34, 0x23, 0x23, 0x81,
+    0xb9, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x89, 0x31, 0x54, 0x34, 0x34, 0x33, 0x22, 0x01, 0xa9, 0xcd,
+    0xdb, 0xbb, 0xac, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x33, 0x24, 0x22, 0x81, 0xa8, 0xdb, 0xcc, 0xbb,
+    0xac, 0xaa, 0x89, 0x11, 0x34, 0x45, 0x33, 0x24, 0x22, 0x01, 0xa8, 0xdb, 0xbc, 0xbd, 0xba, 0xab,
+    0x89, 0x11, 0x44, 0x34, 0x25, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x20,
+    0x43, 0x45, 0x33, 0x24, 0x13, 0x02, 0x98, 0xdb, 0xbc, 0xad, 0xbb, 0xab, 0x8a, 0x10, 0x34, 0x36,
+    0x34, 0x33, 0x33, 0x11, 0x98, 0xcc, 0xcc, 0xcb, 0xbb, 0xab, 0x99, 0x10, 0x53, 0x44, 0x43, 0x33,
+    0x23, 0x02, 0xa0, 0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x10, 0x53, 0x34, 0x35, 0x43, 0x22, 0x11,
+    0x90, 0xca, 0xcc, 0xcb, 0xbb, 0xab, 0x9a, 0x18, 0x53, 0x34, 0x35, 0x43, 0x22, 0x02, 0x90, 0xba,
+    0xcd, 0xbc, 0xcb, 0xaa, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd, 0xbc,
+    0xcb, 0xaa, 0x9a, 0x18, 0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xbc, 0xbb, 0xac,
+    0x9a, 0x08, 0x32, 0x45, 0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9, 0x08,
+    0x32, 0x54, 0x34, 0x43, 0x32, 0x21, 0x80, 0xb9, 0xcd, 0xdb, 0xba, 0xbb, 0xaa, 0x08, 0x41, 0x63,
+    0x43, 0x33, 0x33, 0x13, 0x81, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0x9a, 0x09, 0x31, 0x45, 0x34, 0x34,
+    0x33, 0x22, 0x80, 0xb9, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x09, 0x31, 0x45, 0x34, 0x34, 0x23, 0x23,
+    0x81, 0xb9, 0xdc, 0xbc, 0xbc, 0xbb, 0xaa, 0x89, 0x31, 0x54, 0x34, 0x34, 0x33, 0x22, 0x01, 0xa9,
+    0xcd, 0xdb, 0xbb, 0xac, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x33, 0x24, 0x22, 0x81, 0xa8, 0xdb, 0xcc,
+    0xbb, 0xac, 0xaa, 0x89, 0x11, 0x34, 0x45, 0x33, 0x24, 0x22, 0x01, 0xa8, 0xdb, 0xbc, 0xbd, 0xba,
+    0xab, 0x89, 0x11, 0x44, 0x34, 0x25, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xdb, 0xbb, 0xac, 0x9b, 0x8a,
+    0x20, 0x53, 0x53, 0x24, 0x33, 0x23, 0x11, 0xa8, 0xdb, 0xcc, 0xac, 0xbb, 0xab, 0x8a, 0x10, 0x34,
+    0x36, 0x34, 0x33, 0x33, 0x11, 0x98, 0xcc, 0xcc, 0xcb, 0xbb, 0xab, 0x99, 0x10, 0x53, 0x44, 0x43,
+    0x33, 0x23, 0x02, 0xa0, 0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x10, 0x53, 0x44, 0x43, 0x33, 0x32,
+    0x12, 0x98, 0xcb, 0xcd, 0xcb, 0xbb, 0xab, 0x9a, 0x18, 0x43, 0x45, 0x43, 0x33, 0x23, 0x12, 0x90,
+    0xda, 0xbc, 0xbd, 0xcb, 0xaa, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x43, 0x22, 0x12, 0x88, 0xba, 0xcd,
+    0xbc, 0xcb, 0xaa, 0x9a, 0x18, 0x41, 0x53, 0x34, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xdb, 0xab,
+    0xbb, 0x9a, 0x18, 0x41, 0x44, 0x53, 0x32, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0xa9,
+    0x08, 0x32, 0x54, 0x34, 0x43, 0x32, 0x21, 0x80, 0xb9, 0xcd, 0xdb, 0xba, 0xbb, 0xaa, 0x08, 0x41,
+    0x63, 0x43, 0x33, 0x33, 0x13, 0x80, 0xba, 0xbe, 0xbd, 0xcb, 0xba, 0x99, 0x09, 0x22, 0x35, 0x44,
+    0x23, 0x33, 0x22, 0x80, 0xba, 0xdc, 0xcb, 0xac, 0xaa, 0x9a, 0x88, 0x22, 0x34, 0x35, 0x24, 0x23,
+    0x12, 0x80, 0xb9, 0xeb, 0xbb, 0xbc, 0xab, 0xaa, 0x08, 0x22, 0x35, 0x34, 0x24, 0x23, 0x11, 0x90,
+    0xa9, 0xbc, 0xbc, 0xab, 0x9b, 0x89, 0x10, 0x23, 0x24, 0x13, 0x81,
+};
+
+// tone:1047:120, 2646 samples
+alignas(4) inline constexpr uint8_t Sound01_004[] = {
+    0x70, 0x77, 0x77, 0x01, 0xa9, 0xcc, 0xad, 0xab, 0x0a, 0x52, 0x54, 0x43, 0x23, 0x82, 0xb9, 0xce,
+    0xbc, 0xbb, 0x8a, 0x20, 0x55, 0x53, 0x32, 0x12, 0x90, 0xeb, 0xdb, 0xab, 0xab, 0x08, 0x52, 0x44,
+    0x33, 0x33, 0x01, 0xba, 0xbf, 0xbc, 0xac, 0x99, 0x20, 0x44, 0x53, 0x23, 0x12, 0x90, 0xdb, 0xcc,
+    0xba, 0x9b, 0x09, 0x42, 0x35, 0x34, 0x23, 0x82, 0xb9, 0xdd, 0xbb, 0xbb, 0x9a, 0x21, 0x45, 0x53,
+    0x32, 0x11, 0x90, 0xda, 0xcb, 0xac, 0x9a, 0x09, 0x32, 0x35, 0x25, 0x23, 0x81, 0xb8, 0xcc, 0xbc,
+    0xbb, 0x99, 0x20, 0x44, 0x34, 0x24, 0x22, 0x88, 0xcb, 0xcc, 0xbb, 0xaa, 0x09, 0x32, 0x46, 0x33,
+    0x23, 0x02, 0xb9, 0xcd, 0xbc, 0xab, 0x9a, 0x10, 0x44, 0x34, 0x34, 0x12, 0x90, 0xca, 0xcc, 0xbb,
+    0xab, 0x88, 0x32, 0x36, 0x25, 0x23, 0x01, 0xa8, 0xcc, 0xbc, 0xbb, 0x9a, 0x20, 0x53, 0x35, 0x33,
+    0x23, 0x80, 0xdb, 0xcc, 0xbb, 0xab, 0x09, 0x31, 0x36, 0x25, 0x23, 0x02, 0xa8, 0xcc, 0xbc, 0xbb,
+    0x9a, 0x28, 0x53, 0x44, 0x33, 0x22, 0x91, 0xca, 0xcc, 0xcb, 0xaa, 0x89, 0x21, 0x35, 0x44, 0x22,
+    0x02, 0xa8, 0xdb, 0xdb, 0xba, 0x8a, 0x08, 0x43, 0x44, 0x33, 0x13, 0x81, 0xca, 0xcc, 0xcb, 0xaa,
+    0x0a, 0x30, 0x44, 0x34, 0x23, 0x12, 0xa8, 0xeb, 0xbc, 0xbb, 0xaa, 0x18, 0x43, 0x45, 0x33, 0x23,
+    0x81, 0xca, 0xcc, 0xcb, 0xaa, 0x8a, 0x21, 0x44, 0x34, 0x33, 0x02, 0xa0, 0xeb, 0xdb, 0xba, 0x9a,
+    0x19, 0x42, 0x44, 0x33, 0x23, 0x81, 0xc9, 0xcc, 0xcb, 0xab, 0x89, 0x20, 0x44, 0x34, 0x33, 0x12,
+    0x98, 0xeb, 0xcb, 0xac, 0x9a, 0x08, 0x41, 0x53, 0x33, 0x23, 0x01, 0xb9, 0xbe, 0xad, 0xab, 0x8a,
+    0x20, 0x63, 0x43, 0x23, 0x22, 0x98, 0xda, 0xbc, 0xbc, 0x9a, 0x09, 0x32, 0x45, 0x24, 0x23, 0x81,
+    0xb8, 0xcc, 0xbc, 0xab, 0x9a, 0x20, 0x63, 0x34, 0x33, 0x13, 0x90, 0xdb, 0xcc, 0xbb, 0x9b, 0x09,
+    0x41, 0x44, 0x24, 0x23, 0x01, 0xa9, 0xcc, 0xbc, 0xbb, 0x8a, 0x28, 0x44, 0x34, 0x24, 0x22, 0x90,
+    0xca, 0xcc, 0xbb, 0xba, 0x88, 0x32, 0x36, 0x25, 0x23, 0x01, 0xa8, 0xcc, 0xdb, 0xba, 0x99, 0x10,
+    0x52, 0x53, 0x32, 0x12, 0x91, 0xc9, 0xcc, 0xbb, 0xab, 0x89, 0x41, 0x44, 0x43, 0x32, 0x01, 0xa8,
+    0xeb, 0xcb, 0xab, 0x9a, 0x18, 0x53, 0x34, 0x24, 0x13, 0x91, 0xc9, 0xbc, 0xad, 0xab, 0x88, 0x30,
+    0x44, 0x34, 0x33, 0x11, 0xa8, 0xcc, 0xbc, 0xbc, 0x99, 0x08, 0x43, 0x44, 0x33, 0x13, 0x81, 0xba,
+    0xce, 0xbb, 0xbb, 0x89, 0x31, 0x45, 0x34, 0x23, 0x12, 0x98, 0xcc, 0xbc, 0xbc, 0x9a, 0x18, 0x42,
+    0x44, 0x33, 0x23, 0x81, 0xba, 0xce, 0xbb, 0xbb, 0x89, 0x30, 0x45, 0x34, 0x23, 0x03, 0xa0, 0xeb,
+    0xdb, 0xba, 0x9a, 0x08, 0x42, 0x34, 0x25, 0x13, 0x81, 0xa9, 0xbd, 0xcc, 0xaa, 0x89, 0x10, 0x34,
+    0x35, 0x33, 0x12, 0x90, 0xeb, 0xdb, 0xba, 0xaa, 0x08, 0x42, 0x34, 0x25, 0x13, 0x01, 0xa9, 0xbd,
+    0xcc, 0xaa, 0x99, 0x20, 0x53, 0x53, 0x32, 0x12, 0x98, 0xca, 0xcc, 0xbb, 0x9b, 0x09, 0x42, 0x44,
+    0x43, 0x22, 0x82, 0xb8, 0xcc, 0xbc, 0xab, 0x9a, 0x20, 0x63, 0x34, 0x33, 0x13, 0x90, 0xdb, 0xcc,
+    0xbb, 0xaa, 0x09, 0x41, 0x44, 0x43, 0x13, 0x02, 0xa9, 0xcc, 0xbc, 0xbb, 0x8a, 0x28, 0x63, 0x34,
+    0x33, 0x13, 0x80, 0xdb, 0xbc, 0xad, 0x9b, 0x09, 0x31, 0x44, 0x34, 0x23, 0x02, 0xb8, 0xcc, 0xcc,
+    0xba, 0x99, 0x28, 0x52, 0x43, 0x24, 0x12, 0x80, 0xc9, 0xdb, 0xbb, 0xab, 0x89, 0x31, 0x36, 0x25,
+    0x23, 0x02, 0xa8, 0xcc, 0xdb, 0xba, 0x99, 0x18, 0x52, 0x43, 0x24, 0x12, 0x81, 0xba, 0xbd, 0xad,
+    0xab, 0x88, 0x30, 0x44, 0x34, 0x33, 0x11, 0xa8, 0xcc, 0xbc, 0xac, 0xaa, 0x00, 0x43, 0x44, 0x33,
+    0x22, 0x81, 0xba, 0xce, 0xbb, 0xab, 0x8a, 0x31, 0x45, 0x34, 0x23, 0x12, 0x98, 0xcc, 0xbc, 0xbc,
+    0x9a, 0x18, 0x42, 0x44, 0x33, 0x23, 0x00, 0xba, 0xbe, 0xad, 0xab, 0x89, 0x20, 0x44, 0x34, 0x33,
+    0x12, 0xa8, 0xdb, 0xbd, 0xbb, 0xab, 0x08, 0x53, 0x44, 0x33, 0x23, 0x81, 0xb9, 0xbe, 0xad, 0xab,
+    0x8a, 0x20, 0x44, 0x34, 0x33, 0x12, 0xa0, 0xdb, 0xcc, 0xbb, 0xaa, 0x19, 0x42, 0x44, 0x43, 0x22,
+    0x01, 0xa9, 0xbd, 0xcc, 0xaa, 0x8a, 0x20, 0x53, 0x53, 0x32, 0x12, 0x88, 0xcb, 0xcc, 0xbb, 0x9b,
+    0x09, 0x42, 0x44, 0x43, 0x22, 0x01, 0xb8, 0xcc, 0xbc, 0xab, 0x9a, 0x20, 0x63, 0x34, 0x33, 0x22,
+    0x90, 0xcb, 0xcd, 0xbb, 0xab, 0x09, 0x42, 0x44, 0x43, 0x22, 0x02, 0xa9, 0xcc, 0xbc, 0xbb, 0x8a,
+    0x28, 0x63, 0x53, 0x32, 0x12, 0x91, 0xca, 0xcc, 0xbb, 0xab, 0x09, 0x41, 0x44, 0x43, 0x23, 0x01,
+    0xa8, 0xcc, 0xbc, 0xbb, 0x9a, 0x10, 0x63, 0x43, 0x24, 0x12, 0x91, 0xc9, 0xdb, 0xbb, 0xab, 0x89,
+    0x31, 0x36, 0x44, 0x22, 0x11, 0xa8, 0xdb, 0xbc, 0xbb, 0x9a, 0x18, 0x53, 0x44, 0x33, 0x13, 0x81,
+    0xca, 0xcc, 0xac, 0xab, 0x88, 0x30, 0x44, 0x34, 0x23, 0x12, 0xa8, 0xeb, 0xbc, 0xbb, 0x9b, 0x18,
+    0x53, 0x44, 0x33, 0x13, 0x81, 0xc9, 0xcc, 0xac, 0xab, 0x89, 0x21, 0x44, 0x34, 0x33, 0x02, 0xa0,
+    0xcc, 0xbc, 0xac, 0xaa, 0x18, 0x42, 0x44, 0x33, 0x32, 0x00, 0xba, 0xbe, 0xad, 0xab, 0x89, 0x20,
+    0x44, 0x53, 0x32, 0x11, 0x98, 0xda, 0xdb, 0xba, 0x9a, 0x19, 0x32, 0x36, 0x34, 0x22, 0x01, 0xb9,
+    0xcd, 0xcb, 0xab, 0x99, 0x11, 0x44, 0x34, 0x33, 0x12, 0x90, 0xeb, 0xdb, 0xba, 0xaa, 0x08, 0x32,
+    0x36, 0x34, 0x22, 0x82, 0xa9, 0xcd, 0xcb, 0xab, 0x8a, 0x20, 0x63, 0x43, 0x23, 0x13, 0x88, 0xdb,
+    0xbc, 0xac, 0x9b, 0x09, 0x41, 0x34, 0x25, 0x23, 0x01, 0xa9, 0xdc, 0xbb, 0xbb, 0x8b, 0x28, 0x54,
+    0x34, 0x33, 0x13, 0x90, 0xda, 0xcc, 0xbb, 0xab, 0x09, 0x32, 0x36, 0x25, 0x23, 0x01, 0xa8, 0xcc,
+    0xbc, 0xbb, 0x9a, 0x10, 0x44, 0x34, 0x34, 0x12, 0x80, 0xca, 0xcc, 0xbb, 0xab, 0x09, 0x31, 0x36,
+    0x25, 0x23, 0x02, 0x99, 0xcc, 0xbc, 0xbb, 0x9a, 0x18, 0x44, 0x34, 0x24, 0x13, 0x80, 0xc9, 0xcc,
+    0xbb, 0xab, 0x89, 0x31, 0x36, 0x44, 0x22, 0x11, 0xa8, 0xdb, 0xdb, 0xba, 0x9a, 0x00, 0x43, 0x44,
+    0x33, 0x13, 0x81, 0xca, 0xcc, 0xcb, 0xaa, 0x0a, 0x30, 0x44, 0x34, 0x23, 0x12, 0xa8, 0xeb, 0xbc,
+    0xbb, 0xaa, 0x18, 0x53, 0x44, 0x33, 0x22, 0x81, 0xc9, 0xcc, 0xcb, 0xab, 0x89, 0x21, 0x44, 0x34,
+    0x33, 0x12, 0xa8, 0xeb, 0xbc, 0xbb, 0x9b, 0x08, 0x53, 0x34, 0x25, 0x13, 0x81, 0xb9, 0xcc, 0xbc,
+    0xab, 0x8a, 0x30, 0x44, 0x44, 0x32, 0x11, 0x98, 0xda, 0xcb, 0xac, 0x9a, 0x08, 0x41, 0x53, 0x33,
+    0x23, 0x01, 0xb9, 0xbe, 0xad, 0xab, 0x8a, 0x20, 0x44, 0x53, 0x32, 0x11, 0x90, 0xda, 0xcb, 0xac,
+    0x9a, 0x09, 0x32, 0x35, 0x25, 0x23, 0x81, 0xb8, 0xcc, 0xbc, 0xbb, 0x99, 0x20, 0x44, 0x34, 0x24,
+    0x12, 0x80, 0xcb, 0xcc, 0xbb, 0xaa, 0x09, 0x32, 0x46, 0x33, 0x33, 0x01, 0xb9, 0xcd, 0xbc, 0xab,
+    0x9a, 0x10, 0x44, 0x34, 0x34, 0x21, 0x90, 0xca, 0xcc, 0xbb, 0xab, 0x88, 0x32, 0x46, 0x33, 0x33,
+    0x01, 0xb8, 0xdc, 0xbc, 0xbb, 0x9a, 0x10, 0x44, 0x34, 0x24, 0x22, 0x80, 0xca, 0xcc, 0xbb, 0xab,
+    0x09, 0x31, 0x36, 0x44, 0x22, 0x01, 0x98, 0xbc, 0xbd, 0xbb, 0x9a, 0x18, 0x63, 0x53, 0x32, 0x22,
+    0x80, 0xba, 0xbe, 0xbc, 0xba, 0x09, 0x21, 0x45, 0x43, 0x23, 0x02, 0xa8, 0xeb, 0xcb, 0xab, 0x9b,
+    0x00, 0x53, 0x34, 0x34, 0x12, 0x81, 0xba, 0xcd, 0xac, 0xab, 0x09, 0x30, 0x44, 0x34, 0x23, 0x12,
+    0xa8, 0xeb, 0xbc, 0xbb, 0x9b, 0x18, 0x53, 0x44, 0x33, 0x22, 0x81, 0xc9, 0xcc, 0xcb, 0x9b, 0x8a,
+    0x21, 0x44, 0x34, 0x33, 0x02, 0xa0, 0xeb, 0xdb, 0xba, 0x9a, 0x19, 0x42, 0x44, 0x33, 0x23, 0x81,
+    0xc9, 0xcc, 0xcb, 0xab, 0x89, 0x20, 0x44, 0x34, 0x33, 0x12, 0x98, 0xeb, 0xdb, 0xba, 0xaa, 0x08,
+    0x42, 0x44, 0x33, 0x23, 0x01, 0xc9, 0xbc, 0xbd, 0xbb, 0x99, 0x30, 0x44, 0x34, 0x24, 0x12, 0x90,
+    0xda, 0xcb, 0xac, 0xaa, 0x08, 0x32, 0x35, 0x25, 0x23, 0x00, 0xb8, 0xcc, 0xbc, 0xbb, 0x99, 0x20,
+    0x44, 0x34, 0x24, 0x22, 0x88, 0xcb, 0xcc, 0xbb, 0xaa, 0x09, 0x41, 0x44, 0x24, 0x23, 0x01, 0xa9,
+    0xcc, 0xbc, 0xbb, 0x8a, 0x28, 0x44, 0x34, 0x24, 0x13, 0x90, 0xca, 0xcc, 0xbb, 0xab, 0x88, 0x32,
+    0x36, 0x25, 0x23, 0x11, 0xa9, 0xcc, 0xbc, 0xbb, 0x9a, 0x10, 0x44, 0x34, 0x34, 0x12, 0x80, 0xca,
+    0xcc, 0xbb, 0xab, 0x09, 0x31, 0x36, 0x44, 0x22, 0x11, 0x99, 0xbc, 0xbd, 0xbb, 0x9a, 0x18, 0x63,
+    0x43, 0x24, 0x12, 0x81, 0xba, 0xcd, 0xbb, 0xab, 0x89, 0x31, 0x45, 0x34, 0x33, 0x11, 0xa8, 0xcc,
+    0xcc, 0xba, 0xa9, 0x00, 0x43, 0x44, 0x33, 0x13, 0x81, 0xca, 0xcc, 0xcb, 0xaa, 0x89, 0x20, 0x35,
+    0x44, 0x22, 0x02, 0x98, 0xcb, 0xbd, 0xbb, 0x9b, 0x08, 0x53, 0x44, 0x33, 0x23, 0x00, 0xba, 0xce,
+    0xbb, 0xbb, 0x89, 0x30, 0x45, 0x34, 0x23, 0x03, 0xa0, 0xeb, 0xdb, 0xba, 0x9a, 0x08, 0x42, 0x34,
+    0x25, 0x13, 0x81, 0xa9, 0xbd, 0xcc, 0x9a, 0x89, 0x10, 0x34, 0x34, 0x33, 0x03, 0xa0, 0xdb, 0xbd,
+    0xab, 0x9b, 0x19, 0x42, 0x44, 0x33, 0x23, 0x81, 0xb9, 0xcd, 0xcb, 0xaa, 0x89, 0x20, 0x53, 0x43,
+    0x32, 0x11, 0x98, 0xca, 0xbc, 0xac, 0x9a, 0x18, 0x31, 0x44, 0x33, 0x22, 0x00, 0xaa, 0xbd, 0xbb,
+    0xbb, 0x89, 0x31, 0x53, 0x43, 0x21, 0x00, 0x99, 0xaa, 0x9a, 0x08,
+};
+
+inline constexpr SoundBankEntry SoundBank[] = {
+    {1, 1, {SoundClip::Format::ImaAdpcm, 2646, Sound01_001, 0, 0}},
+    {1, 2, {SoundClip::Format::ImaAdpcm, 2646, Sound01_002, 0, 0}},
+    {1, 3, {SoundClip::Format::ImaAdpcm, 2646, Sound01_003, 0, 0}},
+    {1, 4, {SoundClip::Format::ImaAdpcm, 2646, Sound01_004, 0, 0}},
+};
@@ -0,0 +1,121 @@
+#include "SoundMixer.h"
+
+namespace {
+
+constexpr int16_t AdpcmSteps[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767,
+};
+
+constexpr int8_t AdpcmIndexSteps[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+int32_t clamp16(int32_t value)
+{
+    return value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value;
+}
+
+} // namespace
+
+uint8_t SoundMixer::play(const SoundClip& clip, uint8_t id, uint16_t gain, uint32_t startUs)
+{
+    uint8_t target = 0;
+    for (uint8_t voice = 0; voice < Voices; ++voice) {
+        if (!m_voices[voice].clip) {
+            target = voice;
+            break;
+        }
+        if (m_voices[voice].order < m_voices[target].order) {
+            target = voice;
+        }
+    }
+
+    Voice& voice = m_voices[target];
+    voice.position = 0;
+    voice.predictor = clip.adpcmPredictor;
+    voice.stepIndex = clip.adpcmIndex;
+    voice.gain = gain;
+    voice.id = id;
+    voice.order = ++m_order;
+    voice.startUs = startUs;
+    voice.clip = &clip; // Last; the voice becomes audible here
+    return target;
+}
+
+void SoundMixer::stopAll()
+{
+    for (Voice& voice : m_voices) {
+        voice.clip = nullptr;
+    }
+}
+
+bool SoundMixer::active() const
+{
+    for (const Voice& voice : m_voices) {
+        if (voice.clip) return true;
+    }
+    return false;
+}
+
+int16_t SoundMixer::nextSample(Voice& voice)
+{
+    const SoundClip& clip = *voice.clip;
+    const uint32_t position = voice.position++;
+    if (clip.format == SoundClip::Format::Pcm16) {
+        return static_cast<const int16_t*>(clip.data)[position];
+    }
+
+    const uint8_t byte = static_cast<const uint8_t*>(clip.data)[position / 2];
+    const uint8_t code = position & 1u ? byte >> 4 : byte & 0x0f;
+
+    // diff = (code + 0.5) * step / 4, in the usual shift-and-add form.
+    const int32_t step = AdpcmSteps[voice.stepIndex];
+    int32_t diff = step >> 3;
+    if (code & 4) diff += step;
+    if (code & 2) diff += step >> 1;
+    if (code & 1) diff += step >> 2;
+    voice.predictor = clamp16(code & 8 ? voice.predictor - diff : voice.predictor + diff);
+
+    const int32_t index = voice.stepIndex + AdpcmIndexSteps[code & 7];
+    voice.stepIndex = index < 0 ? 0 : index > 88 ? 88 : static_cast<uint8_t>(index);
+    return static_cast<int16_t>(voice.predictor);
+}
+
+uint32_t SoundMixer::render(int16_t* out, uint32_t count)
+{
+    int32_t mix[32];
+    uint32_t ended = 0;
+    m_started = 0;
+
+    // Blocks of 32 keep the accumulator on the stack small.
+    for (uint32_t offset = 0; offset < count; offset += 32) {
+        const uint32_t block = count - offset < 32 ? count - offset : 32;
+        for (uint32_t index = 0; index < block; ++index) {
+            mix[index] = 0;
+        }
+
+        for (uint8_t index = 0; index < Voices; ++index) {
+            Voice& voice = m_voices[index];
+            if (!voice.clip) continue;
+            if (voice.position == 0) m_started |= 1u << index;
+
+            const uint32_t left = voice.clip->sampleCount - voice.position;
+            const uint32_t samples = left < block ? left : block;
+            for (uint32_t sample = 0; sample < samples; ++sample) {
+                mix[sample] += nextSample(voice) * voice.gain;
+            }
+            if (voice.position >= voice.clip->sampleCount) {
+                voice.clip = nullptr;
+                ended |= 1u << index;
+            }
+        }
+
+        // Q8 gain times Q8 volume.
+        for (uint32_t index = 0; index < block; ++index) {
+            out[offset + index] = static_cast<int16_t>(clamp16((mix[index] >> 8) * m_volume >> 8));
+        }
+    }
+    return ended;
+}
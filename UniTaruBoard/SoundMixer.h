@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+// One sound in flash, 16-bit PCM or 4-bit IMA ADPCM at SoundMixer::SampleRate.
+struct SoundClip
+{
+    enum class Format : uint8_t
+    {
+        Pcm16,
+        ImaAdpcm, // Low nibble first, one block from the initial state below
+    };
+
+    Format format;
+    uint32_t sampleCount;
+    const void* data;
+    int16_t adpcmPredictor;
+    uint8_t adpcmIndex;
+};
+
+// Mixes a few voices of SoundClip into 16-bit mono, in fixed point only.
+//
+// Each voice has a Q8 gain and the sum goes through a Q8 master volume
+// before it is clipped to 16 bits. A clip started while every voice is busy
+// replaces the oldest one. There is no hardware dependency, so the same
+// mixer renders on the RP2040 and on a host.
+class SoundMixer
+{
+public:
+    static constexpr uint8_t Voices = 4;
+    static constexpr uint32_t SampleRate = 22050;
+    static constexpr uint16_t UnityGain = 256;
+
+    // Returns the voice the clip plays on. id is reported back when it ends.
+    uint8_t play(const SoundClip& clip, uint8_t id, uint16_t gain = UnityGain, uint32_t startUs = 0);
+    void stop(uint8_t voice) { m_voices[voice].clip = nullptr; }
+    void stopAll();
+
+    // Q8, UnityGain for full scale.
+    void setVolume(uint16_t volume) { m_volume = volume; }
+    uint16_t volume() const { return m_volume; }
+
+    // Mixes count samples into out. Returns a bit per voice that ended.
+    uint32_t render(int16_t* out, uint32_t count);
+
+    bool active() const;
+    uint8_t voiceId(uint8_t voice) const { return m_voices[voice].id; }
+
+    // Voices that got their first samples in the last render(), with the
+    // startUs they were played with, for latency measurements.
+    uint32_t startedVoices() const { return m_started; }
+    uint32_t voiceStartUs(uint8_t voice) const { return m_voices[voice].startUs; }
+
+private:
+    struct Voice
+    {
+        const SoundClip* clip = nullptr;
+        uint32_t position = 0;
+        int32_t predictor = 0;
+        uint8_t stepIndex = 0;
+        uint16_t gain = UnityGain;
+        uint8_t id = 0;
+        uint32_t order = 0; // Start order, for replacing the oldest voice
+        uint32_t startUs = 0;
+    };
+
+    static int16_t nextSample(Voice& voice);
+
+    Voice m_voices[Voices];
+    uint16_t m_volume = UnityGain;
+    uint32_t m_order = 0;
+    uint32_t m_started = 0;
+};
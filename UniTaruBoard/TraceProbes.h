@@ -0,0 +1,14 @@
+#pragma once
+
+#include "trace.h"
+
+// Timing probes of this firmware. Statistics are printed over USB stdio.
+enum TraceProbe : uint8_t
+{
+    TraceMatrixScan,   // One timer callback of the key matrix
+    TracePlayerPoll,   // DfPlayerPicoSd::poll()
+    TraceQueryLatency, // DFPlayer query sent until answered, in us
+    TraceKeyToPlay,    // Play request until its command is queued, or until
+                       // its first buffer plays with PWM, in us
+    TraceWakeToKey,    // Leaving dormant until the first key event, in us
+};
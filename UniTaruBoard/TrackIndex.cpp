@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "TrackIndex.h"
+#include "ConfigKeys.h"
+
+// Track counts are packed four folders per config value.
+static constexpr uint8_t FoldersPerKey = 4;
+
+void TrackIndex::load()
+{
+    uint32_t signature;
+    if (!config_store_get(ConfigCardSignature, &signature)) {
+        return;
+    }
+    for (uint8_t key = 0; key < MaxFolders / FoldersPerKey; ++key) {
+        const uint32_t packed = config_store_get_or(ConfigFolderTracksBase + key, 0);
+        for (uint8_t index = 0; index < FoldersPerKey; ++index) {
+            m_tracks[key * FoldersPerKey + index] = (packed >> (index * 8)) & 0xff;
+        }
+    }
+    m_signature = signature;
+    m_folderCount = signature & 0xff;
+    if (m_folderCount > MaxFolders) {
+        m_folderCount = MaxFolders;
+    }
+    m_known = true;
+}
+
+void TrackIndex::save()
+{
+    for (uint8_t key = 0; key < MaxFolders / FoldersPerKey; ++key) {
+        uint32_t packed = 0;
+        for (uint8_t index = 0; index < FoldersPerKey; ++index) {
+            packed |= static_cast<uint32_t>(m_tracks[key * FoldersPerKey + index]) << (index * 8);
+        }
+        config_store_set(ConfigFolderTracksBase + key, packed);
+    }
+    config_store_set(ConfigCardSignature, m_signature);
+}
+
+bool TrackIndex::contains(uint8_t folder, uint8_t track) const
+{
+    if (!m_cardPresent) {
+        return false;
+    }
+    if (!m_known) {
+        return true; // Nothing to check against yet
+    }
+    if (folder == 0 || folder > m_folderCount || folder > MaxFolders) {
+        return false;
+    }
+    return track >= 1 && track <= m_tracks[folder - 1];
+}
+
+void TrackIndex::verify(DfPlayerPicoSd& player)
+{
+    if (m_busy) {
+        return;
+    }
+    m_player = &player;
+    m_busy = player.requestSoundCount(&TrackIndex::onSoundCount, this);
+}
+
+void TrackIndex::onResponse(const DfResponse& response, DfPlayerPicoSd& player)
+{
+    if (response.cmd == NotifyCardRemoved) {
+        m_cardPresent = false; // Nothing plays until a card is back
+    } else if (response.cmd == NotifyCardInserted) {
+        m_cardPresent = true;
+        verify(player);
+    }
+}
+
+void TrackIndex::fail(const char* step)
+{
+    printf("Track index: %s query failed\n", step);
+    m_busy = false;
+}
+
+// The signature is the card's file count in the upper half and its folder
+// count in the lower half.
+void TrackIndex::onSoundCount(const DfResponse& response, void* context)
+{
+    auto* index = static_cast<TrackIndex*>(context);
+    if (response.cmd == DfPlayerPicoSd::ResponseError) {
+        index->fail("file count");
+        return;
+    }
+    index->m_newSignature = static_cast<uint32_t>(response.param) << 16;
+    if (!index->m_player->query(QueryFolderCount, 0, &TrackIndex::onFolderCount, index)) {
+        index->fail("folder count");
+    }
+}
+
+void TrackIndex::onFolderCount(const DfResponse& response, void* context)
+{
+    auto* index = static_cast<TrackIndex*>(context);
+    if (response.cmd == DfPlayerPicoSd::ResponseError) {
+        index->fail("folder count");
+        return;
+    }
+    index->m_newSignature |= response.param & 0xff;
+    if (index->m_known && index->m_newSignature == index->m_signature) {
+        index->m_busy = false;
+        return; // Same card as last time
+    }
+
+    printf("Track index: card changed, enumerating %u folders\n", static_cast<uint>(response.param));
+    index->m_known = false;
+    index->m_folderCount = response.param > MaxFolders ? MaxFolders : response.param;
+    index->m_nextFolder = 1;
+    index->queryNextFolder();
+}
+
+void TrackIndex::queryNextFolder()
+{
+    if (m_nextFolder > m_folderCount) {
+        m_signature = m_newSignature;
+        m_known = true;
+        m_busy = false;
+        save();
+        return;
+    }
+    if (!m_player->query(QueryFolderTracks, m_nextFolder, &TrackIndex::onFolderTracks, this)) {
+        fail("folder tracks");
+    }
+}
+
+void TrackIndex::onFolderTracks(const DfResponse& response, void* context)
+{
+    auto* index = static_cast<TrackIndex*>(context);
+    uint16_t tracks = response.param;
+    if (response.cmd == DfPlayerPicoSd::ResponseError) {
+        // Only a folder that is not on the card has no tracks. The player
+        // hands a query only errors that answer it, and times it out when a
+        // play command's error could have been meant, so a timeout or any
+        // other error leaves the index unknown and nothing is saved.
+        if (response.frame.empty() || (response.param & 0xff) != DfPlayerPicoSd::ErrorNotFound) {
+            index->fail("folder tracks");
+            return;
+        }
+        tracks = 0;
+    }
+    index->m_tracks[index->m_nextFolder - 1] = tracks > 0xff ? 0xff : tracks;
+    ++index->m_nextFolder;
+    index->queryNextFolder();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include "DfPlayerPicoSd.h"
+
+// Folder/track counts of the DFPlayer's SD card, kept in the config store.
+//
+// The counts saved by an earlier run are usable right after load(), so
+// playback requests are checked without talking to the module. verify()
+// then compares the card's signature (file and folder counts) in the
+// background and only enumerates the folders again when the card changed
+// or was swapped while running.
+class TrackIndex
+{
+public:
+    static constexpr uint8_t MaxFolders = 16;
+
+    static constexpr uint8_t QueryFolderCount = 0x4F;
+    static constexpr uint8_t QueryFolderTracks = 0x4E;
+    static constexpr uint8_t NotifyCardInserted = 0x3A;
+    static constexpr uint8_t NotifyCardRemoved = 0x3B;
+
+    void load();
+    void verify(DfPlayerPicoSd& player);
+
+    // Feed every response so card changes are noticed.
+    void onResponse(const DfResponse& response, DfPlayerPicoSd& player);
+
+    bool known() const { return m_known; }
+
+    // true if the track exists, or if nothing is known about the card yet.
+    bool contains(uint8_t folder, uint8_t track) const;
+
+private:
+    static void onSoundCount(const DfResponse& response, void* context);
+    static void onFolderCount(const DfResponse& response, void* context);
+    static void onFolderTracks(const DfResponse& response, void* context);
+
+    void queryNextFolder();
+    void fail(const char* step);
+    void save();
+
+    DfPlayerPicoSd* m_player = nullptr;
+    bool m_known = false;
+    bool m_busy = false;
+    bool m_cardPresent = true;
+    uint32_t m_signature = 0;
+    uint32_t m_newSignature = 0;
+    uint8_t m_folderCount = 0;
+    uint8_t m_nextFolder = 0;
+    uint8_t m_tracks[MaxFolders] = {};
+};
@@ -1,15 +1,57 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "pico/stdlib.h"
-#include "lib/pico-dfPlayerMini/dfPlayer/dfPlayer.h"
-#include <vector>
+#include "hardware/sync.h"
+#include "KeyMatrix.h"
+#include "TraceProbes.h"
+#include "ConfigKeys.h"
+#include "idle.h"
+#include "sched.h"
+#include "tusb.h"
+#include <array>
+
+#if UNITARU_MULTICORE
+#include "pico/multicore.h"
+#endif
+
+#if UNITARU_DF_BENCHMARK
+#include "DfLinkBenchmark.h"
+#endif
+
+#if UNITARU_PCM_BACKEND
+#include "PwmSoundPlayer.h"
+// Sounds built into flash, mixed and played through PWM within a few ms.
+using SoundBackend = PwmSoundPlayer;
+#else
+#include "DfPlayerPicoSd.h"
+#include "TrackIndex.h"
+#include "PlaybackScheduler.h"
+using SoundBackend = DfPlayerPicoSd;
+#endif
 
 const uint LED_PIN = PICO_DEFAULT_LED_PIN;
-const uint ButtonRow0 = 2;
-const uint ButtonRow1 = 3;
-const uint ButtonCol0 = 4;
-const uint ButtonCol1 = 5;
+using ButtonMatrix = KeyMatrix<PinList<2, 3>, PinList<4, 5>>;
+
+// Sound number played by each key, indexed by row * Cols + col.
+constexpr std::array<uint8_t, ButtonMatrix::KeyCount> KeySounds = {
+    1, 2,
+    3, 4,
+};
+constexpr uint8_t DefaultVolume = 25;
+constexpr uint8_t DefaultFolder = 1;
 
-void displayMessage(const std::vector<uint8_t>& data)
+// The clock is reduced after this long without key presses, console input
+// or USB changes, and the chip goes dormant after the second limit.
+#if UNITARU_MULTICORE || UNITARU_PIO_SCANNER
+// Scanning on core 1 or in PIO cannot be suspended; only slow the clock.
+constexpr idle_config_t IdleConfig = {10000, 0};
+#else
+constexpr idle_config_t IdleConfig = {10000, 60000};
+#endif
+
+#if !UNITARU_PCM_BACKEND
+void displayMessage(const DfFrame& data)
 {
     if (data.empty()) {
         printf("No data received.\n");
@@ -23,154 +65,349 @@ void displayMessage(const std::vector<uint8_t>& data)
     printf("\n");
 }
 
-class DfPlayerPicoSd : public DfPlayer<DfPlayerPicoSd>
+static TrackIndex s_trackIndex;
+static PlaybackScheduler s_playback;
+
+void displayResponse(const DfResponse& response, void* context)
+{
+    displayMessage(response.frame);
+    s_trackIndex.onResponse(response, *static_cast<DfPlayerPicoSd*>(context));
+    s_playback.onResponse(response);
+}
+#endif
+
+static bool soundPlaying(const SoundBackend& player)
+{
+#if UNITARU_PCM_BACKEND
+    return player.playing();
+#else
+    (void)player;
+    return s_playback.playing();
+#endif
+}
+
+// Blinks the LED a given number of times from one-shot scheduler tasks.
+class LedBlinker
 {
 public:
-    DfPlayerPicoSd()
-    {
-        // Initialize UART 0
-        uart_init(uart0, 9600);
+    static constexpr uint32_t ToggleMs = 100;
 
-        // Set the GPIO pin mux to the UART - 0 is TX, 1 is RX
-        gpio_set_function(0, GPIO_FUNC_UART);
-        gpio_set_function(1, GPIO_FUNC_UART);
+    explicit LedBlinker(uint pin) : m_pin(pin) {}
 
-        sendCmd(dfPlayer::SPECIFY_PLAYBACK_SRC, 0x0002); // Set to use only SD card.
-        displayMessage(uartRead());
+    void blink(uint count)
+    {
+        // A blink in progress just continues with the new count.
+        m_toggles = count * 2;
+        if (!m_running) {
+            m_running = sched_after("led", 0, &LedBlinker::onToggle, this, sched_now_ms()) >= 0;
+        }
     }
 
-    inline void uartSend(uint8_t* a_cmd)
+private:
+    static void onToggle(uint32_t, void* context)
     {
-        uart_write_blocking(uart0, a_cmd, SERIAL_CMD_SIZE);
+        auto* led = static_cast<LedBlinker*>(context);
+        if (led->m_toggles == 0) {
+            led->m_running = false;
+            return;
+        }
+        --led->m_toggles;
+        gpio_put(led->m_pin, led->m_toggles % 2 == 1);
+        led->m_running = sched_after("led", ToggleMs, &LedBlinker::onToggle, led, sched_now_ms()) >= 0;
     }
 
-    inline std::vector<uint8_t> uartRead()
-    {
-        std::vector<uint8_t> data;
-        if (!uart_is_readable(uart0)) return data;
+    uint m_pin;
+    uint m_toggles = 0;
+    bool m_running = false;
+};
 
-        data.resize(SERIAL_CMD_SIZE);
-        uart_read_blocking(uart0, data.data(), SERIAL_CMD_SIZE);
-        return data;
-    }
+void printTrace(const char* text, uint32_t len, void*)
+{
+    printf("%.*s", static_cast<int>(len), text);
+}
+
+void setup()
+{
+    // Initialize the standard I/O
+    stdio_init_all();
+
+    // Start the cycle counter used by the timing probes
+    trace_init();
+    trace_register(TraceMatrixScan, "matrix_scan", TRACE_UNIT_CYCLES);
+    trace_register(TracePlayerPoll, "player_poll", TRACE_UNIT_CYCLES);
+    trace_register(TraceQueryLatency, "query_latency", TRACE_UNIT_US);
+    trace_register(TraceKeyToPlay, "key_to_play", TRACE_UNIT_US);
+    trace_register(TraceWakeToKey, "wake_to_key", TRACE_UNIT_US);
 
-    uint getSoundCount()
+    // Settings saved by earlier runs
+    config_store_init_rp2040();
+
+    // Initialize the LED pin
+    gpio_init(LED_PIN);
+    gpio_set_dir(LED_PIN, GPIO_OUT);
+}
+
+// Reads "set <key> <value>" lines from stdio into the config store.
+class Console
+{
+public:
+    // Returns true if anything was typed.
+    bool poll(SoundBackend& player)
     {
-        sendCmd(0x47, 0x0000);
-        while (!uart_is_readable(uart0)) {
-            sleep_ms(100); // Wait for the response
-        }
-        const std::vector<uint8_t> response = uartRead();
-        if (response.size() < SERIAL_CMD_SIZE) {
-            printf("Not enough data received\n");
-            return 0; // Not enough data received
+        bool received = false;
+        int c;
+        while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+            received = true;
+            if (c != '\r' && c != '\n') {
+                if (m_length < sizeof(m_line) - 1) m_line[m_length++] = static_cast<char>(c);
+                continue;
+            }
+            m_line[m_length] = '\0';
+            if (m_length > 0) execute(player);
+            m_length = 0;
         }
-        return response[dfPlayer::serialCommFormat::PARA1] << 8 | response[dfPlayer::serialCommFormat::PARA2];
+        return received;
     }
 
-    void playSound(uint8_t soundNumber)
+private:
+    // Parsed with strtoul: sscanf would link newlib's scanf, and the malloc
+    // it uses, into an image that is meant to have no heap.
+    static bool parseSet(const char* line, uint32_t& key, uint32_t& value)
     {
-        constexpr uint8_t folder_index = 1;
-        sendCmd(dfPlayer::cmd::SPECIFY_FOLDER_PLAYBACK, 
-            folder_index << 8 | soundNumber);
+        if (strncmp(line, "set ", 4) != 0) {
+            return false;
+        }
+        char* end;
+        key = strtoul(line + 4, &end, 10);
+        if (end == line + 4 || *end != ' ') {
+            return false;
+        }
+        const char* valueText = end;
+        value = strtoul(valueText, &end, 10);
+        return end != valueText && *end == '\0';
     }
 
-    void setVolume(uint8_t volume)
+    void execute(SoundBackend& player)
     {
-        if (volume > 31) {
-            volume = 31; // Clip to maximum volume
+        uint32_t key;
+        uint32_t value;
+        if (!parseSet(m_line, key, value) || key > 0xffff || !config_store_set(key, value)) {
+            printf("Usage: set <key> <value>\n");
+            return;
         }
-        sendCmd(dfPlayer::cmd::SPECIFY_VOL, volume);
+        printf("Config %lu = %lu\n", static_cast<unsigned long>(key), static_cast<unsigned long>(value));
+
+        // Apply what the player holds; key sounds are read on each press.
+        if (key == ConfigVolume) player.setVolume(value);
+        if (key == ConfigFolder) player.setFolder(value);
     }
+
+    char m_line[32];
+    uint32_t m_length = 0;
 };
 
-void setup()
+// Reduces the system clock while nobody uses the board, and stops it
+// entirely until a key press once no USB host is attached and nothing plays.
+class PowerManager
 {
-    // Initialize the standard I/O
-    stdio_init_all();
-
-    // Initialize the LED pin
-    gpio_init(LED_PIN);
-    gpio_set_dir(LED_PIN, GPIO_OUT);
+public:
+    PowerManager() { idle_init(&m_idle, &IdleConfig, nowMs()); }
 
-    // Initialize Button In/Out.
-    gpio_init(ButtonRow0);
-    gpio_set_dir(ButtonRow0, GPIO_OUT);
-    gpio_put(ButtonRow0, 0);
-    gpio_init(ButtonRow1);
-    gpio_set_dir(ButtonRow1, GPIO_OUT);
-    gpio_put(ButtonRow1, 0);
-
-    gpio_init(ButtonCol0);
-    gpio_set_dir(ButtonCol0, GPIO_IN);
-    gpio_pull_down(ButtonCol0);
-    gpio_init(ButtonCol1);
-    gpio_set_dir(ButtonCol1, GPIO_IN);
-    gpio_pull_down(ButtonCol1);
-}
+    void activity() { idle_activity(&m_idle, nowMs()); }
 
-uint scan_matrix()
-{
-    uint result = 0;
+    // No key or host activity for the slow timeout.
+    bool idle() const { return m_idle.state != IdleActive; }
 
-    // Scan the first row
-    gpio_put(ButtonRow0, 1);
-    sleep_ms(1);
-    if (gpio_get(ButtonCol0)) {
-        result = 1; // Button at (0, 0)
+    // The first key event after dormant gives the wake latency. It runs from
+    // the clocks being restored, as the timer is stopped until then.
+    void keyEvent(const KeyEvent& event)
+    {
+        if (m_wakePending) {
+            trace_record(TraceWakeToKey, event.time_us - m_wakeUs);
+            m_wakePending = false;
+        }
+        activity();
     }
-    if (gpio_get(ButtonCol1)) {
-        result = 2; // Button at (0, 1)
+
+    void poll(ButtonMatrix& matrix, SoundBackend& player)
+    {
+        // A host attaching, leaving or resuming the bus counts as activity.
+        const bool connected = tud_mounted() && !tud_suspended();
+        if (connected != m_connected) {
+            m_connected = connected;
+            activity();
+        }
+
+        // The UART divider may only change between frames.
+        if (!player.txIdle()) return;
+
+        // Dormant only on battery, so a host plugged in finds a device
+        // that answers; idle_dormant_until also wakes on VBUS rising.
+        const bool dormantAllowed = !tud_mounted() && !idle_vbus_present() && !soundPlaying(player);
+        const idle_state_t state = idle_next(&m_idle, nowMs(), dormantAllowed);
+        if (state == IdleDormant) {
+            sleepUntilKey(matrix, player);
+        } else if (idle_set_clock(state)) {
+            player.onClockChanged();
+            matrix.onClockChanged();
+        }
     }
-    gpio_put(ButtonRow0, 0);
 
-    // Scan the second row
-    gpio_put(ButtonRow1, 1);
-    sleep_ms(1);
-    if (gpio_get(ButtonCol0)) {
-        result = 3; // Button at (1, 0)
+    void report() const
+    {
+        printf("idle state=%u est=%luuA dormant=%lu\n", static_cast<uint>(m_idle.state),
+               static_cast<unsigned long>(idle_estimate_ua(&m_idle, nowMs())),
+               static_cast<unsigned long>(m_idle.dormant_entries));
     }
-    if (gpio_get(ButtonCol1)) {
-        result = 4; // Button at (1, 1)
+
+private:
+    static uint32_t nowMs() { return to_ms_since_boot(get_absolute_time()); }
+
+    void sleepUntilKey(ButtonMatrix& matrix, SoundBackend& player)
+    {
+        const uint32_t columns = matrix.suspend();
+        idle_dormant_until(columns, 0);
+        player.onClockChanged();
+        matrix.onClockChanged();
+        matrix.resume();
+        m_wakeUs = time_us_32();
+        m_wakePending = true;
+        activity();
     }
-    gpio_put(ButtonRow1, 0);
 
-    return result;
+    idle_t m_idle;
+    bool m_connected = false;
+    bool m_wakePending = false;
+    uint32_t m_wakeUs = 0;
+};
+
+#if UNITARU_MULTICORE
+static ButtonMatrix* s_core1Matrix = nullptr;
+
+// Core 1 owns matrix scanning; its alarm pool fires on this core, so the
+// scan interrupts never delay USB or UART servicing on core 0.
+void core1Main()
+{
+    trace_init(); // SysTick is per core
+    multicore_lockout_victim_init(); // Parked while core 0 writes flash
+    alarm_pool_t* pool = alarm_pool_create_with_unused_hardware_alarm(4);
+#if UNITARU_PIO_SCANNER
+    s_core1Matrix->startPio(pio0, 10, 1000, pool);
+#else
+    s_core1Matrix->start(250, pool);
+#endif
+    while (true) {
+        __wfi();
+    }
 }
+#endif
 
 int main()
 {
     setup();
     printf("setup done.\n");
-    sleep_ms(1000); // Allow time for setup to complete
 
-    DfPlayerPicoSd player;
+    // The player holds commands until the module has started, so nothing
+    // here waits for it.
+    SoundBackend player;
+#if UNITARU_DF_BENCHMARK
+    DfLinkBenchmark(player).run();
+#endif
+#if !UNITARU_PCM_BACKEND
+    player.setResponseHandler(displayResponse, &player);
+#endif
     printf("Player initialized.\n");
 
-    player.setVolume(25); // Set initial volume
-    displayMessage(player.uartRead());
+    player.setFolder(config_store_get_or(ConfigFolder, DefaultFolder));
+    player.setVolume(config_store_get_or(ConfigVolume, DefaultVolume)); // Set initial volume
     printf("Player set volume.\n");
 
+    // Tracks known from the last run are checked against right away; the
+    // card is only enumerated again if its signature changed.
+#if !UNITARU_PCM_BACKEND
+    s_trackIndex.load();
+    s_trackIndex.verify(player);
+
+    s_playback.setPolicy(PlaybackScheduler::policyFromValue(
+        config_store_get_or(ConfigPlaybackPolicy, static_cast<uint32_t>(PlaybackScheduler::Policy::Interrupt))));
+#endif
+
+    ButtonMatrix matrix;
+#if UNITARU_MULTICORE
+    s_core1Matrix = &matrix;
+    multicore_launch_core1(core1Main);
+#elif UNITARU_PIO_SCANNER
+    matrix.startPio(pio0);
+#else
+    matrix.start();
+#endif
+    LedBlinker led(LED_PIN);
+    Console console;
+    PowerManager power;
+
+    // Timing statistics, once a second while a terminal is attached, and
+    // one flash operation per second at most. A sector erase holds off
+    // interrupts for tens of milliseconds, so it waits until the keys are
+    // idle.
+    sched_init();
+    sched_every("report", 1000, 100, [](uint32_t, void* context) {
+        if (stdio_usb_connected()) {
+            trace_report(printTrace, nullptr);
+            sched_report(printTrace, nullptr);
+            static_cast<PowerManager*>(context)->report();
+        }
+    }, &power, sched_now_ms());
+    sched_every("config", 1000, 100, [](uint32_t, void* context) {
+        if (config_store_next_is_erase() && !static_cast<PowerManager*>(context)->idle()) return;
+        config_store_task();
+    }, &power, sched_now_ms());
+
     while (true) {
         // Key input handling.
-        const uint code = scan_matrix();
-        for (uint index = 0; index < code; ++index) {
-            gpio_put(LED_PIN, true);
-            sleep_ms(100);
-            gpio_put(LED_PIN, false);
-            sleep_ms(100);
-        }
-        if (code > 0) {
-            printf("Button pressed: %u\n", code);
-            player.playSound(code); // Adjust for zero-based index
+        KeyEvent event;
+        while (matrix.popEvent(event)) {
+            power.keyEvent(event);
+            if (!event.pressed) continue;
+            const uint code = config_store_get_or(ConfigKeySoundBase + event.key, KeySounds[event.key]);
+            printf("Button pressed: %u (keys 0x%02x)\n", code, static_cast<uint>(matrix.pressedKeys()));
+#if UNITARU_PCM_BACKEND
+            const bool known = player.hasSound(player.folder(), code);
+#else
+            const bool known = s_trackIndex.contains(player.folder(), code);
+#endif
+            if (!known) {
+                printf("Sound %u is not on the card\n", code);
+                continue;
+            }
+#if UNITARU_PCM_BACKEND
+            // Started at once; the DFPlayer's command pacing does not apply.
+            player.playSound(player.folder(), code);
+#else
+            s_playback.request(player.folder(), code);
+#endif
+            led.blink(code);
         }
 
-        // Display results of player operations.
-        const std::vector<uint8_t> data = player.uartRead();
-        if (!data.empty())
-            displayMessage(data);
+        // Dispatch results of player operations.
+        const uint32_t pollBegin = trace_begin();
+        player.poll();
+        trace_end(TracePlayerPoll, pollBegin);
+#if !UNITARU_PCM_BACKEND
+        s_playback.poll(player);
+#endif
+
+        trace_collect();
+        const uint32_t waitMs = sched_run(sched_now_ms());
+        if (console.poll(player)) {
+            power.activity();
+        }
+        power.poll(matrix, player);
 
-        gpio_put(LED_PIN, false);
-        sleep_ms(100);
+        // Woken by any interrupt on this core, by the matrix's event signal
+        // when it runs on core 1, or by the alarm of the next scheduled task.
+        if (waitMs > 0) {
+            sched_arm(waitMs);
+            __wfe();
+        }
     }
 }
@@ -0,0 +1,15 @@
+# Fails the build when the linked image still contains a heap allocator.
+# Invoked after linking with -DNM=<nm> -DELF=<elf>.
+
+execute_process(
+    COMMAND ${NM} --defined-only ${ELF}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Could not read symbols from ${ELF}")
+endif()
+
+string(REGEX MATCHALL "[^\n]* [TtWw] (malloc|__wrap_malloc|_malloc_r|calloc|__wrap_calloc|realloc|__wrap_realloc|_Znwj|_Znaj)\n" heap_symbols "${symbols}")
+if (heap_symbols)
+    message(FATAL_ERROR "Heap allocator linked into ${ELF}:\n${heap_symbols}")
+endif()
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+import platform
+import subprocess
+import time
+
+import hid
+
+# button_and_volume のベンダー定義ボリュームレポート
+USB_VID = 0xCAFE
+VOLUME_LEVEL_USAGE_PAGE = 0xFF00
+VOLUME_LEVEL_USAGE = 0x01
+REPORT_ID_VOLUME_LEVEL = 5
+VOLUME_LEVEL_MAX = 100
+
+def find_volume_device():
+    devices = hid.enumerate(USB_VID, 0)
+    # Windows/macOS ではコレクションごとにデバイスが列挙される
+    for info in devices:
+        if info['usage_page'] == VOLUME_LEVEL_USAGE_PAGE and info['usage'] == VOLUME_LEVEL_USAGE:
+            return info['path']
+    # Linux (hidraw) ではインターフェースごとに1つだけ
+    return devices[0]['path'] if devices else None
+
+def set_system_volume(level):
+    percent = level * 100 // VOLUME_LEVEL_MAX
+    system = platform.system()
+    if system == 'Linux':
+        subprocess.run(['pactl', 'set-sink-volume', '@DEFAULT_SINK@', f'{percent}%'], check=False)
+    elif system == 'Darwin':
+        subprocess.run(['osascript', '-e', f'set volume output volume {percent}'], check=False)
+    elif system == 'Windows':
+        from ctypes import cast, POINTER
+        from comtypes import CLSCTX_ALL
+        from pycaw.pycaw import AudioUtilities, IAudioEndpointVolume
+        speakers = AudioUtilities.GetSpeakers()
+        interface = speakers.Activate(IAudioEndpointVolume._iid_, CLSCTX_ALL, None)
+        cast(interface, POINTER(IAudioEndpointVolume)).SetMasterVolumeLevelScalar(percent / 100, None)
+
+def read_latest_level(device):
+    # 溜まっているレポートを読み捨て、最新の値だけを返す
+    level = None
+    while True:
+        data = device.read(64, timeout_ms=1 if level is not None else 1000)
+        if not data:
+            return level
+        if data[0] == REPORT_ID_VOLUME_LEVEL and len(data) >= 2:
+            level = min(data[1], VOLUME_LEVEL_MAX)
+
+path = find_volume_device()
+if not path:
+    print("ボリュームデバイスが見つかりませんでした…")
+    raise SystemExit(1)
+
+device = hid.device()
+device.open_path(path)
+print(f"ボリュームデバイスを開きました: {path}")
+
+applied = None
+try:
+    while True:
+        level = read_latest_level(device)
+        if level is not None and level != applied:
+            set_system_volume(level)
+            applied = level
+            print(f"ボリューム: {level}")
+        time.sleep(0.005)
+finally:
+    device.close()
@@ -0,0 +1,67 @@
+#include "adc_sampler.h"
+#include "volume_filter.h"
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+// The DMA write ring wraps on an address boundary of its own size.
+static uint16_t s_ring[ADC_SAMPLER_RING_SAMPLES] __attribute__((aligned(1u << ADC_SAMPLER_RING_BITS)));
+static int s_dma_channel = -1;
+static volatile uint32_t s_base_count = 0;  // Samples converted before the current transfer
+
+static void start_transfer(void) {
+  dma_channel_config config = dma_channel_get_default_config(s_dma_channel);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, false);
+  channel_config_set_write_increment(&config, true);
+  channel_config_set_ring(&config, true, ADC_SAMPLER_RING_BITS);
+  channel_config_set_dreq(&config, DREQ_ADC);
+
+  // The longest transfer lasts about a day at 44.1 kHz; read_mean re-arms it.
+  dma_channel_configure(s_dma_channel, &config, s_ring, &adc_hw->fifo, 0xffffffffu, true);
+}
+
+void adc_sampler_init(void) {
+  // Keep the error flag in bit 15 so bad conversions can be skipped.
+  adc_fifo_setup(true, true, 1, true, false);
+  adc_fifo_drain();
+
+  s_dma_channel = dma_claim_unused_channel(true);
+  start_transfer();
+  adc_run(true);
+}
+
+// Samples written since adc_sampler_init(), wrapping at 32 bits.
+static uint32_t converted_count(void) {
+  return s_base_count + (0xffffffffu - dma_channel_hw_addr(s_dma_channel)->transfer_count);
+}
+
+static void restart_if_idle(void) {
+  if (dma_channel_is_busy(s_dma_channel)) return;
+  s_base_count = converted_count();
+  start_transfer();
+}
+
+bool adc_sampler_read_mean(uint16_t* mean) {
+  restart_if_idle();
+
+  return volume_filter_block_mean(s_ring, ADC_SAMPLER_RING_SAMPLES, mean);
+}
+
+uint32_t adc_sampler_copy(uint32_t* cursor, uint32_t* first, uint16_t* samples, uint32_t max_count, uint32_t step) {
+  // Stay clear of the slots the DMA is about to overwrite while copying.
+  static const uint32_t Margin = 32;
+  const uint32_t end = converted_count();
+  uint32_t position = *cursor;
+  if (end - position > ADC_SAMPLER_RING_SAMPLES - Margin)
+    position = end - (ADC_SAMPLER_RING_SAMPLES - Margin);
+  *first = position;
+
+  uint32_t count = 0;
+  while (count < max_count && end - position >= step) {
+    samples[count++] = s_ring[(position - s_base_count) % ADC_SAMPLER_RING_SAMPLES];
+    position += step;
+  }
+  *cursor = position;
+  return count;
+}
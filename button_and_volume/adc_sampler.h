@@ -0,0 +1,26 @@
+#ifndef ADC_SAMPLER_H_
+#define ADC_SAMPLER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Free-running ADC streamed into a ring buffer by DMA.
+// The CPU does no work per sample; callers read the whole ring when they
+// need a new value.
+
+#define ADC_SAMPLER_RING_BITS    (9)  // Ring size in bytes as a power of two
+#define ADC_SAMPLER_RING_SAMPLES ((1u << ADC_SAMPLER_RING_BITS) / sizeof(uint16_t))
+
+// The ADC input, clock divider and round robin must already be configured.
+void adc_sampler_init(void);
+
+// Mean of the samples currently in the ring, without ADC error samples.
+bool adc_sampler_read_mean(uint16_t* mean);
+
+// Copies up to max_count samples converted since *cursor, taking every
+// step-th one, and advances *cursor past them. Samples the ring no longer
+// holds are skipped; *first is the index of the first sample copied.
+// Indices count conversions since adc_sampler_init() and wrap at 32 bits.
+uint32_t adc_sampler_copy(uint32_t* cursor, uint32_t* first, uint16_t* samples, uint32_t max_count, uint32_t step);
+
+#endif /* ADC_SAMPLER_H_ */
@@ -6,33 +6,72 @@
 #include "tusb.h"
 
 #include "usb_descriptors.h"
-
-#include "hardware/adc.h"
-#include "hardware/gpio.h"
+#include "report_queue.h"
+#include "macro.h"
+#include "input.h"
+#include "telemetry.h"
+#include "config_keys.h"
+#include "config_store.h"
+#include "trace.h"
+#include "idle.h"
+#include "sched.h"
+
+#if BUTTON_AND_VOLUME_HID_BENCHMARK
+#include "hid_benchmark.h"
+#endif
+
+#include "pico/stdlib.h"
 #include "pico/binary_info.h"
 
-#define ADC_INDEX (0)
-#define SAMPLE_COUNT (8)
-
-static const uint32_t PushButtonGPIO = 16;
-static const uint32_t VolumeGPIO = 26 + ADC_INDEX;
+// 1: report the knob as an absolute level, 0: as volume up/down key steps.
+#ifndef VOLUME_ABSOLUTE
+#define VOLUME_ABSOLUTE (1)
+#endif
 
-static const uint16_t DiffMax = 10;
+// Consumer keys are released this long after the press.
+static const uint32_t ConsumerTapMs = 10;
+// Play/pause presses closer together than this are ignored as bounce.
+static const uint32_t PlayPauseHoldOffMs = 500;
+// Turning the knob this many levels within KnobGestureMs is a gesture.
+static const uint8_t KnobGestureLevels = 20;
+static const uint32_t KnobGestureMs = 300;
 
-static uint16_t s_hid_state = 0;
-static uint32_t s_start_ms = 0;
-static uint16_t s_past_adc_values[SAMPLE_COUNT];
-static uint32_t s_sample_index = 0;
 static uint32_t s_current_button = 0;
 static uint16_t s_sent_volume = 0;
-
-enum HIDState {
-  HIDInitIdle,
-  HIDInitSending,
-  HIDIdle,
-  HIDSending,
+static uint8_t s_volume_level = 0;
+static bool s_has_volume_level = false;
+static hid_gamepad_report_t s_gamepad = {0};
+static bool s_gamepad_pending = false;
+static int32_t s_wheel_delta = 0;
+// Key of the last keyboard report the host took, 0 for none.
+static uint8_t s_sent_key = 0;
+
+// Inputs are sampled and reports started every HidIntervalMs. A tick more
+// than HidDeadlineMs late counts as a missed deadline.
+static const uint32_t HidIntervalMs = 10;
+static const uint32_t HidDeadlineMs = 5;
+// Press and release of the on-board button's key, twice, at startup.
+static const uint32_t StartupKeySteps = 4;
+
+static int s_startup_task = -1;
+
+// Timing probes reported over the CDC interface.
+enum TraceProbe {
+  TraceUsbTask,
+  TraceHidTask,
+  TraceTickLate,
+  TraceWakeToReport,
 };
 
+// Clock is reduced after this long without input or USB activity, and the
+// chip goes dormant after the second limit when no USB host is attached.
+static const idle_config_t IdleConfig = {10000, 60000};
+
+static idle_t s_idle;
+static idle_state_t s_power_state = IdleActive;
+static uint32_t s_wake_us = 0;
+static bool s_wake_pending = false;
+
 enum ButtonType {
   OnBoardButton = 1,
   PushButton,
@@ -42,206 +81,354 @@ enum ButtonType {
   Error,
 };
 
-void initialize_volume(void);
+void initialize_volume(uint32_t late_ms, void* context);
 void adjust_volume(uint16_t current_volume);
-void hid_task(void);
-static void send_hid_report(uint8_t report_id, uint32_t button);
+void hid_task(uint32_t late_ms, void* context);
+static bool send_hid_report(uint8_t report_id, uint32_t button);
+static bool send_next_report(uint8_t first_report_id);
+static void update_pointer_state(input_state_t const* input);
+static bool start_macro(macro_trigger_t trigger);
+static void update_knob_gesture(input_state_t const* input);
+static bool queue_consumer_tap(uint16_t usage);
+static void queue_play_pause(void);
+static bool send_volume_level(void);
+static void trace_task(uint32_t late_ms, void* context);
+static void send_trace_text(void);
+static void config_task(uint32_t late_ms, void* context);
+static void note_activity(void);
+static void power_task(uint32_t wait_ms);
 
 int main() {
   board_init();
+  usb_descriptors_init();
   tusb_init();
 
-  gpio_init(PushButtonGPIO);
-  gpio_set_dir(PushButtonGPIO, GPIO_IN);
-  gpio_pull_up(PushButtonGPIO);
-
-  adc_init();
-  adc_gpio_init(VolumeGPIO);
-  adc_set_clkdiv(1088.44 - 1.0);
-  adc_select_input(ADC_INDEX);
-  adc_set_round_robin(0x0);
-
-  s_hid_state = HIDInitIdle;
-
-  for (uint32_t index = 0; index < SAMPLE_COUNT; ++index)
-    s_past_adc_values[index] = 0;
+  trace_init();
+  trace_register(TraceUsbTask, "tud_task", TRACE_UNIT_CYCLES);
+  trace_register(TraceHidTask, "hid_task", TRACE_UNIT_CYCLES);
+  trace_register(TraceTickLate, "tick_late", TRACE_UNIT_US);
+  trace_register(TraceWakeToReport, "wake_to_report", TRACE_UNIT_US);
+  idle_init(&s_idle, &IdleConfig, board_millis());
+
+  config_store_init_rp2040();
+  input_init();
+#if BUTTON_AND_VOLUME_MULTICORE
+  // Core 1 owns sampling and filtering; core 0 only services USB.
+  input_launch_core1(10);
+#endif
+
+  report_queue_init();
+  macro_init();
+  telemetry_init();
+#if BUTTON_AND_VOLUME_HID_BENCHMARK
+  hid_benchmark_init();
+#endif
+
+  const uint32_t now_ms = board_millis();
+  sched_init();
+  s_startup_task = sched_every("startup", HidIntervalMs, HidDeadlineMs, initialize_volume, NULL, now_ms);
+  sched_every("trace", 1000, 100, trace_task, NULL, now_ms);
+  // Settings reach flash one page or erase per second, so a burst of changes
+  // from the host is coalesced and USB only sees an occasional short stall.
+  // The long stall of an erase waits until the input is idle.
+  sched_every("config", 1000, 100, config_task, NULL, now_ms);
 
   while (1)
   {
+    const uint32_t begin = trace_begin();
     tud_task();
+    trace_end(TraceUsbTask, begin);
 
-    if (s_hid_state == HIDInitIdle || s_hid_state == HIDInitSending) {
-      initialize_volume();
-    } else {
-      hid_task();
-    }
+    // Restart the report chain when the endpoint went idle.
+    if (!report_queue_send_next())
+      send_next_report(REPORT_ID_KEYBOARD);
+
+    const uint32_t wait_ms = sched_run(board_millis());
+
+    telemetry_task();
+    send_trace_text();
+    trace_collect();
+    power_task(wait_ms);
   }
 
   return 0;
 }
 
-void initialize_volume(void) {
-  static const uint32_t interval_ms = 10;
-  if (board_millis() - s_start_ms < interval_ms) return;
-  s_start_ms += interval_ms;
+// Runs every tick until the startup key presses are out, then hands the
+// tick over to hid_task().
+void initialize_volume(uint32_t late_ms, void* context) {
+  static uint32_t step = 0;
+  (void) late_ms;
+  (void) context;
 
   if (tud_suspended()) {
     tud_remote_wakeup();
+    return;
   }
-  else {
-    static int count = 2;
-    if (s_hid_state == HIDInitIdle) {
-      if (count > 0) {
-        s_current_button = OnBoardButton;
-        send_hid_report(REPORT_ID_KEYBOARD, s_current_button);
-        count--;
-        s_hid_state = HIDInitSending;
-      }
-    } else if (s_hid_state == HIDInitSending) {
-      s_current_button = 0;
-      send_hid_report(REPORT_ID_KEYBOARD, s_current_button);
-      if (count == 0) {
-        s_hid_state = HIDIdle;
-        s_sent_volume = 0;
-      } else {
-        s_hid_state = HIDInitIdle;
-      }
-    }
-  }
+
+  s_current_button = step % 2 == 0 ? OnBoardButton : 0;
+  send_hid_report(REPORT_ID_KEYBOARD, s_current_button);
+  if (++step < StartupKeySteps) return;
+
+  sched_cancel(s_startup_task);
+  s_sent_volume = 0;
+  sched_every("hid", HidIntervalMs, HidDeadlineMs, hid_task, NULL, board_millis());
 }
 
 void adjust_volume(uint16_t currnet_volume) {
-return;
-
   currnet_volume /= 2;
-  while (currnet_volume < s_sent_volume) {
-    if (tud_suspended()) {
-      tud_remote_wakeup();
-      sleep_ms(2);
-    }
+  if (tud_suspended()) {
+    tud_remote_wakeup();
+    return; // Try again on the next tick
+  }
 
-    send_hid_report(REPORT_ID_CONSUMER_CONTROL, VolumeDown);
+  // Queue as many steps as fit; the rest follow on later ticks.
+  while (currnet_volume < s_sent_volume) {
+    if (!queue_consumer_tap(HID_USAGE_CONSUMER_VOLUME_DECREMENT)) break;
     s_sent_volume--;
-    sleep_ms(2);
   }
   while (currnet_volume > s_sent_volume) {
-    if (tud_suspended()) {
-      tud_remote_wakeup();
-      sleep_ms(2);
-    }
-
-    send_hid_report(REPORT_ID_CONSUMER_CONTROL, VolumeUp);
+    if (!queue_consumer_tap(HID_USAGE_CONSUMER_VOLUME_INCREMENT)) break;
     s_sent_volume++;
-    sleep_ms(2);
   }
 }
 
-void hid_task(void) {
-  static const uint32_t interval_ms = 10;
+void hid_task(uint32_t late_ms, void* context) {
+  (void) context;
+
+  const uint32_t begin = trace_begin();
+  trace_record(TraceTickLate, late_ms * 1000);
+
+  input_state_t input;
+  input_read(&input);
+  telemetry_send_input(&input);
 
-  if (board_millis() - s_start_ms < interval_ms) return;
-  s_start_ms += interval_ms;
+  static uint8_t prev_level = 0;
+  if (input.push_edge || input.board_button || (input.level_valid && input.level != prev_level))
+    note_activity();
+  if (input.level_valid)
+    prev_level = input.level;
+
+  // Inputs bound to a macro start it on the press and skip their own key.
+  static bool prev_board_button = false;
+  const bool board_bound = macro_table_get(config_store_get_or(ConfigMacroBoardButton, 0)) != NULL;
+  if (board_bound && input.board_button && !prev_board_button)
+    start_macro(MacroTriggerBoardButton);
+  prev_board_button = input.board_button;
+  const bool push_bound = input.push_edge && start_macro(MacroTriggerPushButton);
+  update_knob_gesture(&input);
 
   s_current_button = 0;
-  static uint32_t prev_button = 0;
-  if (board_button_read()) {
+  if (input.board_button && !board_bound) {
     //s_current_button = OnBoardButton;
     s_current_button = PushButton;
   }
-  if (!gpio_get(PushButtonGPIO)) {
-    if (!prev_button != PushButton)
-      s_current_button = PushButton;
+  // The press edge is queued here because s_current_button is overwritten
+  // before the report chain reaches the consumer report.
+  if (input.push_edge && !push_bound) {
+    s_current_button = PushButton;
+    queue_play_pause();
   }
 
-  const uint16_t adc_value = adc_read();
-  if ((adc_value & 0x8000) == 0) {
-    s_past_adc_values[s_sample_index] = adc_value;
-    s_sample_index = (s_sample_index + 1) % SAMPLE_COUNT;
-    uint16_t prev_value = 0;
-    for (uint32_t index = 0; index < SAMPLE_COUNT; ++index)
-      prev_value += s_past_adc_values[index];
-    prev_value /= SAMPLE_COUNT;
-    const uint16_t scaled_volume = prev_value * 1.f / 4096 * 100;
-    adjust_volume(scaled_volume);
+  if (input.level_valid) {
+#if VOLUME_ABSOLUTE
+    // Only the latest level is kept; send_volume_level() picks it up.
+    s_volume_level = input.level;
+    s_has_volume_level = true;
+#else
+    adjust_volume(input.level);
+#endif
   }
   else
   {
     s_current_button = Error;
   }
-  prev_button = s_current_button;
+  update_pointer_state(&input);
 
-  if (tud_suspended() && s_current_button)
+  if (tud_suspended() && (s_current_button || macro_active()))
   {
     tud_remote_wakeup();
   } else {
-    send_hid_report(REPORT_ID_KEYBOARD, s_current_button);
+    send_next_report(REPORT_ID_KEYBOARD);
+  }
+
+  trace_end(TraceHidTask, begin);
+}
+
+// Maps the knob and buttons to the gamepad and mouse reports enabled in the
+// config store. Only changes are kept pending, so unchanged state costs no
+// USB transaction.
+static void update_pointer_state(input_state_t const* input) {
+  static uint8_t wheel_level = 0;
+  static bool has_wheel_level = false;
+
+  const uint32_t knob_report = config_store_get_or(ConfigKnobReport, KnobReportLevelOnly);
+
+  hid_gamepad_report_t gamepad = s_gamepad;
+  if (knob_report == KnobReportGamepadX && input->level_valid)
+    gamepad.x = (int8_t)((int32_t)input->level * 254 / VOLUME_LEVEL_MAX - 127);
+  if (config_store_get_or(ConfigGamepadButtons, 0))
+    gamepad.buttons = (input->push_held ? GAMEPAD_BUTTON_0 : 0) | (input->board_button ? GAMEPAD_BUTTON_1 : 0);
+  if (memcmp(&gamepad, &s_gamepad, sizeof(gamepad)) != 0) {
+    s_gamepad = gamepad;
+    s_gamepad_pending = true;
+  }
+
+  if (knob_report == KnobReportMouseWheel && input->level_valid) {
+    // The first level only sets the reference, so boot does not scroll.
+    if (has_wheel_level)
+      s_wheel_delta += (int32_t)input->level - wheel_level;
+    wheel_level = input->level;
+    has_wheel_level = true;
+  } else {
+    has_wheel_level = false;
+  }
+}
+
+// Starts the macro bound to the trigger. Returns false if none is bound.
+static bool start_macro(macro_trigger_t trigger) {
+  macro_t const* macro = macro_table_get(config_store_get_or(ConfigMacroPushButton + trigger, 0));
+  if (macro == NULL) return false;
+  macro_start(macro);
+  return true;
+}
+
+// Starts the knob macros on a fast turn. The reference level is taken again
+// once the turn took longer than KnobGestureMs, so slow turns never count.
+static void update_knob_gesture(input_state_t const* input) {
+  static uint8_t ref_level = 0;
+  static uint32_t ref_ms = 0;
+  static bool has_ref = false;
+
+  const uint32_t now_ms = board_millis();
+  if (!input->level_valid) {
+    has_ref = false;
+    return;
+  }
+  if (!has_ref || now_ms - ref_ms > KnobGestureMs) {
+    ref_level = input->level;
+    ref_ms = now_ms;
+    has_ref = true;
+    return;
+  }
+
+  const int32_t turn = (int32_t)input->level - ref_level;
+  if (turn >= KnobGestureLevels) {
+    start_macro(MacroTriggerKnobUp);
+  } else if (turn <= -KnobGestureLevels) {
+    start_macro(MacroTriggerKnobDown);
+  } else {
+    return;
+  }
+  ref_level = input->level;
+  ref_ms = now_ms;
+}
+
+// Sends the first report from first_report_id on that has something new.
+// Report IDs with nothing to send are skipped, so each poll interval carries
+// at most one useful report instead of a walk through every ID.
+static bool send_next_report(uint8_t first_report_id) {
+  for (uint8_t report_id = first_report_id; report_id < REPORT_ID_COUNT; report_id++) {
+    if (send_hid_report(report_id, s_current_button)) return true;
   }
+  return false;
 }
 
-static void send_hid_report(uint8_t report_id, uint32_t button) {
-  if (!tud_hid_ready()) return;
+// Returns true if a report was sent.
+static bool send_hid_report(uint8_t report_id, uint32_t button) {
+  if (!tud_hid_ready()) return false;
   
   switch (report_id) {
   case REPORT_ID_KEYBOARD:
   {
-    static bool has_keyboard_key = false;
-    if (button) {
-      uint8_t keycode[6] = {0};
-      if (button == OnBoardButton)
-        keycode[0] = HID_KEY_A;
-      else if (button == Error)
-        keycode[0] = HID_KEY_E;
-
-      tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, keycode);
-      has_keyboard_key = true;
-    } else {
-      if (has_keyboard_key) 
-        tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, NULL);
-        has_keyboard_key = false;
+    // A running macro owns the keyboard report until its keys are up.
+    if (macro_active()) {
+      s_sent_key = 0;
+      return macro_send_next(REPORT_ID_KEYBOARD);
     }
-    break;
+
+    // The host keeps a key down until told otherwise, so only changes are
+    // sent, not the same report every poll while a button is held.
+    uint8_t key = 0;
+    if (button == OnBoardButton)
+      key = (uint8_t)config_store_get_or(ConfigBoardButtonKey, HID_KEY_A);
+    else if (button == Error)
+      key = (uint8_t)config_store_get_or(ConfigErrorKey, HID_KEY_E);
+    if (key == s_sent_key) return false;
+
+    const uint8_t keycode[6] = {key};
+    if (!tud_hid_keyboard_report(REPORT_ID_KEYBOARD, 0, key ? keycode : NULL)) return false;
+    s_sent_key = key;
+    return true;
   }
   
   case REPORT_ID_CONSUMER_CONTROL:
   {
-    static bool has_consumer_key = false;
-
-    if (button) {
-      if (button == PushButton) {
-        uint16_t play_pause = HID_USAGE_CONSUMER_PLAY_PAUSE;
-        tud_hid_report(REPORT_ID_CONSUMER_CONTROL, &play_pause, 2);
-        sleep_ms(500);
-        has_consumer_key = true;
-      } else if (button == VolumeUp) {
-        uint16_t volume_up = HID_USAGE_CONSUMER_VOLUME_INCREMENT;
-        tud_hid_report(REPORT_ID_CONSUMER_CONTROL, &volume_up, 2);
-        sleep_ms(200);
-        has_consumer_key = true;
-      } else if (button == VolumeDown) {
-        uint16_t volume_down = HID_USAGE_CONSUMER_VOLUME_DECREMENT;
-        tud_hid_report(REPORT_ID_CONSUMER_CONTROL, &volume_down, 2);
-        sleep_ms(200);
-        has_consumer_key = true;
-      } else {
-        uint16_t empty_key = 0;
-        if (has_consumer_key) 
-          tud_hid_report(REPORT_ID_CONSUMER_CONTROL, &empty_key, 2);
-        has_consumer_key = false;
-      }
+    // Consumer keys go through the report queue as press/release pairs.
+    if (button == PushButton) {
+      queue_play_pause();
+    } else if (button == VolumeUp) {
+      queue_consumer_tap(HID_USAGE_CONSUMER_VOLUME_INCREMENT);
+    } else if (button == VolumeDown) {
+      queue_consumer_tap(HID_USAGE_CONSUMER_VOLUME_DECREMENT);
     }
-    break;
+    return report_queue_send_next();
   }
 
   case REPORT_ID_MOUSE:
   {
-    int8_t const delta = 0;
-    tud_hid_mouse_report(REPORT_ID_MOUSE, 0x00, delta, delta, 0, 0);
-    break;
+    if (s_wheel_delta == 0) return false;
+    // Large turns are spread over several reports.
+    const int8_t wheel = (int8_t)(s_wheel_delta > 127 ? 127 : s_wheel_delta < -127 ? -127 : s_wheel_delta);
+    if (!tud_hid_mouse_report(REPORT_ID_MOUSE, 0x00, 0, 0, wheel, 0)) return false;
+    s_wheel_delta -= wheel;
+    return true;
   }
-  case REPORT_ID_GAMEPAD: 
+
+  case REPORT_ID_GAMEPAD:
   {
-    break;
+    if (!s_gamepad_pending) return false;
+    if (!tud_hid_report(REPORT_ID_GAMEPAD, &s_gamepad, sizeof(s_gamepad))) return false;
+    s_gamepad_pending = false;
+    return true;
   }
+
+  case REPORT_ID_VOLUME_LEVEL:
+    return send_volume_level();
+  }
+  return false;
+}
+
+// Sends the latest knob level if it differs from the last one sent.
+// Intermediate levels are overwritten, so a fast turn settles in one report.
+static bool send_volume_level(void) {
+  static uint8_t sent_level = 0;
+  static bool has_sent_level = false;
+
+  if (!s_has_volume_level || (has_sent_level && sent_level == s_volume_level)) return false;
+  if (!tud_hid_ready()) return false;
+
+  const uint8_t level = s_volume_level;
+  if (!tud_hid_report(REPORT_ID_VOLUME_LEVEL, &level, sizeof(level))) return false;
+  sent_level = level;
+  has_sent_level = true;
+  return true;
+}
+
+static bool queue_consumer_tap(uint16_t usage) {
+  const uint16_t release = 0;
+  return report_queue_push_tap(REPORT_ID_CONSUMER_CONTROL, &usage, &release, sizeof(usage), ConsumerTapMs);
+}
+
+static void queue_play_pause(void) {
+  static bool has_play_pause = false;
+  static uint32_t play_pause_ms = 0;
+
+  const uint32_t now_ms = board_millis();
+  if (has_play_pause && now_ms - play_pause_ms < PlayPauseHoldOffMs) return;
+  if (queue_consumer_tap(HID_USAGE_CONSUMER_PLAY_PAUSE)) {
+    has_play_pause = true;
+    play_pause_ms = now_ms;
   }
 }
 
@@ -252,12 +439,21 @@ void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_
   (void) instance;
   (void) len;
 
-  uint8_t next_report_id = report[0] + 1u;
-
-  if (next_report_id < REPORT_ID_COUNT)
-  {
-    send_hid_report(next_report_id, s_current_button);
+#if BUTTON_AND_VOLUME_HID_BENCHMARK
+  hid_benchmark_report_complete(report, len);
+#endif
+  if (s_wake_pending) {
+    trace_record(TraceWakeToReport, time_us_32() - s_wake_us);
+    s_wake_pending = false;
   }
+
+  // Queued reports take the next poll interval.
+  if (report_queue_send_next()) return;
+
+  // Wrap around to the keyboard report, so a running macro takes the next
+  // poll interval the other reports leave free.
+  if (send_next_report(report[0] + 1u)) return;
+  send_next_report(REPORT_ID_KEYBOARD);
 }
 
 uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t* buffer, uint16_t reqlen)
@@ -281,3 +477,115 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_
   (void) buffer;
   (void) bufsize;
 }
+
+// One report of trace_task(), sent from the main loop as the CDC FIFO makes
+// room: a whole report is larger than CFG_TUD_CDC_TX_BUFSIZE.
+static char s_trace_text[1024];
+static uint32_t s_trace_len = 0;
+static uint32_t s_trace_sent = 0;
+
+// Keeps whole lines only; a line that no longer fits is left out.
+static void write_trace_text(const char* text, uint32_t len, void* context) {
+  (void) context;
+  if (len > sizeof(s_trace_text) - s_trace_len) return;
+  memcpy(&s_trace_text[s_trace_len], text, len);
+  s_trace_len += len;
+}
+
+// Writes the statistics of the probes and the scheduler into s_trace_text.
+// A report still being sent is not replaced. The probe rings are drained
+// every loop.
+static void trace_task(uint32_t late_ms, void* context) {
+  (void) late_ms;
+  (void) context;
+
+  if (!tud_cdc_connected() || !telemetry_enabled(TelemetryStreamTrace)) return;
+  if (s_trace_sent < s_trace_len) return;
+
+  s_trace_len = 0;
+  s_trace_sent = 0;
+  trace_report(write_trace_text, NULL);
+  sched_report(write_trace_text, NULL);
+  macro_report(write_trace_text, NULL);
+
+  char line[64];
+  const int len = snprintf(line, sizeof(line), "idle state=%u est=%luuA dormant=%lu\r\n", s_idle.state,
+                           (unsigned long)idle_estimate_ua(&s_idle, board_millis()),
+                           (unsigned long)s_idle.dormant_entries);
+  if (len > 0) write_trace_text(line, (uint32_t)len, NULL);
+#if BUTTON_AND_VOLUME_HID_BENCHMARK
+  hid_benchmark_report(write_trace_text, NULL);
+#endif
+}
+
+// Sends as much of the pending report as fits without dropping packets.
+static void send_trace_text(void) {
+  if (s_trace_sent == s_trace_len) return;
+  if (!tud_cdc_connected()) {
+    s_trace_sent = s_trace_len;
+    return;
+  }
+
+  const uint32_t room = telemetry_text_room();
+  const uint32_t left = s_trace_len - s_trace_sent;
+  const uint32_t chunk = left < room ? left : room;
+  telemetry_send_text(&s_trace_text[s_trace_sent], chunk);
+  s_trace_sent += chunk;
+}
+
+static void config_task(uint32_t late_ms, void* context) {
+  (void) late_ms;
+  (void) context;
+
+  if (config_store_next_is_erase() && s_idle.state == IdleActive) return;
+  config_store_task();
+}
+
+static void note_activity(void) {
+  if (s_idle.state != IdleActive) {
+    s_wake_us = time_us_32();
+    s_wake_pending = true;
+  }
+  idle_activity(&s_idle, board_millis());
+}
+
+// Invoked when the host resumes the bus or configures the device
+void tud_resume_cb(void) {
+  note_activity();
+}
+
+void tud_mount_cb(void) {
+  note_activity();
+}
+
+// A host that went away holds no keys, so queued macros are dropped.
+void tud_umount_cb(void) {
+  macro_reset();
+  s_sent_key = 0;
+}
+
+static void power_task(uint32_t wait_ms) {
+  // Dormant only on battery: a host that is plugged in needs a device that
+  // answers, mounted or not yet.
+  const bool dormant_allowed = !tud_mounted() && !idle_vbus_present();
+  const idle_state_t state = idle_next(&s_idle, board_millis(), dormant_allowed);
+
+  if (state == IdleDormant) {
+    // Without a host only the push button, or VBUS rising, brings the
+    // device back.
+    idle_dormant_until(0, 1u << INPUT_PUSH_BUTTON_GPIO);
+    s_power_state = IdleActive;
+    note_activity();
+    return;
+  }
+
+  if (state != s_power_state) {
+    idle_set_clock(state);
+    s_power_state = state;
+  }
+
+  // Slow mode also stops spinning: sleep until an interrupt or the next
+  // scheduled task.
+  if (state == IdleSlow && wait_ms > 0)
+    best_effort_wfe_or_timeout(make_timeout_time_ms(wait_ms));
+}
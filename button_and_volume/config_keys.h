@@ -0,0 +1,28 @@
+#ifndef CONFIG_KEYS_H_
+#define CONFIG_KEYS_H_
+
+// Settings kept in the config store, set from the host over telemetry.
+// Missing keys fall back to the compile-time defaults.
+enum ConfigKey {
+  ConfigBoardButtonKey = 1,   // HID keycode of the on-board button
+  ConfigErrorKey,             // HID keycode sent while the ADC reports errors
+  ConfigFilterIirShift,       // Applied at boot
+  ConfigFilterHysteresis,     // Applied at boot
+  ConfigKnobReport,           // enum KnobReport
+  ConfigGamepadButtons,       // 1: buttons are also gamepad buttons 0 and 1
+  // Macro numbers (macro_table.c) per input, 0 keeps the input's own key.
+  // Same order as macro_trigger_t.
+  ConfigMacroPushButton,
+  ConfigMacroBoardButton,
+  ConfigMacroKnobUp,
+  ConfigMacroKnobDown,
+};
+
+// Where the knob is reported besides the vendor-defined level.
+enum KnobReport {
+  KnobReportLevelOnly = 0,
+  KnobReportGamepadX,         // Gamepad X axis, -127 to 127
+  KnobReportMouseWheel,       // Wheel steps, one per level
+};
+
+#endif /* CONFIG_KEYS_H_ */
@@ -0,0 +1,178 @@
+#include "hid_benchmark.h"
+#include "adc_sampler.h"
+#include "input.h"
+#include "usb_descriptors.h"
+#include "volume_filter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "tusb.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+typedef struct {
+  uint32_t start_us;
+  uint32_t reports[REPORT_ID_COUNT];
+  uint32_t edges;
+  uint32_t missed;
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint32_t hist[HID_BENCHMARK_BUCKETS];
+} window_t;
+
+static window_t s_window;
+static volatile uint32_t s_edge_us = 0;
+static volatile bool s_edge_pending = false;
+static bool s_pressed = false;
+
+// Best of several runs, in cycles per 100 samples.
+static uint32_t s_scalar_mean_cycles = 0;
+static uint32_t s_block_mean_cycles = 0;
+
+static void window_start(void) {
+  memset(&s_window, 0, sizeof(s_window));
+  s_window.min_us = UINT32_MAX;
+  s_window.start_us = time_us_32();
+}
+
+// Returning a positive delay reschedules relative to the previous target
+// time, so the edges keep their period however late the callback runs.
+static int64_t on_alarm(alarm_id_t id, void* user_data) {
+  (void) id;
+  (void) user_data;
+
+  if (s_pressed) {
+    gpio_set_inover(INPUT_PUSH_BUTTON_GPIO, GPIO_OVERRIDE_NORMAL);
+    s_pressed = false;
+    return HID_BENCHMARK_PERIOD_US - HID_BENCHMARK_HOLD_US;
+  }
+
+  // An edge still waiting for its report never got one.
+  if (s_edge_pending) s_window.missed++;
+  s_window.edges++;
+  s_edge_us = time_us_32();
+  s_edge_pending = true;
+  gpio_set_inover(INPUT_PUSH_BUTTON_GPIO, GPIO_OVERRIDE_LOW);  // Active low
+  s_pressed = true;
+  return HID_BENCHMARK_HOLD_US;
+}
+
+// The block mean before it took two samples per word.
+static bool __attribute__((noinline)) scalar_block_mean(uint16_t const* samples, uint32_t count, uint16_t* mean) {
+  uint32_t sum = 0;
+  uint32_t valid = 0;
+  for (uint32_t index = 0; index < count; ++index) {
+    const uint16_t sample = samples[index];
+    if (sample & 0x8000) continue;
+    sum += sample;
+    valid++;
+  }
+  if (valid == 0) return false;
+
+  *mean = (uint16_t)(sum / valid);
+  return true;
+}
+
+typedef bool (*block_mean_t)(uint16_t const* samples, uint32_t count, uint16_t* mean);
+
+static uint32_t time_block_mean(block_mean_t block_mean, uint16_t const* samples) {
+  uint32_t best = UINT32_MAX;
+  for (uint32_t run = 0; run < 8; run++) {
+    uint16_t mean;
+    const uint32_t irq = save_and_disable_interrupts();
+    const uint32_t begin = trace_begin();
+    block_mean(samples, ADC_SAMPLER_RING_SAMPLES, &mean);
+    const uint32_t cycles = (begin - trace_begin()) & TRACE_VALUE_MASK;
+    restore_interrupts(irq);
+    if (cycles < best) best = cycles;
+  }
+  return best * 100 / ADC_SAMPLER_RING_SAMPLES;
+}
+
+static void measure_block_mean(void) {
+  static uint16_t samples[ADC_SAMPLER_RING_SAMPLES] __attribute__((aligned(4)));
+  uint32_t noise = 1;
+  for (uint32_t index = 0; index < ADC_SAMPLER_RING_SAMPLES; index++) {
+    noise = noise * 1664525u + 1013904223u;
+    samples[index] = (2048 + (noise >> 26)) | (index % 64 == 0 ? 0x8000 : 0);
+  }
+  s_scalar_mean_cycles = time_block_mean(scalar_block_mean, samples);
+  s_block_mean_cycles = time_block_mean(volume_filter_block_mean, samples);
+}
+
+void hid_benchmark_init(void) {
+  measure_block_mean();
+  window_start();
+  add_alarm_in_us(HID_BENCHMARK_PERIOD_US, on_alarm, NULL, true);
+}
+
+void hid_benchmark_report_complete(uint8_t const* report, uint16_t len) {
+  const uint32_t now_us = time_us_32();
+  if (len < 1 || report[0] >= REPORT_ID_COUNT) return;
+  s_window.reports[report[0]]++;
+
+  // Only the press of play/pause answers an edge.
+  if (report[0] != REPORT_ID_CONSUMER_CONTROL || len < 3) return;
+  const uint16_t usage = report[1] | report[2] << 8;
+  if (usage != HID_USAGE_CONSUMER_PLAY_PAUSE || !s_edge_pending) return;
+  s_edge_pending = false;
+
+  const uint32_t latency_us = now_us - s_edge_us;
+  uint32_t bucket = latency_us / HID_BENCHMARK_BUCKET_US;
+  if (bucket >= HID_BENCHMARK_BUCKETS) bucket = HID_BENCHMARK_BUCKETS - 1;
+  s_window.hist[bucket]++;
+  s_window.count++;
+  s_window.sum_us += latency_us;
+  if (latency_us < s_window.min_us) s_window.min_us = latency_us;
+  if (latency_us > s_window.max_us) s_window.max_us = latency_us;
+}
+
+void hid_benchmark_report(trace_write_t write, void* context) {
+  // The alarm also touches the window; take a consistent copy.
+  const uint32_t irq = save_and_disable_interrupts();
+  const window_t window = s_window;
+  window_start();
+  restore_interrupts(irq);
+
+  const uint32_t elapsed_us = s_window.start_us - window.start_us;
+  uint32_t reports = 0;
+  for (uint32_t id = 0; id < REPORT_ID_COUNT; id++)
+    reports += window.reports[id];
+
+  char line[160];
+  int len = snprintf(line, sizeof(line), "bench window_ms=%lu reports=%lu edges=%lu missed=%lu\r\n",
+                     (unsigned long)(elapsed_us / 1000), (unsigned long)reports,
+                     (unsigned long)window.edges, (unsigned long)window.missed);
+  if (len > 0) write(line, (uint32_t)len, context);
+
+  len = snprintf(line, sizeof(line), "bench ids kbd=%lu mouse=%lu consumer=%lu gamepad=%lu level=%lu\r\n",
+                 (unsigned long)window.reports[REPORT_ID_KEYBOARD], (unsigned long)window.reports[REPORT_ID_MOUSE],
+                 (unsigned long)window.reports[REPORT_ID_CONSUMER_CONTROL],
+                 (unsigned long)window.reports[REPORT_ID_GAMEPAD],
+                 (unsigned long)window.reports[REPORT_ID_VOLUME_LEVEL]);
+  if (len > 0) write(line, (uint32_t)len, context);
+
+  len = snprintf(line, sizeof(line), "bench block_mean cycles_per_sample scalar=%lu.%02lu words=%lu.%02lu\r\n",
+                 (unsigned long)(s_scalar_mean_cycles / 100), (unsigned long)(s_scalar_mean_cycles % 100),
+                 (unsigned long)(s_block_mean_cycles / 100), (unsigned long)(s_block_mean_cycles % 100));
+  if (len > 0) write(line, (uint32_t)len, context);
+
+  if (window.count == 0) return;
+  len = snprintf(line, sizeof(line), "bench latency n=%lu min=%lu mean=%lu max=%lu\r\n",
+                 (unsigned long)window.count, (unsigned long)window.min_us,
+                 (unsigned long)(window.sum_us / window.count), (unsigned long)window.max_us);
+  if (len > 0) write(line, (uint32_t)len, context);
+
+  len = snprintf(line, sizeof(line), "bench hist bucket_us=%u", HID_BENCHMARK_BUCKET_US);
+  for (uint32_t bucket = 0; bucket < HID_BENCHMARK_BUCKETS && len > 0 && len < (int)sizeof(line); bucket++)
+    len += snprintf(line + len, sizeof(line) - len, " %lu", (unsigned long)window.hist[bucket]);
+  if (len > 0 && len < (int)sizeof(line) - 2) {
+    line[len++] = '\r';
+    line[len++] = '\n';
+    write(line, (uint32_t)len, context);
+  }
+}
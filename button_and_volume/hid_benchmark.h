@@ -0,0 +1,34 @@
+#ifndef HID_BENCHMARK_H_
+#define HID_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include "trace.h"
+
+// Report-rate and latency benchmark (BUTTON_AND_VOLUME_HID_BENCHMARK builds).
+//
+// An alarm presses the push button every HID_BENCHMARK_PERIOD_US by forcing
+// the pin's input low, so the edge goes through the normal sampling path. As
+// the period is not a multiple of the 10 ms input tick, the edges sweep
+// across it. The time from each edge to the completion of its play/pause
+// report is collected into a histogram, and every completed report is
+// counted for the throughput.
+//
+// At startup it also times volume_filter_block_mean() against the plain
+// per-sample loop it replaced, over one ring of synthetic ADC samples.
+
+#define HID_BENCHMARK_PERIOD_US   (601000)  // Longer than the play/pause hold-off
+#define HID_BENCHMARK_HOLD_US     (50000)
+#define HID_BENCHMARK_BUCKET_US   (1000)
+#define HID_BENCHMARK_BUCKETS     (16)      // The last one takes everything longer
+
+void hid_benchmark_init(void);
+
+// Call from tud_hid_report_complete_cb.
+void hid_benchmark_report_complete(uint8_t const* report, uint16_t len);
+
+// Writes the statistics since the previous call as "bench" text lines and
+// starts a new window.
+void hid_benchmark_report(trace_write_t write, void* context);
+
+#endif /* HID_BENCHMARK_H_ */
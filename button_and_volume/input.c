@@ -0,0 +1,170 @@
+#include "input.h"
+#include "adc_sampler.h"
+#include "volume_filter.h"
+#include "config_keys.h"
+#include "config_store.h"
+
+#include "bsp/board.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+
+#if BUTTON_AND_VOLUME_MULTICORE
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/time.h"
+#endif
+
+#define ADC_INDEX (0)
+
+static const uint32_t PushButtonGPIO = INPUT_PUSH_BUTTON_GPIO;
+static const uint32_t VolumeGPIO = 26 + ADC_INDEX;
+
+static volume_filter_t s_volume_filter;
+
+void input_init(void) {
+  gpio_init(PushButtonGPIO);
+  gpio_set_dir(PushButtonGPIO, GPIO_IN);
+  gpio_pull_up(PushButtonGPIO);
+
+  adc_init();
+  adc_gpio_init(VolumeGPIO);
+  adc_set_clkdiv(1088.44 - 1.0);
+  adc_select_input(ADC_INDEX);
+  adc_set_round_robin(0x0);
+  adc_sampler_init();
+
+  volume_filter_init(&s_volume_filter);
+  volume_filter_configure(&s_volume_filter,
+                          config_store_get_or(ConfigFilterIirShift, VOLUME_FILTER_IIR_SHIFT),
+                          config_store_get_or(ConfigFilterHysteresis, VOLUME_FILTER_HYSTERESIS));
+}
+
+// Push button and knob only. The on-board (BOOTSEL) button is read through
+// the flash chip select, so it must stay on the core that runs from flash
+// and is read in input_read().
+static void input_sample(input_state_t* state) {
+  static bool prev_pushed = false;
+
+  // The push button is active low; only the press edge counts.
+  const bool pushed = !gpio_get(PushButtonGPIO);
+  state->push_edge = pushed && !prev_pushed;
+  state->push_held = pushed;
+  prev_pushed = pushed;
+
+  uint16_t adc_mean;
+  state->level_valid = adc_sampler_read_mean(&adc_mean);
+  if (state->level_valid)
+    state->level = volume_filter_update(&s_volume_filter, adc_mean);
+}
+
+#if BUTTON_AND_VOLUME_MULTICORE
+
+// Events are packed as (type << 8) | value.
+enum InputEventType {
+  InputLevel = 1,
+  InputLevelError,
+  InputPushEdge,
+  InputPushHeld,        // Value 1 on press, 0 on release
+};
+
+#define EVENT_QUEUE_DEPTH (32)
+
+// Single-producer (core 1) / single-consumer (core 0) ring in shared SRAM.
+static uint32_t s_events[EVENT_QUEUE_DEPTH];
+static volatile uint32_t s_event_head = 0;
+static volatile uint32_t s_event_tail = 0;
+static uint32_t s_core1_interval_ms = 10;
+
+static bool event_push(uint32_t event) {
+  const uint32_t head = s_event_head;
+  if (head - s_event_tail == EVENT_QUEUE_DEPTH) return false;
+  s_events[head % EVENT_QUEUE_DEPTH] = event;
+  __dmb(); // Publish the slot before the index
+  s_event_head = head + 1;
+  return true;
+}
+
+static bool event_pop(uint32_t* event) {
+  const uint32_t tail = s_event_tail;
+  if (tail == s_event_head) return false;
+  __dmb(); // Read the slot after seeing the index
+  *event = s_events[tail % EVENT_QUEUE_DEPTH];
+  __dmb();
+  s_event_tail = tail + 1;
+  return true;
+}
+
+static void core1_main(void) {
+  input_state_t sent = {0};
+  bool has_sent = false;
+  bool edge_pending = false;
+  absolute_time_t next_time = get_absolute_time();
+
+  // Core 0 parks this core while it writes the config store.
+  multicore_lockout_victim_init();
+
+  while (1) {
+    input_state_t state;
+    input_sample(&state);
+    edge_pending |= state.push_edge;
+
+    // Only changes cross cores; a full queue retries on the next tick.
+    if (edge_pending && event_push(InputPushEdge << 8))
+      edge_pending = false;
+    if ((!has_sent || state.push_held != sent.push_held) && event_push(InputPushHeld << 8 | state.push_held))
+      sent.push_held = state.push_held;
+    if (!has_sent || state.level_valid != sent.level_valid || (state.level_valid && state.level != sent.level)) {
+      const uint32_t event = state.level_valid ? (InputLevel << 8 | state.level) : (InputLevelError << 8);
+      if (event_push(event)) {
+        sent.level_valid = state.level_valid;
+        sent.level = state.level;
+      }
+    }
+    has_sent = true;
+
+    // Fixed cadence that does not drift with the sampling time.
+    next_time = delayed_by_ms(next_time, s_core1_interval_ms);
+    sleep_until(next_time);
+  }
+}
+
+void input_launch_core1(uint32_t interval_ms) {
+  s_core1_interval_ms = interval_ms;
+  multicore_launch_core1(core1_main);
+}
+
+void input_read(input_state_t* state) {
+  static input_state_t current = {0};
+
+  current.push_edge = false;
+  uint32_t event;
+  while (event_pop(&event)) {
+    const uint8_t value = event & 0xff;
+    switch (event >> 8) {
+    case InputLevel:
+      current.level = value;
+      current.level_valid = true;
+      break;
+    case InputLevelError:
+      current.level_valid = false;
+      break;
+    case InputPushEdge:
+      current.push_edge = true;
+      break;
+    case InputPushHeld:
+      current.push_held = value;
+      break;
+    }
+  }
+  *state = current;
+  state->board_button = board_button_read();
+}
+
+#else
+
+void input_read(input_state_t* state) {
+  input_sample(state);
+  state->board_button = board_button_read();
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Runs input sampling on core 1 when set by the build (see CMakeLists.txt).
+#ifndef BUTTON_AND_VOLUME_MULTICORE
+#define BUTTON_AND_VOLUME_MULTICORE (0)
+#endif
+
+typedef struct {
+  uint8_t level;        // Filtered knob level, 0 to VOLUME_FILTER_LEVEL_MAX
+  bool level_valid;     // false while the ADC reports errors
+  bool board_button;    // On-board button held
+  bool push_edge;       // Push button was pressed since the last read
+  bool push_held;       // Push button is down
+} input_state_t;
+
+// Push button, active low. Also the wake source when dormant.
+#define INPUT_PUSH_BUTTON_GPIO (16)
+
+// Configures the push button GPIO, the ADC and its DMA sampler. The config
+// store must be loaded first.
+void input_init(void);
+
+#if BUTTON_AND_VOLUME_MULTICORE
+// Samples the inputs on core 1 every interval_ms and forwards changes to
+// core 0 through a shared-memory queue.
+void input_launch_core1(uint32_t interval_ms);
+#endif
+
+// Latest input state. In single-core builds this samples the hardware, in
+// multicore builds it only applies the changes queued by core 1.
+void input_read(input_state_t* state);
+
+#endif /* INPUT_H_ */
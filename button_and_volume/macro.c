@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "tusb.h"
+#include "macro.h"
+
+static macro_t const* s_queue[MACRO_QUEUE_DEPTH];
+static uint32_t s_head = 0;
+static uint32_t s_tail = 0;
+
+static uint16_t s_step = 0;       // Next chord of the head macro
+static macro_chord_t s_held;      // Keys the host sees as down
+
+static uint32_t s_started = 0;
+static uint32_t s_dropped = 0;
+static uint32_t s_reports = 0;
+static uint32_t s_releases = 0;   // Inserted between chords sharing a key
+
+static const macro_chord_t ReleaseAll = {0};
+
+void macro_init(void) {
+  macro_reset();
+  s_started = 0;
+  s_dropped = 0;
+  s_reports = 0;
+  s_releases = 0;
+}
+
+void macro_reset(void) {
+  s_head = 0;
+  s_tail = 0;
+  s_step = 0;
+  memset(&s_held, 0, sizeof(s_held));
+}
+
+bool macro_active(void) {
+  return s_head != s_tail;
+}
+
+bool macro_start(macro_t const* macro) {
+  if (macro == NULL || macro->count == 0) return false;
+  if (s_tail - s_head == MACRO_QUEUE_DEPTH) {
+    s_dropped++;
+    return false;
+  }
+  s_queue[s_tail % MACRO_QUEUE_DEPTH] = macro;
+  s_tail++;
+  s_started++;
+  return true;
+}
+
+static bool has_keys(macro_chord_t const* chord) {
+  for (uint32_t i = 0; i < MACRO_MAX_KEYS; i++)
+    if (chord->keycode[i]) return true;
+  return false;
+}
+
+// A key that stays down across two reports is one press to the host, so a
+// repeated key needs the keys released in between. Modifiers held on into
+// the next chord are fine unless that chord is the same modifiers alone.
+static bool needs_release(macro_chord_t const* next) {
+  for (uint32_t i = 0; i < MACRO_MAX_KEYS; i++) {
+    if (!next->keycode[i]) continue;
+    for (uint32_t j = 0; j < MACRO_MAX_KEYS; j++)
+      if (s_held.keycode[j] == next->keycode[i]) return true;
+  }
+  return !has_keys(next) && (next->modifier & s_held.modifier);
+}
+
+// The report the head macro sends next.
+static macro_chord_t const* next_chord(void) {
+  macro_t const* macro = s_queue[s_head % MACRO_QUEUE_DEPTH];
+  if (s_step >= macro->count) return &ReleaseAll;
+
+  macro_chord_t const* chord = &macro->chords[s_step];
+  return needs_release(chord) ? &ReleaseAll : chord;
+}
+
+bool macro_send_next(uint8_t report_id) {
+  if (!macro_active() || !tud_hid_ready()) return false;
+
+  macro_chord_t const* chord = next_chord();
+  if (!tud_hid_keyboard_report(report_id, chord->modifier, chord->keycode)) return false;
+
+  s_reports++;
+  macro_t const* macro = s_queue[s_head % MACRO_QUEUE_DEPTH];
+  if (chord != &ReleaseAll) {
+    s_step++;
+  } else if (s_step < macro->count) {
+    s_releases++;
+  } else {
+    s_head++; // Done, and nothing is left down for the next one
+    s_step = 0;
+  }
+  s_held = *chord;
+  return true;
+}
+
+void macro_report(trace_write_t write, void* context) {
+  char line[80];
+  const int len = snprintf(line, sizeof(line), "macro started=%lu dropped=%lu reports=%lu releases=%lu\r\n",
+                           (unsigned long)s_started, (unsigned long)s_dropped,
+                           (unsigned long)s_reports, (unsigned long)s_releases);
+  if (len > 0) write(line, (uint32_t)len, context);
+}
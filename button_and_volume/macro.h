@@ -0,0 +1,66 @@
+#ifndef MACRO_H_
+#define MACRO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "trace.h"
+
+// Keystroke macros sent on the keyboard report.
+//
+// A macro is a sequence of chords, each a modifier byte and up to six
+// keycodes pressed together. Every keyboard report carries one step, and
+// the caller sends the next report only when the endpoint took the previous
+// one, so a macro runs at one report per poll interval with no timers.
+// Going from one chord straight to the next releases the keys that are not
+// in it, so a release report is only inserted when the next chord repeats a
+// key that is still down. Every macro ends with all keys released, and a
+// macro that is started while another runs waits for it.
+
+#define MACRO_QUEUE_DEPTH (4)
+#define MACRO_MAX_KEYS    (6)
+
+typedef struct {
+  uint8_t modifier;                 // KEYBOARD_MODIFIER_* bits
+  uint8_t keycode[MACRO_MAX_KEYS];  // HID_KEY_*, unused slots are 0
+} macro_chord_t;
+
+typedef struct {
+  const char* name;
+  macro_chord_t const* chords;
+  uint16_t count;
+} macro_t;
+
+// Inputs that can start a macro. Bound through consecutive config keys
+// from ConfigMacroPushButton on.
+typedef enum {
+  MacroTriggerPushButton = 0,
+  MacroTriggerBoardButton,
+  MacroTriggerKnobUp,       // Fast turn towards higher levels
+  MacroTriggerKnobDown,     // Fast turn towards lower levels
+  MacroTriggerCount,
+} macro_trigger_t;
+
+// Built-in macros (macro_table.c); number 0 means no macro.
+macro_t const* macro_table_get(uint32_t number);
+
+void macro_init(void);
+
+// Queues the macro. Returns false and counts a drop when the queue is full.
+bool macro_start(macro_t const* macro);
+
+// true while a macro still has reports to send, including the last release.
+bool macro_active(void);
+
+// Sends the next step on report_id if the endpoint is free. Returns true
+// when a report was handed to TinyUSB.
+bool macro_send_next(uint8_t report_id);
+
+// Forget everything queued, e.g. when the host went away and no longer
+// holds any keys.
+void macro_reset(void);
+
+// Writes a "macro" text line with the counters since boot.
+void macro_report(trace_write_t write, void* context);
+
+#endif /* MACRO_H_ */
@@ -0,0 +1,61 @@
+#include "tusb.h"
+#include "macro.h"
+
+// Built-in macros, bound to inputs with set_config.py: the value of
+// ConfigMacroPushButton and the following keys is the number below.
+// Chords list the keys pressed together; a modifier-only or empty chord is
+// also a step.
+
+#define CHORD(mod, ...) { (mod), { __VA_ARGS__ } }
+#define MACRO(name, chords) { (name), (chords), sizeof(chords) / sizeof((chords)[0]) }
+
+static const macro_chord_t Copy[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C),
+};
+
+static const macro_chord_t Paste[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_V),
+};
+
+static const macro_chord_t Undo[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_Z),
+};
+
+static const macro_chord_t LockScreen[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTGUI, HID_KEY_L),
+};
+
+static const macro_chord_t Terminal[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL | KEYBOARD_MODIFIER_LEFTALT, HID_KEY_T),
+};
+
+// Selects the current line and copies it.
+static const macro_chord_t CopyLine[] = {
+  CHORD(0, HID_KEY_HOME),
+  CHORD(KEYBOARD_MODIFIER_LEFTSHIFT, HID_KEY_END),
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C),
+};
+
+static const macro_chord_t Hello[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTSHIFT, HID_KEY_H),
+  CHORD(0, HID_KEY_E),
+  CHORD(0, HID_KEY_L),
+  CHORD(0, HID_KEY_L),
+  CHORD(0, HID_KEY_O),
+  CHORD(0, HID_KEY_ENTER),
+};
+
+static const macro_t Macros[] = {
+  MACRO("copy", Copy),              // 1
+  MACRO("paste", Paste),            // 2
+  MACRO("undo", Undo),              // 3
+  MACRO("lock_screen", LockScreen), // 4
+  MACRO("terminal", Terminal),      // 5
+  MACRO("copy_line", CopyLine),     // 6
+  MACRO("hello", Hello),            // 7
+};
+
+macro_t const* macro_table_get(uint32_t number) {
+  if (number == 0 || number > sizeof(Macros) / sizeof(Macros[0])) return NULL;
+  return &Macros[number - 1];
+}
@@ -0,0 +1,61 @@
+#include <string.h>
+
+#include "bsp/board.h"
+#include "report_queue.h"
+
+typedef struct {
+  uint32_t due_ms;
+  uint8_t report_id;
+  uint8_t len;
+  uint8_t data[REPORT_QUEUE_PAYLOAD_SIZE];
+} queued_report_t;
+
+static queued_report_t s_reports[REPORT_QUEUE_DEPTH];
+static uint32_t s_head = 0;
+static uint32_t s_tail = 0;
+
+void report_queue_init(void) {
+  s_head = 0;
+  s_tail = 0;
+}
+
+bool report_queue_empty(void) {
+  return s_head == s_tail;
+}
+
+uint32_t report_queue_free(void) {
+  return REPORT_QUEUE_DEPTH - (s_tail - s_head);
+}
+
+bool report_queue_push(uint8_t report_id, void const* data, uint8_t len, uint32_t due_ms) {
+  if (len > REPORT_QUEUE_PAYLOAD_SIZE || report_queue_free() == 0) return false;
+
+  queued_report_t* report = &s_reports[s_tail % REPORT_QUEUE_DEPTH];
+  report->due_ms = due_ms;
+  report->report_id = report_id;
+  report->len = len;
+  memcpy(report->data, data, len);
+  s_tail++;
+  return true;
+}
+
+bool report_queue_push_tap(uint8_t report_id, void const* press, void const* release, uint8_t len, uint32_t hold_ms) {
+  // Both halves must fit, otherwise the key would stay pressed on the host.
+  if (report_queue_free() < 2) return false;
+
+  const uint32_t now_ms = board_millis();
+  report_queue_push(report_id, press, len, now_ms);
+  report_queue_push(report_id, release, len, now_ms + hold_ms);
+  return true;
+}
+
+bool report_queue_send_next(void) {
+  if (report_queue_empty() || !tud_hid_ready()) return false;
+
+  queued_report_t const* report = &s_reports[s_head % REPORT_QUEUE_DEPTH];
+  if ((int32_t)(board_millis() - report->due_ms) < 0) return false;
+
+  if (!tud_hid_report(report->report_id, report->data, report->len)) return false;
+  s_head++;
+  return true;
+}
@@ -0,0 +1,33 @@
+#ifndef REPORT_QUEUE_H_
+#define REPORT_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tusb.h"
+
+// Largest report payload, excluding the report ID byte.
+#define REPORT_QUEUE_PAYLOAD_SIZE (CFG_TUD_HID_EP_BUFSIZE - 1)
+#define REPORT_QUEUE_DEPTH (32)
+
+// FIFO of HID reports, each with the earliest time it may be sent.
+// Reports leave one at a time, from tud_hid_report_complete_cb or from the
+// main loop when the endpoint is idle, so at most one report goes out per
+// poll interval and nothing ever waits.
+void report_queue_init(void);
+
+// Queue a report to be sent no earlier than due_ms.
+// Returns false when the queue is full.
+bool report_queue_push(uint8_t report_id, void const* data, uint8_t len, uint32_t due_ms);
+
+// Queue a press report now and the matching release hold_ms later.
+bool report_queue_push_tap(uint8_t report_id, void const* press, void const* release, uint8_t len, uint32_t hold_ms);
+
+// Send the head report if it is due and the endpoint is free.
+// Returns true when a report was handed to TinyUSB.
+bool report_queue_send_next(void);
+
+bool report_queue_empty(void);
+uint32_t report_queue_free(void);
+
+#endif /* REPORT_QUEUE_H_ */
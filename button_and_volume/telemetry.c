@@ -0,0 +1,235 @@
+#include <string.h>
+
+#include "telemetry.h"
+#include "adc_sampler.h"
+#include "config_store.h"
+#include "trace.h"
+
+#include "bsp/board.h"
+#include "tusb.h"
+
+#define ADC_SAMPLES_PER_FRAME ((TELEMETRY_MAX_PAYLOAD - 5) / 2)
+
+// A partly filled packet is sent after this long.
+static const uint32_t FlushMs = 5;
+// The host writes a frame at once, so a partial one that waited this long
+// started at a stray SYNC.
+static const uint32_t RxTimeoutMs = 20;
+
+static uint8_t s_packet[TELEMETRY_PACKET_SIZE];
+static uint32_t s_packet_len = 0;
+static uint32_t s_packet_start_ms = 0;
+static uint32_t s_dropped_packets = 0;
+
+static uint8_t s_rx[TELEMETRY_PACKET_SIZE];
+static uint32_t s_rx_len = 0;
+static uint32_t s_rx_ms = 0;
+
+static uint8_t s_streams = TelemetryStreamInput | TelemetryStreamTrace;
+static uint8_t s_adc_step = 4;
+static uint32_t s_adc_cursor = 0;
+
+static void put_u32(uint8_t* data, uint32_t value) {
+  data[0] = value & 0xff;
+  data[1] = (value >> 8) & 0xff;
+  data[2] = (value >> 16) & 0xff;
+  data[3] = value >> 24;
+}
+
+static uint8_t checksum(const uint8_t* data, uint32_t len) {
+  uint8_t sum = 0;
+  for (uint32_t i = 0; i < len; i++)
+    sum += data[i];
+  return (uint8_t)(0 - sum);
+}
+
+static void flush_packet(void) {
+  if (s_packet_len == 0) return;
+
+  if (tud_cdc_write_available() >= s_packet_len) {
+    tud_cdc_write(s_packet, s_packet_len);
+    tud_cdc_write_flush();
+  } else {
+    s_dropped_packets++;
+  }
+  s_packet_len = 0;
+}
+
+static void send_frame(uint8_t type, const uint8_t* payload, uint32_t len) {
+  if (!tud_cdc_connected() || len > TELEMETRY_MAX_PAYLOAD) return;
+
+  if (s_packet_len + len + TELEMETRY_FRAME_OVERHEAD > sizeof(s_packet))
+    flush_packet();
+  if (s_packet_len == 0)
+    s_packet_start_ms = board_millis();
+
+  uint8_t* frame = &s_packet[s_packet_len];
+  frame[0] = TELEMETRY_SYNC;
+  frame[1] = type;
+  frame[2] = len;
+  memcpy(&frame[3], payload, len);
+  frame[3 + len] = checksum(&frame[1], len + 2);
+  s_packet_len += len + TELEMETRY_FRAME_OVERHEAD;
+
+  if (s_packet_len == sizeof(s_packet))
+    flush_packet();
+}
+
+static void send_config(void) {
+  uint8_t payload[6] = {s_streams, s_adc_step};
+  put_u32(&payload[2], s_dropped_packets);
+  send_frame(TelemetryConfig, payload, sizeof(payload));
+}
+
+static void send_setting(uint16_t key) {
+  uint32_t value;
+  if (!config_store_get(key, &value)) return;
+  uint8_t payload[6] = {key & 0xff, key >> 8};
+  put_u32(&payload[2], value);
+  send_frame(TelemetrySetting, payload, sizeof(payload));
+}
+
+static void handle_command(uint8_t type, const uint8_t* payload, uint32_t len) {
+  switch (type) {
+  case TelemetryConfig:
+    if (len >= 2) {
+      if ((payload[0] & TelemetryStreamAdc) && !(s_streams & TelemetryStreamAdc))
+        s_adc_cursor = 0;  // Start from the oldest sample in the ring
+      s_streams = payload[0];
+      s_adc_step = payload[1] ? payload[1] : 1;
+    }
+    send_config();
+    break;
+  case TelemetryResetTrace:
+    trace_reset();
+    break;
+  case TelemetrySetting:
+    if (len >= 2) {
+      const uint16_t key = payload[0] | payload[1] << 8;
+      if (len >= 6)
+        config_store_set(key, payload[2] | payload[3] << 8 | payload[4] << 16 | (uint32_t)payload[5] << 24);
+      send_setting(key);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+// Length of the frame that starts at data[0], 0 while more bytes are
+// needed, or -1 if the length or checksum show it is not a frame.
+static int32_t frame_length(const uint8_t* data, uint32_t len) {
+  if (len < 3) return 0;
+  const uint32_t frame_len = data[2] + TELEMETRY_FRAME_OVERHEAD;
+  if (frame_len > sizeof(s_rx)) return -1;
+  if (len < frame_len) return 0;
+  return checksum(&data[1], data[2] + 2) == data[frame_len - 1] ? (int32_t)frame_len : -1;
+}
+
+// Handles the complete frames in s_rx. A stray SYNC or a corrupted length
+// can swallow the start of the next frame, so a bad frame, or with
+// drop_partial the partial one at the start, only loses its SYNC and the
+// bytes after it are scanned again from the next one.
+static void scan_rx(bool drop_partial) {
+  uint32_t start = 0;
+  while (start < s_rx_len) {
+    const int32_t frame_len = frame_length(&s_rx[start], s_rx_len - start);
+    if (frame_len == 0 && !drop_partial) break;
+    drop_partial = false;
+    if (frame_len > 0) {
+      handle_command(s_rx[start + 1], &s_rx[start + 3], s_rx[start + 2]);
+      start += frame_len;
+    } else {
+      start++;
+    }
+    while (start < s_rx_len && s_rx[start] != TELEMETRY_SYNC)
+      start++;
+  }
+  s_rx_len -= start;
+  memmove(s_rx, &s_rx[start], s_rx_len);
+}
+
+static void receive_byte(uint8_t byte) {
+  if (s_rx_len == 0 && byte != TELEMETRY_SYNC) return;
+  s_rx[s_rx_len++] = byte;
+  s_rx_ms = board_millis();
+  scan_rx(false);
+}
+
+static void stream_adc(void) {
+  // Wait for a full frame of samples.
+  uint8_t payload[5 + ADC_SAMPLES_PER_FRAME * 2];
+  uint16_t samples[ADC_SAMPLES_PER_FRAME];
+  uint32_t first;
+  uint32_t cursor = s_adc_cursor;
+  const uint32_t count = adc_sampler_copy(&cursor, &first, samples, ADC_SAMPLES_PER_FRAME, s_adc_step);
+  if (count < ADC_SAMPLES_PER_FRAME) return;
+  s_adc_cursor = cursor;
+
+  put_u32(payload, first);
+  payload[4] = s_adc_step;
+  for (uint32_t i = 0; i < count; i++) {
+    payload[5 + 2 * i] = samples[i] & 0xff;
+    payload[6 + 2 * i] = samples[i] >> 8;
+  }
+  send_frame(TelemetryAdc, payload, sizeof(payload));
+}
+
+void telemetry_init(void) {
+  s_packet_len = 0;
+  s_rx_len = 0;
+}
+
+void telemetry_task(void) {
+  uint8_t buf[TELEMETRY_PACKET_SIZE];
+  const uint32_t count = tud_cdc_available() ? tud_cdc_read(buf, sizeof(buf)) : 0;
+  for (uint32_t i = 0; i < count; i++)
+    receive_byte(buf[i]);
+  if (s_rx_len > 0 && board_millis() - s_rx_ms >= RxTimeoutMs)
+    scan_rx(true);
+
+  if (!tud_cdc_connected()) {
+    s_packet_len = 0;
+    return;
+  }
+
+  if (s_streams & TelemetryStreamAdc)
+    stream_adc();
+
+  if (s_packet_len > 0 && board_millis() - s_packet_start_ms >= FlushMs)
+    flush_packet();
+}
+
+bool telemetry_enabled(uint8_t stream) {
+  return (s_streams & stream) != 0;
+}
+
+void telemetry_send_input(const input_state_t* input) {
+  if (!(s_streams & TelemetryStreamInput)) return;
+
+  uint8_t payload[6];
+  put_u32(payload, board_millis());
+  payload[4] = input->level;
+  payload[5] = (input->level_valid ? TelemetryLevelValid : 0) |
+               (input->board_button ? TelemetryBoardButton : 0) |
+               (input->push_edge ? TelemetryPushEdge : 0);
+  send_frame(TelemetryInput, payload, sizeof(payload));
+}
+
+void telemetry_send_text(const char* text, uint32_t len) {
+  while (len > 0) {
+    const uint32_t chunk = len < TELEMETRY_MAX_PAYLOAD ? len : TELEMETRY_MAX_PAYLOAD;
+    send_frame(TelemetryText, (const uint8_t*)text, chunk);
+    text += chunk;
+    len -= chunk;
+  }
+}
+
+uint32_t telemetry_text_room(void) {
+  if (!tud_cdc_connected()) return 0;
+
+  // Whole packets only: the pending one goes out first, and one stays free.
+  const uint32_t packets = tud_cdc_write_available() / TELEMETRY_PACKET_SIZE;
+  const uint32_t reserved = 1 + (s_packet_len > 0);
+  return packets > reserved ? (packets - reserved) * TELEMETRY_MAX_PAYLOAD : 0;
+}
@@ -0,0 +1,61 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "input.h"
+
+// Binary telemetry and control over the CDC interface.
+//
+// Every frame is SYNC, type, payload length, payload, checksum, where the
+// checksum makes the bytes from type to checksum sum to zero. Multi-byte
+// fields are little endian. Frames are batched into packets of one CDC
+// endpoint size, so high-rate streams cost one USB transfer per 64 bytes.
+// Nothing here waits for the host: a packet that does not fit in the CDC
+// FIFO is dropped and counted. On the way in, a frame with a bad length or
+// checksum is skipped up to the next SYNC, so it never hides the frames the
+// host sent after it.
+
+#define TELEMETRY_SYNC            (0xA5)
+#define TELEMETRY_FRAME_OVERHEAD  (4)
+#define TELEMETRY_PACKET_SIZE     (64)
+#define TELEMETRY_MAX_PAYLOAD     (TELEMETRY_PACKET_SIZE - TELEMETRY_FRAME_OVERHEAD)
+
+enum TelemetryType {
+  TelemetryAdc = 1,   // u32 index of the first sample, u8 step, u16 samples[]
+  TelemetryInput,     // u32 time_ms, u8 level, u8 flags (TelemetryInputFlag)
+  TelemetryText,      // ASCII, e.g. trace statistics lines
+  TelemetryConfig,    // u8 streams, u8 adc_step[, u32 dropped packets from the device]
+  TelemetryResetTrace,// Host to device, no payload
+  TelemetrySetting,   // u16 key[, u32 value to store]; answered with u16 key, u32 value
+};
+
+enum TelemetryInputFlag {
+  TelemetryLevelValid = 1 << 0,
+  TelemetryBoardButton = 1 << 1,
+  TelemetryPushEdge = 1 << 2,
+};
+
+enum TelemetryStream {
+  TelemetryStreamAdc = 1 << 0,
+  TelemetryStreamInput = 1 << 1,
+  TelemetryStreamTrace = 1 << 2,
+};
+
+void telemetry_init(void);
+
+// Handles host commands, streams new ADC samples and sends a partly filled
+// packet once it has waited long enough. Call from the main loop.
+void telemetry_task(void);
+
+bool telemetry_enabled(uint8_t stream);
+
+void telemetry_send_input(const input_state_t* input);
+void telemetry_send_text(const char* text, uint32_t len);
+
+// Text bytes that telemetry_send_text() can take now without a packet being
+// dropped, keeping one packet of the CDC FIFO for the other streams.
+uint32_t telemetry_text_room(void);
+
+#endif /* TELEMETRY_H_ */
@@ -48,9 +48,11 @@ tusb_desc_device_t const desc_device =
     .bLength            = sizeof(tusb_desc_device_t),
     .bDescriptorType    = TUSB_DESC_DEVICE,
     .bcdUSB             = USB_BCD,
-    .bDeviceClass       = 0x00,
-    .bDeviceSubClass    = 0x00,
-    .bDeviceProtocol    = 0x00,
+    // Use Interface Association Descriptor (IAD) for CDC
+    // As required by USB Specs IAD's subclass must be common class (2) and protocol must be IAD (1)
+    .bDeviceClass       = TUSB_CLASS_MISC,
+    .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol    = MISC_PROTOCOL_IAD,
     .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
 
     .idVendor           = USB_VID,
@@ -75,12 +77,28 @@ uint8_t const * tud_descriptor_device_cb(void)
 // HID Report Descriptor
 //--------------------------------------------------------------------+
 
+// Absolute volume level, one byte from 0 to VOLUME_LEVEL_MAX
+#define TUD_HID_REPORT_DESC_VOLUME_LEVEL(...) \
+  HID_USAGE_PAGE_N ( VOLUME_LEVEL_USAGE_PAGE, 2     ),\
+  HID_USAGE        ( VOLUME_LEVEL_USAGE             ),\
+  HID_COLLECTION   ( HID_COLLECTION_APPLICATION     ),\
+    /* Report ID if any */\
+    __VA_ARGS__ \
+    HID_USAGE        ( VOLUME_LEVEL_USAGE           ),\
+    HID_LOGICAL_MIN  ( 0                            ),\
+    HID_LOGICAL_MAX  ( VOLUME_LEVEL_MAX             ),\
+    HID_REPORT_COUNT ( 1                            ),\
+    HID_REPORT_SIZE  ( 8                            ),\
+    HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ),\
+  HID_COLLECTION_END \
+
 uint8_t const desc_hid_report[] =
 {
-  TUD_HID_REPORT_DESC_KEYBOARD( HID_REPORT_ID(REPORT_ID_KEYBOARD         )),
-  TUD_HID_REPORT_DESC_MOUSE   ( HID_REPORT_ID(REPORT_ID_MOUSE            )),
-  TUD_HID_REPORT_DESC_CONSUMER( HID_REPORT_ID(REPORT_ID_CONSUMER_CONTROL )),
-  TUD_HID_REPORT_DESC_GAMEPAD ( HID_REPORT_ID(REPORT_ID_GAMEPAD          ))
+  TUD_HID_REPORT_DESC_KEYBOARD    ( HID_REPORT_ID(REPORT_ID_KEYBOARD         )),
+  TUD_HID_REPORT_DESC_MOUSE       ( HID_REPORT_ID(REPORT_ID_MOUSE            )),
+  TUD_HID_REPORT_DESC_CONSUMER    ( HID_REPORT_ID(REPORT_ID_CONSUMER_CONTROL )),
+  TUD_HID_REPORT_DESC_GAMEPAD     ( HID_REPORT_ID(REPORT_ID_GAMEPAD          )),
+  TUD_HID_REPORT_DESC_VOLUME_LEVEL( HID_REPORT_ID(REPORT_ID_VOLUME_LEVEL     ))
 };
 
 // Invoked when received GET HID REPORT DESCRIPTOR
@@ -99,27 +117,50 @@ uint8_t const * tud_hid_descriptor_report_cb(uint8_t instance)
 enum
 {
   ITF_NUM_HID,
+  ITF_NUM_CDC,
+  ITF_NUM_CDC_DATA,
   ITF_NUM_TOTAL
 };
 
-#define  CONFIG_TOTAL_LEN  (TUD_CONFIG_DESC_LEN + TUD_HID_DESC_LEN)
+#define EPNUM_HID         0x81
+#define EPNUM_CDC_NOTIF   0x82
+#define EPNUM_CDC_OUT     0x03
+#define EPNUM_CDC_IN      0x83
+
+// Every interface of the configuration. A new CDC or vendor interface only
+// needs its interface numbers above and its descriptor here; the total
+// length follows from the list.
+#define CONFIG_INTERFACES \
+  /* Interface number, string index, protocol, report descriptor len, EP In address, size & polling interval */\
+  TUD_HID_DESCRIPTOR(ITF_NUM_HID, 0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_report), EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, 5),\
+  /* Interface number, string index, EP notification address and size, EP data address (out, in) and size. */\
+  TUD_CDC_DESCRIPTOR(ITF_NUM_CDC, 4, EPNUM_CDC_NOTIF, 8, EPNUM_CDC_OUT, EPNUM_CDC_IN, 64)
+
+#define CONFIG_TOTAL_LEN  (TUD_CONFIG_DESC_LEN + sizeof((uint8_t const[]) { CONFIG_INTERFACES }))
 
-#define EPNUM_HID   0x81
+// TUD_CONFIG_DESCRIPTOR with the descriptor type as a parameter, so the
+// other speed configuration is a second constant table.
+#define CONFIG_HEADER(desc_type) \
+  9, desc_type, U16_TO_U8S_LE(CONFIG_TOTAL_LEN), ITF_NUM_TOTAL, 1, 0, \
+  TU_BIT(7) | TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100/2
 
 uint8_t const desc_configuration[] =
 {
-  // Config number, interface count, string index, total length, attribute, power in mA
-  TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100),
-
-  // Interface number, string index, protocol, report descriptor len, EP In address, size & polling interval
-  TUD_HID_DESCRIPTOR(ITF_NUM_HID, 0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_report), EPNUM_HID, CFG_TUD_HID_EP_BUFSIZE, 5)
+  CONFIG_HEADER(TUSB_DESC_CONFIGURATION),
+  CONFIG_INTERFACES
 };
 
+TU_VERIFY_STATIC(sizeof(desc_configuration) == CONFIG_TOTAL_LEN, "Configuration length");
+
 #if TUD_OPT_HIGH_SPEED
 // Per USB specs: high speed capable device must report device_qualifier and other_speed_configuration
 
-// other speed configuration
-uint8_t desc_other_speed_config[CONFIG_TOTAL_LEN];
+// other speed configuration, the same interfaces under another type
+uint8_t const desc_other_speed_config[] =
+{
+  CONFIG_HEADER(TUSB_DESC_OTHER_SPEED_CONFIG),
+  CONFIG_INTERFACES
+};
 
 // device qualifier is mostly similar to device descriptor since we don't change configuration based on speed
 tusb_desc_device_qualifier_t const desc_device_qualifier =
@@ -128,9 +169,9 @@ tusb_desc_device_qualifier_t const desc_device_qualifier =
   .bDescriptorType    = TUSB_DESC_DEVICE_QUALIFIER,
   .bcdUSB             = USB_BCD,
 
-  .bDeviceClass       = 0x00,
-  .bDeviceSubClass    = 0x00,
-  .bDeviceProtocol    = 0x00,
+  .bDeviceClass       = TUSB_CLASS_MISC,
+  .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+  .bDeviceProtocol    = MISC_PROTOCOL_IAD,
 
   .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
   .bNumConfigurations = 0x01,
@@ -152,12 +193,6 @@ uint8_t const* tud_descriptor_device_qualifier_cb(void)
 uint8_t const* tud_descriptor_other_speed_configuration_cb(uint8_t index)
 {
   (void) index; // for multiple configurations
-
-  // other speed config is basically configuration with type = OHER_SPEED_CONFIG
-  memcpy(desc_other_speed_config, desc_configuration, CONFIG_TOTAL_LEN);
-  desc_other_speed_config[1] = TUSB_DESC_OTHER_SPEED_CONFIG;
-
-  // this example use the same configuration for both high and full speed mode
   return desc_other_speed_config;
 }
 
@@ -178,19 +213,44 @@ uint8_t const * tud_descriptor_configuration_cb(uint8_t index)
 // String Descriptors
 //--------------------------------------------------------------------+
 
-// buffer to hold flash ID
-char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+// A complete string descriptor in UTF-16, built by the compiler from a
+// literal. The array takes the characters without the terminating zero.
+#define STRING_DESCRIPTOR(name, text) \
+  static const struct { \
+    uint8_t bLength; \
+    uint8_t bDescriptorType; \
+    uint16_t unicode_string[sizeof(u"" text) / sizeof(uint16_t) - 1]; \
+  } name = { sizeof(name), TUSB_DESC_STRING, u"" text }
+
+STRING_DESCRIPTOR(desc_str_manufacturer, "TinyUSB");
+STRING_DESCRIPTOR(desc_str_product, "TinyUSB Device");
+STRING_DESCRIPTOR(desc_str_cdc, "TinyUSB Telemetry");
+
+// 0: is supported language is English (0x0409)
+static const uint16_t desc_str_language[] = { (TUSB_DESC_STRING << 8) | 4, 0x0409 };
 
-// array of pointer to string descriptors
-char const* string_desc_arr [] =
+// Serial number from the flash ID, filled in once by usb_descriptors_init()
+static uint16_t desc_str_serial[1 + 2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES];
+
+static uint16_t const* const string_desc_arr[] =
 {
-  (const char[]) { 0x09, 0x04 }, // 0: is supported language is English (0x0409)
-  "TinyUSB",                     // 1: Manufacturer
-  "TinyUSB Device",              // 2: Product
-  serial,                        // 3: Serials, uses the flash ID
+  desc_str_language,                                  // 0: Language
+  (uint16_t const*) &desc_str_manufacturer,           // 1: Manufacturer
+  (uint16_t const*) &desc_str_product,                // 2: Product
+  desc_str_serial,                                    // 3: Serials, uses the flash ID
+  (uint16_t const*) &desc_str_cdc,                    // 4: CDC Interface
 };
 
-static uint16_t _desc_str[32];
+void usb_descriptors_init(void)
+{
+  char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+  pico_get_unique_board_id_string(serial, sizeof(serial));
+
+  const uint32_t chr_count = strlen(serial);
+  for (uint32_t i = 0; i < chr_count; i++)
+    desc_str_serial[1 + i] = serial[i];
+  desc_str_serial[0] = (TUSB_DESC_STRING << 8) | (2 * chr_count + 2);
+}
 
 // Invoked when received GET STRING DESCRIPTOR request
 // Application return pointer to descriptor, whose contents must exist long enough for transfer to complete
@@ -198,36 +258,9 @@ uint16_t const* tud_descriptor_string_cb(uint8_t index, uint16_t langid)
 {
   (void) langid;
 
-  uint8_t chr_count;
-
-  if ( index == 0)
-  {
-    memcpy(&_desc_str[1], string_desc_arr[0], 2);
-    chr_count = 1;
-  }else
-  {
-    // Note: the 0xEE index string is a Microsoft OS 1.0 Descriptors.
-    // https://docs.microsoft.com/en-us/windows-hardware/drivers/usbcon/microsoft-defined-usb-descriptors
-
-    if (index == 3) pico_get_unique_board_id_string(serial, sizeof(serial));
-    
-    if ( !(index < sizeof(string_desc_arr)/sizeof(string_desc_arr[0])) ) return NULL;
-
-    const char* str = string_desc_arr[index];
-
-    // Cap at max char
-    chr_count = strlen(str);
-    if ( chr_count > 31 ) chr_count = 31;
-
-    // Convert ASCII string into UTF-16
-    for(uint8_t i=0; i<chr_count; i++)
-    {
-      _desc_str[1+i] = str[i];
-    }
-  }
-
-  // first byte is length (including header), second byte is string type
-  _desc_str[0] = (TUSB_DESC_STRING << 8 ) | (2*chr_count + 2);
+  // Note: the 0xEE index string is a Microsoft OS 1.0 Descriptors.
+  // https://docs.microsoft.com/en-us/windows-hardware/drivers/usbcon/microsoft-defined-usb-descriptors
+  if ( !(index < sizeof(string_desc_arr)/sizeof(string_desc_arr[0])) ) return NULL;
 
-  return _desc_str;
+  return string_desc_arr[index];
 }
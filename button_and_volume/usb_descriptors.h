@@ -31,7 +31,16 @@ enum
   REPORT_ID_MOUSE,
   REPORT_ID_CONSUMER_CONTROL,
   REPORT_ID_GAMEPAD,
+  REPORT_ID_VOLUME_LEVEL,
   REPORT_ID_COUNT
 };
 
+// Vendor-defined usage carrying the absolute knob position (0-100).
+#define VOLUME_LEVEL_USAGE_PAGE  0xFF00
+#define VOLUME_LEVEL_USAGE       0x01
+#define VOLUME_LEVEL_MAX         100
+
+// Reads the board ID into the serial number string. Call before tusb_init().
+void usb_descriptors_init(void);
+
 #endif /* USB_DESCRIPTORS_H_ */
@@ -0,0 +1,147 @@
+#include "volume_filter.h"
+
+#define ADC_ERROR_SHIFT (15)   // Error flag of a FIFO sample
+#define STATE_SHIFT     (16)
+#define LEVEL_COUNT     (VOLUME_FILTER_LEVEL_MAX + 1)
+
+// One count below full scale, which the IIR state can settle short of.
+static const uint32_t TopState = ((1u << VOLUME_FILTER_ADC_BITS) - 2u) << STATE_SHIFT;
+
+#if VOLUME_FILTER_TAPER == VOLUME_FILTER_TAPER_LOG
+
+// Lowest ADC value of each level and the end of the range, from
+// 4096 * ln(1 + level * 99 / 101) / ln(100).
+static const uint16_t LevelBounds[LEVEL_COUNT + 1] = {
+  0, 608, 965, 1220, 1417, 1579, 1716, 1834, 1938, 2032, 2117, 2194,
+  2265, 2331, 2392, 2449, 2503, 2554, 2602, 2648, 2691, 2732, 2772, 2810,
+  2846, 2881, 2914, 2947, 2978, 3008, 3037, 3065, 3093, 3119, 3145, 3170,
+  3194, 3218, 3241, 3264, 3286, 3307, 3328, 3348, 3368, 3388, 3407, 3426,
+  3444, 3462, 3480, 3497, 3514, 3530, 3547, 3563, 3579, 3594, 3609, 3624,
+  3639, 3653, 3668, 3682, 3695, 3709, 3722, 3735, 3748, 3761, 3774, 3786,
+  3799, 3811, 3823, 3834, 3846, 3857, 3869, 3880, 3891, 3902, 3913, 3923,
+  3934, 3944, 3955, 3965, 3975, 3985, 3995, 4004, 4014, 4023, 4033, 4042,
+  4051, 4060, 4069, 4078, 4087, 4096,
+};
+
+static uint32_t level_lower_bound(uint32_t level) {
+  return (uint32_t)LevelBounds[level] << STATE_SHIFT;
+}
+
+// Only runs when the level changes, so a binary search is cheap enough.
+static uint8_t level_of(uint32_t state) {
+  const uint32_t value = state >> STATE_SHIFT;
+  uint32_t low = 0;
+  uint32_t high = LEVEL_COUNT;
+  while (high - low > 1) {
+    const uint32_t middle = (low + high) / 2;
+    if (value >= LevelBounds[middle]) low = middle;
+    else high = middle;
+  }
+  return (uint8_t)low;
+}
+
+#else
+
+// Lowest filtered value (Q16) that still belongs to level.
+static uint32_t level_lower_bound(uint32_t level) {
+  // level << 28 needs more than 32 bits from level 16 on.
+  return (uint32_t)(((uint64_t)level << (VOLUME_FILTER_ADC_BITS + STATE_SHIFT)) / LEVEL_COUNT);
+}
+
+static uint8_t level_of(uint32_t state) {
+  // 4095 * 101 / 4096 rounds down to 100, so every level is reachable.
+  return (uint8_t)(((uint64_t)state * LEVEL_COUNT) >> (VOLUME_FILTER_ADC_BITS + STATE_SHIFT));
+}
+
+#endif
+
+void volume_filter_init(volume_filter_t* filter) {
+  filter->state = 0;
+  filter->level = 0;
+  filter->primed = false;
+  filter->iir_shift = VOLUME_FILTER_IIR_SHIFT;
+  filter->hysteresis = VOLUME_FILTER_HYSTERESIS;
+}
+
+void volume_filter_configure(volume_filter_t* filter, uint8_t iir_shift, uint16_t hysteresis) {
+  // Larger shifts would never move the Q16 state.
+  filter->iir_shift = iir_shift < STATE_SHIFT ? iir_shift : STATE_SHIFT - 1;
+  filter->hysteresis = hysteresis;
+}
+
+// Both halves of a word at once: the error bits become 0xffff lane masks
+// and the valid samples are summed as two 16-bit lanes. A lane holds 16
+// samples of at most 4095 before it is folded into the 32-bit totals.
+#define LANE_ERROR_BITS   (0x00010001u)
+#define WORDS_PER_FOLD    (16)
+
+bool volume_filter_block_mean(uint16_t const* samples, uint32_t count, uint16_t* mean) {
+  const uint32_t total = count;
+  uint32_t sum = 0;
+  uint32_t errors = 0;
+
+  // Single samples before the first word and after the last.
+  if (((uintptr_t)samples & 2u) && count > 0) {
+    const uint32_t error = samples[0] >> ADC_ERROR_SHIFT;
+    sum += samples[0] & (error - 1u);
+    errors += error;
+    samples++;
+    count--;
+  }
+  if (count & 1u) {
+    const uint16_t last = samples[count - 1];
+    const uint32_t error = last >> ADC_ERROR_SHIFT;
+    sum += last & (error - 1u);
+    errors += error;
+  }
+
+  uint32_t const* words = (uint32_t const*)(uintptr_t)samples;
+  uint32_t remaining = count / 2;
+  while (remaining > 0) {
+    const uint32_t chunk = remaining < WORDS_PER_FOLD ? remaining : WORDS_PER_FOLD;
+    uint32_t lanes = 0;
+    uint32_t lane_errors = 0;
+    for (uint32_t index = 0; index < chunk; ++index) {
+      const uint32_t word = words[index];
+      const uint32_t error = (word >> ADC_ERROR_SHIFT) & LANE_ERROR_BITS;
+      lanes += word & ~(error * 0xffffu);
+      lane_errors += error;
+    }
+    sum += (lanes & 0xffffu) + (lanes >> 16);
+    errors += (lane_errors & 0xffffu) + (lane_errors >> 16);
+    words += chunk;
+    remaining -= chunk;
+  }
+
+  const uint32_t valid = total - errors;
+  if (valid == 0) return false;
+
+  *mean = (uint16_t)(sum / valid);
+  return true;
+}
+
+uint8_t volume_filter_update(volume_filter_t* filter, uint16_t block_mean) {
+  const uint32_t input = (uint32_t)block_mean << STATE_SHIFT;
+
+  if (!filter->primed) {
+    // Start from the first reading instead of ramping up from zero.
+    filter->state = input;
+    filter->level = level_of(input);
+    filter->primed = true;
+    return filter->level;
+  }
+
+  // state += (input - state) / 2^shift, kept signed to allow falling values.
+  filter->state += (int32_t)(input - filter->state) >> filter->iir_shift;
+
+  const uint32_t margin = (uint32_t)filter->hysteresis << STATE_SHIFT;
+  const uint32_t lower = level_lower_bound(filter->level);
+  const uint32_t upper = level_lower_bound(filter->level + 1u);
+  // Narrow log-taper bands at the top must not hide the last level.
+  uint32_t rise = upper + margin;
+  if (rise > TopState) rise = TopState;
+  if (filter->state + margin < lower || filter->state >= rise)
+    filter->level = level_of(filter->state);
+
+  return filter->level;
+}
@@ -0,0 +1,52 @@
+#ifndef VOLUME_FILTER_H_
+#define VOLUME_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Fixed-point smoothing of the volume knob, independent of the hardware.
+//
+// Each update takes the mean of one block of 12-bit ADC samples (the
+// decimation stage), runs it through a first-order IIR low-pass and maps it
+// to a level from 0 to VOLUME_FILTER_LEVEL_MAX along the VOLUME_FILTER_TAPER
+// curve. The level only changes once
+// the filtered value leaves the current level's band by more than
+// VOLUME_FILTER_HYSTERESIS ADC counts, so a knob resting on a boundary does
+// not flicker. Both constants are defaults that volume_filter_configure()
+// can override.
+
+#define VOLUME_FILTER_ADC_BITS    (12)
+#define VOLUME_FILTER_LEVEL_MAX   (100)
+// IIR coefficient is 1 / 2^VOLUME_FILTER_IIR_SHIFT.
+#define VOLUME_FILTER_IIR_SHIFT   (2)
+// In ADC counts.
+#define VOLUME_FILTER_HYSTERESIS  (10)
+
+// Knob position to level: linear, or log taper (an exponential curve over
+// 40 dB) so that equal turns sound like equal loudness steps.
+#define VOLUME_FILTER_TAPER_LINEAR  (0)
+#define VOLUME_FILTER_TAPER_LOG     (1)
+#ifndef VOLUME_FILTER_TAPER
+#define VOLUME_FILTER_TAPER       VOLUME_FILTER_TAPER_LINEAR
+#endif
+
+typedef struct {
+  uint32_t state;   // Filtered ADC value, Q16
+  uint8_t level;    // Last reported level
+  bool primed;      // false until the first block
+  uint8_t iir_shift;
+  uint16_t hysteresis;
+} volume_filter_t;
+
+void volume_filter_init(volume_filter_t* filter);
+void volume_filter_configure(volume_filter_t* filter, uint8_t iir_shift, uint16_t hysteresis);
+
+// Mean of count samples, skipping those with the ADC error bit (bit 15) set.
+// Returns false if no valid sample was found. Two samples are taken per
+// word without a branch per sample, so a 4-byte aligned buffer is fastest.
+bool volume_filter_block_mean(uint16_t const* samples, uint32_t count, uint16_t* mean);
+
+// Feed one block mean and return the current level.
+uint8_t volume_filter_update(volume_filter_t* filter, uint16_t block_mean);
+
+#endif /* VOLUME_FILTER_H_ */
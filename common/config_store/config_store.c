@@ -0,0 +1,219 @@
+#include <string.h>
+
+#include "config_store.h"
+
+#define HEADER_MAGIC        (0x31474643u)  // "CFG1"
+#define RECORD_SIZE         (8)
+#define RECORDS_PER_SECTOR  (CONFIG_STORE_SECTOR_SIZE / RECORD_SIZE)
+#define RECORDS_PER_PAGE    (CONFIG_STORE_PAGE_SIZE / RECORD_SIZE)
+#define ERASED_KEY          (0xFFFFu)
+
+// Slot 0 of a sector is the header, the others are records.
+typedef struct {
+  uint32_t magic;
+  uint32_t sequence;
+} header_t;
+
+typedef struct {
+  uint16_t key;
+  uint16_t check;
+  uint32_t value;
+} record_t;
+
+typedef struct {
+  uint16_t key;
+  bool dirty;
+  uint32_t value;
+} entry_t;
+
+static const config_store_flash_t* s_flash = NULL;
+static entry_t s_entries[CONFIG_STORE_MAX_ENTRIES];
+static uint32_t s_entry_count = 0;
+
+static int32_t s_active = -1;       // Sector holding the log, -1 if none
+static uint32_t s_sequence = 0;
+static uint32_t s_next_slot = 0;    // First free record slot in s_active
+static bool s_target_erased = false; // Compaction under way
+static uint32_t s_compact_slot = 1;     // Next record slot of the target
+
+static uint16_t record_check(uint16_t key, uint32_t value) {
+  return (uint16_t)~(key ^ value ^ (value >> 16));
+}
+
+static const uint8_t* slot_address(uint32_t sector, uint32_t slot) {
+  return s_flash->base + sector * CONFIG_STORE_SECTOR_SIZE + slot * RECORD_SIZE;
+}
+
+static bool is_erased(const uint8_t* data, uint32_t len) {
+  for (uint32_t i = 0; i < len; i++) {
+    if (data[i] != 0xff) return false;
+  }
+  return true;
+}
+
+static entry_t* find_entry(uint16_t key) {
+  for (uint32_t i = 0; i < s_entry_count; i++) {
+    if (s_entries[i].key == key) return &s_entries[i];
+  }
+  return NULL;
+}
+
+static bool put_entry(uint16_t key, uint32_t value, bool dirty) {
+  entry_t* entry = find_entry(key);
+  if (!entry) {
+    if (s_entry_count == CONFIG_STORE_MAX_ENTRIES) return false;
+    entry = &s_entries[s_entry_count++];
+    entry->key = key;
+  } else if (entry->value == value) {
+    return true;
+  }
+  entry->value = value;
+  entry->dirty = dirty;
+  return true;
+}
+
+static uint32_t dirty_count(void) {
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < s_entry_count; i++)
+    count += s_entries[i].dirty;
+  return count;
+}
+
+static void put_record(uint8_t* page, uint32_t slot_in_page, entry_t const* entry) {
+  const record_t record = {entry->key, record_check(entry->key, entry->value), entry->value};
+  memcpy(&page[slot_in_page * RECORD_SIZE], &record, RECORD_SIZE);
+}
+
+static void replay(uint32_t sector) {
+  uint32_t slot = 1;
+  for (; slot < RECORDS_PER_SECTOR; slot++) {
+    const uint8_t* address = slot_address(sector, slot);
+    if (is_erased(address, RECORD_SIZE)) break;
+
+    // Torn writes fail the check and are skipped.
+    record_t record;
+    memcpy(&record, address, RECORD_SIZE);
+    if (record.key != ERASED_KEY && record.check == record_check(record.key, record.value))
+      put_entry(record.key, record.value, false);
+  }
+  s_next_slot = slot;
+}
+
+void config_store_init(const config_store_flash_t* flash) {
+  s_flash = flash;
+  s_entry_count = 0;
+  s_active = -1;
+  s_target_erased = false;
+
+  for (uint32_t sector = 0; sector < flash->sector_count; sector++) {
+    header_t header;
+    memcpy(&header, slot_address(sector, 0), sizeof(header));
+    if (header.magic != HEADER_MAGIC) continue;
+    // Sequence numbers wrap, so compare by difference.
+    if (s_active < 0 || (int32_t)(header.sequence - s_sequence) > 0) {
+      s_active = (int32_t)sector;
+      s_sequence = header.sequence;
+    }
+  }
+
+  if (s_active >= 0) replay((uint32_t)s_active);
+}
+
+bool config_store_get(uint16_t key, uint32_t* value) {
+  entry_t const* entry = find_entry(key);
+  if (!entry) return false;
+  *value = entry->value;
+  return true;
+}
+
+uint32_t config_store_get_or(uint16_t key, uint32_t fallback) {
+  uint32_t value;
+  return config_store_get(key, &value) ? value : fallback;
+}
+
+bool config_store_set(uint16_t key, uint32_t value) {
+  if (key == ERASED_KEY) return false;
+  return put_entry(key, value, true);
+}
+
+bool config_store_pending(void) {
+  return s_target_erased || dirty_count() > 0;
+}
+
+static bool needs_compaction(void) {
+  return s_target_erased || s_active < 0 || s_next_slot + dirty_count() > RECORDS_PER_SECTOR;
+}
+
+bool config_store_next_is_erase(void) {
+  return s_flash && !s_target_erased && dirty_count() > 0 && needs_compaction();
+}
+
+// Rewrites every value into the next sector, one flash operation per call:
+// the erase, a page of records per call with slot 1 + i holding entry i,
+// then the header that makes the sector valid. Until the header is written
+// the active sector stays the one read at boot, so a power cut in between
+// loses nothing that was in flash. Values set meanwhile stay dirty if their
+// slot was already written, and entries added meanwhile get their slots.
+static void compact(void) {
+  const uint32_t target = (uint32_t)(s_active + 1) % s_flash->sector_count;
+  const uint32_t offset = target * CONFIG_STORE_SECTOR_SIZE;
+  if (!s_target_erased) {
+    s_flash->erase(offset);
+    s_target_erased = true;
+    s_compact_slot = 1;
+    return;
+  }
+
+  uint8_t page[CONFIG_STORE_PAGE_SIZE];
+  memset(page, 0xff, sizeof(page));
+  if (s_compact_slot < 1 + s_entry_count) {
+    const uint32_t page_index = s_compact_slot / RECORDS_PER_PAGE;
+    while (s_compact_slot < 1 + s_entry_count && s_compact_slot / RECORDS_PER_PAGE == page_index) {
+      entry_t* entry = &s_entries[s_compact_slot - 1];
+      put_record(page, s_compact_slot % RECORDS_PER_PAGE, entry);
+      entry->dirty = false;
+      s_compact_slot++;
+    }
+    s_flash->program(offset + page_index * CONFIG_STORE_PAGE_SIZE, page);
+    return;
+  }
+
+  const header_t header = {HEADER_MAGIC, s_sequence + 1};
+  memcpy(page, &header, sizeof(header));
+  s_flash->program(offset, page);
+
+  s_active = (int32_t)target;
+  s_sequence = header.sequence;
+  s_next_slot = s_compact_slot;
+  s_target_erased = false;
+}
+
+// Writes as many dirty values as fit in the page of the next free slot.
+static void append(void) {
+  uint8_t page[CONFIG_STORE_PAGE_SIZE];
+  memset(page, 0xff, sizeof(page));
+
+  const uint32_t page_index = s_next_slot / RECORDS_PER_PAGE;
+  for (uint32_t i = 0; i < s_entry_count; i++) {
+    if (!s_entries[i].dirty) continue;
+    if (s_next_slot / RECORDS_PER_PAGE != page_index) break;
+    put_record(page, s_next_slot % RECORDS_PER_PAGE, &s_entries[i]);
+    s_entries[i].dirty = false;
+    s_next_slot++;
+  }
+
+  // Programming only clears bits, so the 0xff bytes leave earlier records.
+  s_flash->program((uint32_t)s_active * CONFIG_STORE_SECTOR_SIZE + page_index * CONFIG_STORE_PAGE_SIZE, page);
+}
+
+void config_store_task(void) {
+  if (!s_flash || !config_store_pending()) return;
+
+  // A compaction once started is finished first: the values it took are
+  // only in the target sector.
+  if (needs_compaction()) {
+    compact();
+  } else {
+    append();
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef CONFIG_STORE_H_
+#define CONFIG_STORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Log-structured key/value store for settings kept in flash.
+//
+// Values live in a RAM cache loaded at boot; reads never touch flash.
+// Changes are appended to the active sector as 8-byte records. When it is
+// full the latest values are compacted into the next sector, so erases
+// rotate over all sectors of the region. Each sector starts with a header
+// holding a sequence number and the newest valid one wins at boot.
+//
+// config_store_set() only updates the cache. The flash work is done by
+// config_store_task(), exactly one page program or sector erase per call,
+// so the caller decides when a stall is acceptable. On the RP2040 a program
+// stalls for about 1 ms and an erase for about 45 ms, both with interrupts
+// off. config_store_next_is_erase() lets the caller hold erases back until
+// the device is idle. Not thread safe: use from one context only.
+
+#define CONFIG_STORE_MAX_ENTRIES  (32)
+#define CONFIG_STORE_SECTOR_SIZE  (4096)
+#define CONFIG_STORE_PAGE_SIZE    (256)
+
+// Flash region seen through the store; offsets are relative to base.
+typedef struct {
+  const uint8_t* base;    // Memory-mapped start of the region
+  uint32_t sector_count;  // At least two
+  void (*erase)(uint32_t offset);                       // One sector
+  void (*program)(uint32_t offset, const uint8_t* page);  // One page
+} config_store_flash_t;
+
+// Loads the cache from the newest valid sector. An empty or foreign region
+// starts with no values.
+void config_store_init(const config_store_flash_t* flash);
+
+bool config_store_get(uint16_t key, uint32_t* value);
+uint32_t config_store_get_or(uint16_t key, uint32_t fallback);
+
+// Key 0xFFFF is reserved. Returns false if the cache is full.
+bool config_store_set(uint16_t key, uint32_t value);
+
+// true while some values are not yet in flash, or a compaction is not
+// finished.
+bool config_store_pending(void);
+
+// true when the next config_store_task() call erases a sector.
+bool config_store_next_is_erase(void);
+
+// Performs one flash operation towards writing pending values.
+void config_store_task(void);
+
+// The region at the end of the RP2040's flash (config_store_rp2040.c).
+void config_store_init_rp2040(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_STORE_H_ */
@@ -0,0 +1,66 @@
+#include <assert.h>
+
+#include "config_store.h"
+
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+// Set by builds that run code on core 1, which then must have called
+// multicore_lockout_victim_init().
+#ifndef CONFIG_STORE_LOCKOUT_CORE1
+#define CONFIG_STORE_LOCKOUT_CORE1 (0)
+#endif
+
+#if CONFIG_STORE_LOCKOUT_CORE1
+#include "pico/multicore.h"
+#endif
+
+#ifndef CONFIG_STORE_SECTORS
+#define CONFIG_STORE_SECTORS (4)
+#endif
+
+#define REGION_OFFSET (PICO_FLASH_SIZE_BYTES - CONFIG_STORE_SECTORS * FLASH_SECTOR_SIZE)
+
+static_assert(CONFIG_STORE_SECTOR_SIZE == FLASH_SECTOR_SIZE, "Sector size mismatch");
+static_assert(CONFIG_STORE_PAGE_SIZE == FLASH_PAGE_SIZE, "Page size mismatch");
+
+// Nothing may run from flash while it is written: interrupts on this core
+// are held off and core 1 is parked in RAM for the duration. That is up to
+// about 45 ms for a sector erase (400 ms worst case on a W25Q16JV), which is
+// why callers check config_store_next_is_erase().
+static uint32_t begin_flash_access(void) {
+#if CONFIG_STORE_LOCKOUT_CORE1
+  multicore_lockout_start_blocking();
+#endif
+  return save_and_disable_interrupts();
+}
+
+static void end_flash_access(uint32_t interrupts) {
+  restore_interrupts(interrupts);
+#if CONFIG_STORE_LOCKOUT_CORE1
+  multicore_lockout_end_blocking();
+#endif
+}
+
+static void erase_sector(uint32_t offset) {
+  const uint32_t interrupts = begin_flash_access();
+  flash_range_erase(REGION_OFFSET + offset, FLASH_SECTOR_SIZE);
+  end_flash_access(interrupts);
+}
+
+static void program_page(uint32_t offset, const uint8_t* page) {
+  const uint32_t interrupts = begin_flash_access();
+  flash_range_program(REGION_OFFSET + offset, page, FLASH_PAGE_SIZE);
+  end_flash_access(interrupts);
+}
+
+static const config_store_flash_t s_flash = {
+  (const uint8_t*)(XIP_BASE + REGION_OFFSET),
+  CONFIG_STORE_SECTORS,
+  erase_sector,
+  program_page,
+};
+
+void config_store_init_rp2040(void) {
+  config_store_init(&s_flash);
+}
@@ -0,0 +1,97 @@
+#include <string.h>
+
+#include "button_and_volume_board.h"
+#include "host_flash.h"
+#include "host_usb.h"
+#include "hardware/adc.h"
+
+#include "adc_sampler.h"
+#include "config_store.h"
+#include "telemetry.h"
+#include "usb_descriptors.h"
+#include "volume_filter.h"
+
+static uint32_t s_clock_changes = 0;
+static idle_state_t s_clock_state = IdleActive;
+static uint32_t s_dormant_entries = 0;
+
+uint32_t bav_board_clock_changes(void) {
+  return s_clock_changes;
+}
+
+idle_state_t bav_board_clock_state(void) {
+  return s_clock_state;
+}
+
+uint32_t bav_board_dormant_entries(void) {
+  return s_dormant_entries;
+}
+
+void usb_descriptors_init(void) {}
+
+void config_store_init_rp2040(void) {
+  host_flash_reset();
+  config_store_init(host_flash_region(2));
+}
+
+bool idle_set_clock(idle_state_t state) {
+  if (state == s_clock_state) return false;
+  s_clock_state = state;
+  s_clock_changes++;
+  return true;
+}
+
+bool idle_vbus_present(void) {
+  return true;
+}
+
+void idle_dormant_until(uint32_t rise_mask, uint32_t fall_mask) {
+  (void)rise_mask;
+  (void)fall_mask;
+  s_dormant_entries++;
+}
+
+void adc_sampler_init(void) {}
+
+bool adc_sampler_read_mean(uint16_t* mean) {
+  uint16_t ring[ADC_SAMPLER_RING_SAMPLES];
+  for (uint32_t i = 0; i < ADC_SAMPLER_RING_SAMPLES; i++)
+    ring[i] = adc_read();
+  return volume_filter_block_mean(ring, ADC_SAMPLER_RING_SAMPLES, mean);
+}
+
+uint32_t adc_sampler_copy(uint32_t* cursor, uint32_t* first, uint16_t* samples, uint32_t max_count, uint32_t step) {
+  (void)samples;
+  (void)max_count;
+  (void)step;
+  *first = *cursor;
+  return 0;
+}
+
+bool bav_board_cdc_text(char* text, uint32_t size) {
+  bool intact = true;
+  uint32_t text_len = 0;
+  uint8_t const* data;
+  const uint32_t len = host_usb_cdc_log(&data);
+  uint32_t at = 0;
+  while (at + TELEMETRY_FRAME_OVERHEAD <= len) {
+    const uint32_t payload = data[at + 2];
+    if (data[at] != TELEMETRY_SYNC) {
+      intact = false;
+      break;
+    }
+    // The log may end in the middle of a frame.
+    if (at + payload + TELEMETRY_FRAME_OVERHEAD > len) break;
+    uint8_t sum = 0;
+    for (uint32_t i = 1; i < payload + TELEMETRY_FRAME_OVERHEAD; i++)
+      sum += data[at + i];
+    intact = intact && sum == 0;
+    if (data[at + 1] == TelemetryText && text_len + payload < size) {
+      memcpy(&text[text_len], &data[at + 3], payload);
+      text_len += payload;
+    }
+    at += payload + TELEMETRY_FRAME_OVERHEAD;
+  }
+  text[text_len] = '\0';
+  return intact;
+}
@@ -0,0 +1,26 @@
+#ifndef BUTTON_AND_VOLUME_BOARD_H_
+#define BUTTON_AND_VOLUME_BOARD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "idle.h"
+
+// The hardware parts of button_and_volume that its host tests replace: the
+// settings flash is a RAM array, clock changes and dormant entries are
+// counted instead of applied, and the ADC DMA ring is filled by adc_read()
+// when it is read. The board is powered from the host's port.
+
+// main() of button_and_volume.c, renamed for the tests.
+int button_and_volume_main(void);
+
+uint32_t bav_board_clock_changes(void);
+idle_state_t bav_board_clock_state(void);
+uint32_t bav_board_dormant_entries(void);
+
+// Decodes the telemetry frames the host read from the CDC port and copies
+// the payloads of the text frames to text, NUL terminated. Returns false if
+// a frame was out of sync or failed its checksum.
+bool bav_board_cdc_text(char* text, uint32_t size);
+
+#endif /* BUTTON_AND_VOLUME_BOARD_H_ */
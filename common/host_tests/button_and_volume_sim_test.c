@@ -0,0 +1,283 @@
+// button_and_volume main loop on the simulated board and USB host: a
+// scripted timeline moves the knob and presses the push button, every HID
+// report the host polls is logged with its time, and each press must give
+// exactly one play/pause press and release. The CDC port is open, extra
+// tasks make each trace report larger than the CDC FIFO, and every report
+// must still arrive whole. Built with VOLUME_ABSOLUTE=0, the knob must
+// instead move the host volume with up/down key taps.
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_usb.h"
+#include "tusb.h"
+
+#include "button_and_volume_board.h"
+#include "sched.h"
+#include "input.h"
+#include "usb_descriptors.h"
+#include "volume_filter.h"
+
+// As in button_and_volume.c: the knob as a level report, or as volume keys.
+#ifndef VOLUME_ABSOLUTE
+#define VOLUME_ABSOLUTE (1)
+#endif
+
+#define HID_POLL_MS     (5)     // bInterval of the HID endpoint
+#define LOOP_US         (20)    // One pass of the main loop
+#define BOUNCE_US       (2000)
+#define BOUNCE_STEP_US  (300)
+#define FILLER_TASKS    (4)     // Idle tasks that lengthen the sched report
+// Edge to the play/pause report: a tick of hid_task, the bounce and a poll.
+#define MAX_PRESS_LATENCY_MS (10 + 2 + HID_POLL_MS + 1)
+
+typedef enum {
+  SetKnob,      // ADC counts
+  Press,        // 1 if the press must reach the host
+  Release,
+  End,
+} action_t;
+
+typedef struct {
+  uint32_t at_ms;
+  action_t action;
+  uint32_t value;
+} step_t;
+
+// The knob turns between the presses; the second press of the pair at 3 s
+// falls in the play/pause hold-off and must not be reported. The last press
+// comes after the clock went slow.
+static const step_t Timeline[] = {
+  {0, SetKnob, 1000},
+  {1000, Press, 1},
+  {1150, Release, 0},
+  {2000, SetKnob, 1400},
+  {2050, SetKnob, 1800},
+  {2100, SetKnob, 2200},
+  {2150, SetKnob, 2600},
+  {2200, SetKnob, 3000},
+  {3000, Press, 1},
+  {3080, Release, 0},
+  {3200, Press, 0},
+  {3260, Release, 0},
+  {18000, Press, 1},
+  {18100, Release, 0},
+  {18500, End, 0},
+};
+
+#define EXPECTED_PAIRS (3)
+
+static jmp_buf s_done;
+static uint32_t s_next_step = 0;
+static uint32_t s_knob = 0;
+static bool s_pushed = false;
+static uint64_t s_push_change_us = 0;
+static uint64_t s_press_us[8];   // Presses the host must see
+static uint32_t s_presses = 0;
+static uint32_t s_seed = 1;
+
+static bool s_fillers_added = false;
+
+static uint32_t next_random(void) {
+  s_seed = s_seed * 1103515245u + 12345u;
+  return s_seed >> 16;
+}
+
+// Wiper noise of a few counts.
+static uint16_t knob_sample(void* context) {
+  (void)context;
+  return (uint16_t)(s_knob + next_random() % 9 - 4);
+}
+
+// The contact chatters for BOUNCE_US after each change, active low.
+static bool push_level(void) {
+  const uint64_t since = host_sim_now_us() - s_push_change_us;
+  const bool settled = !s_pushed;
+  if (since >= BOUNCE_US) return settled;
+  return (since / BOUNCE_STEP_US) % 2 ? !settled : settled;
+}
+
+static void filler_task(uint32_t late_ms, void* context) {
+  (void)late_ms;
+  (void)context;
+}
+
+static void run_timeline(void* context) {
+  (void)context;
+  host_sim_advance_us(LOOP_US);
+  const uint64_t now_us = host_sim_now_us();
+
+  // Once the firmware has set up its scheduler.
+  if (!s_fillers_added && now_us >= 100000) {
+    static const char* const Names[FILLER_TASKS] = {
+      "filler_with_a_long_name_0", "filler_with_a_long_name_1",
+      "filler_with_a_long_name_2", "filler_with_a_long_name_3",
+    };
+    for (uint32_t i = 0; i < FILLER_TASKS; i++)
+      CHECK(sched_every(Names[i], 1000, 100, filler_task, NULL, (uint32_t)(now_us / 1000)) >= 0);
+    s_fillers_added = true;
+  }
+
+  while (s_next_step < sizeof(Timeline) / sizeof(Timeline[0]) &&
+         now_us >= Timeline[s_next_step].at_ms * 1000ull) {
+    const step_t* step = &Timeline[s_next_step++];
+    switch (step->action) {
+    case SetKnob:
+      s_knob = step->value;
+      break;
+    case Press:
+    case Release:
+      s_pushed = step->action == Press;
+      s_push_change_us = now_us;
+      if (s_pushed && step->value && s_presses < sizeof(s_press_us) / sizeof(s_press_us[0]))
+        s_press_us[s_presses++] = now_us;
+      break;
+    case End:
+      longjmp(s_done, 1);
+    }
+  }
+  host_sim_gpio_set_input(INPUT_PUSH_BUTTON_GPIO, push_level());
+}
+
+static uint16_t usage_of(host_usb_report_t const* report) {
+  return (uint16_t)(report->data[0] | report->data[1] << 8);
+}
+
+static bool has_keys(host_usb_report_t const* report) {
+  for (uint32_t i = 2; i < 8; i++)
+    if (report->data[i]) return true;
+  return false;
+}
+
+// Decodes the telemetry frames the host read and counts the trace reports
+// whose lines all arrived, from the first line to the last.
+static uint32_t complete_trace_reports(void) {
+  static char text[HOST_USB_CDC_LOG_SIZE + 1];
+  CHECK(bav_board_cdc_text(text, sizeof(text)));
+
+  // Each report runs from the first probe line to the idle line, with the
+  // other sections in between and nothing of the next report.
+  uint32_t reports = 0;
+  for (char* start = strstr(text, "trace tud_task "); start; start = strstr(start + 1, "trace tud_task ")) {
+    char* end = strstr(start, "idle state=");
+    char* next = strstr(start + 1, "trace tud_task ");
+    const bool cut_short = !end || (next && next < end);
+    CHECK(!cut_short);
+    if (cut_short) continue;
+    const char saved = *end;
+    *end = '\0';
+    const bool whole = strstr(start, "trace dropped=") && strstr(start, "sched hid ") &&
+                       strstr(start, "sched filler_with_a_long_name_3 ") && strstr(start, "macro started=");
+    *end = saved;
+    CHECK(whole);
+    CHECK(end - start > HOST_USB_CDC_TX_SIZE);
+    if (whole) reports++;
+  }
+  return reports;
+}
+
+int main(void) {
+  host_sim_reset();
+  host_usb_reset(HID_POLL_MS);
+  host_sim_adc_set_model(knob_sample, NULL);
+  host_sim_gpio_set_input(INPUT_PUSH_BUTTON_GPIO, true);
+  host_usb_set_cdc_connected(true);
+  host_usb_set_task_hook(run_timeline, NULL);
+
+  if (setjmp(s_done) == 0) button_and_volume_main();
+
+  uint32_t play_presses = 0;
+  uint32_t play_releases = 0;
+  uint64_t press_at_us = 0;
+  uint16_t consumer_down = 0;
+  int32_t volume_steps = 0;
+  uint32_t startup_keys = 0;
+  bool key_down = false;
+  uint32_t level_reports = 0;
+  uint8_t last_level = 0;
+  for (uint32_t i = 0; i < host_usb_report_count(); i++) {
+    host_usb_report_t const* report = host_usb_report(i);
+    printf("%10.3f ms id=%u", report->time_us / 1000.0, report->report_id);
+    for (uint32_t b = 0; b < report->len; b++)
+      printf(" %02x", report->data[b]);
+    printf("\n");
+
+    switch (report->report_id) {
+    case REPORT_ID_KEYBOARD:
+      // Only the startup presses of the board button's key carry keys, and
+      // each keyboard report changes the keys.
+      CHECK(has_keys(report) != key_down);
+      if (has_keys(report)) {
+        CHECK(report->time_us < 100000 && report->data[2] == HID_KEY_A);
+        startup_keys++;
+      }
+      key_down = has_keys(report);
+      break;
+    case REPORT_ID_CONSUMER_CONTROL:
+      // Every consumer key is pressed alone and released before the next.
+      if (usage_of(report) == 0) {
+        CHECK(consumer_down != 0);
+        CHECK(report->time_us - press_at_us >= HID_POLL_MS * 1000);
+        if (consumer_down == HID_USAGE_CONSUMER_PLAY_PAUSE) play_releases++;
+        consumer_down = 0;
+        break;
+      }
+      CHECK(consumer_down == 0);
+      consumer_down = usage_of(report);
+      press_at_us = report->time_us;
+      if (consumer_down == HID_USAGE_CONSUMER_PLAY_PAUSE) {
+        if (play_presses < s_presses) {
+          const uint64_t latency_us = report->time_us - s_press_us[play_presses];
+          CHECK(latency_us <= MAX_PRESS_LATENCY_MS * 1000ull);
+        }
+        play_presses++;
+      } else if (consumer_down == HID_USAGE_CONSUMER_VOLUME_INCREMENT) {
+        volume_steps++;
+      } else {
+        CHECK(consumer_down == HID_USAGE_CONSUMER_VOLUME_DECREMENT);
+        volume_steps--;
+      }
+      break;
+    case REPORT_ID_VOLUME_LEVEL:
+      last_level = report->data[0];
+      level_reports++;
+      break;
+    }
+  }
+
+  CHECK(startup_keys == 2);
+  CHECK(play_presses == EXPECTED_PAIRS);
+  CHECK(play_releases == EXPECTED_PAIRS);
+
+  // The knob ends at 3000 of 4096 counts.
+  const uint32_t expected_level = 3000 * (VOLUME_FILTER_LEVEL_MAX + 1) / 4096;
+#if VOLUME_ABSOLUTE
+  const uint32_t start_level = 1000 * (VOLUME_FILTER_LEVEL_MAX + 1) / 4096;
+  // One report per level it passed, and no volume keys.
+  CHECK(last_level + 1u >= expected_level && last_level <= expected_level + 1);
+  CHECK(level_reports >= 2 && level_reports <= 2 + expected_level - start_level);
+  CHECK(volume_steps == 0);
+#else
+  // A volume step per two levels from zero, and no level reports.
+  CHECK(level_reports == 0);
+  CHECK(volume_steps + 1 >= (int32_t)expected_level / 2 && volume_steps <= (int32_t)expected_level / 2 + 1);
+  (void)last_level;
+#endif
+
+  // Slow after 10 s without input, back to full speed on the last press.
+  // A mounted device never goes dormant.
+  CHECK(bav_board_clock_changes() == 2 && bav_board_clock_state() == IdleActive);
+  CHECK(bav_board_dormant_entries() == 0);
+
+  // One report a second, each larger than the CDC FIFO, none of it lost.
+  const uint32_t trace_reports = complete_trace_reports();
+  CHECK(trace_reports >= 17);
+  CHECK(host_usb_cdc_short_writes() == 0);
+
+  printf("button_and_volume sim: %u trace reports, %u reports, %u play/pause pairs, %u level reports, %d volume steps, clock changes %u\n",
+         trace_reports, host_usb_report_count(), play_presses, level_reports, (int)volume_steps, bav_board_clock_changes());
+  return HOST_TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+// config_store on a simulated NOR flash: every config_store_task() call does
+// exactly one flash operation, and a power cut during any of them, torn
+// part way through, leaves a store that boots with each key at its last
+// value in flash or a value set after that.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_flash.h"
+#include "config_store.h"
+
+#define SECTORS   (4)
+#define KEYS      (24)
+#define STEPS     (2200)  // Enough appends for several compactions
+
+static uint32_t s_ops = 0;
+static uint32_t s_cut_at = UINT32_MAX;   // Operation the power fails in
+static uint32_t s_torn_bytes = 0;        // Bytes of it that still happen
+static bool s_power_off = false;
+static bool s_compacting = false;        // Erased a sector, no header since
+static bool s_cut_compacting = false;
+
+// Whether the operation happens, and how much of it. A compaction runs
+// from a sector erase until that sector's header is programmed.
+static uint32_t operation_bytes(uint32_t offset, const uint8_t* page, uint32_t len, void* context) {
+  (void)context;
+  const bool header = page && offset % CONFIG_STORE_SECTOR_SIZE == 0 && page[0] != 0xff;
+  if (!page) s_compacting = true;
+
+  uint32_t bytes = len;
+  const uint32_t op = s_ops++;
+  if (s_power_off) {
+    bytes = 0;
+  } else if (op == s_cut_at) {
+    s_power_off = true;
+    s_cut_compacting = s_compacting;
+    bytes = s_torn_bytes < len ? s_torn_bytes : len;
+  }
+  if (header) s_compacting = false;
+  return bytes;
+}
+
+static uint16_t key_of(uint32_t step) {
+  return (uint16_t)(1 + step * 7 % KEYS);
+}
+
+// The value each step sets is unique, so it tells the step it came from.
+static uint32_t value_of(uint32_t step) {
+  return 0x10000u + step;
+}
+
+typedef struct {
+  uint32_t durable[KEYS + 1];   // Value in flash when nothing was pending, 0 if none
+  uint32_t clean_step;          // Steps before this were all in flash
+  uint32_t steps;               // Steps done before the cut
+} run_t;
+
+// One set and one task call per step, until the power fails.
+static void run(run_t* result) {
+  host_flash_reset();
+  host_flash_set_hook(operation_bytes, NULL);
+  s_ops = 0;
+  s_power_off = false;
+  s_compacting = false;
+  s_cut_compacting = false;
+  config_store_init(host_flash_region(SECTORS));
+  memset(result, 0, sizeof(*result));
+
+  for (uint32_t step = 0; step < STEPS && !s_power_off; step++) {
+    config_store_set(key_of(step), value_of(step));
+    const uint32_t before = s_ops;
+    config_store_task();
+    CHECK(s_ops - before == 1);
+    result->steps = step + 1;
+    if (!s_power_off && !config_store_pending()) {
+      for (uint16_t key = 1; key <= KEYS; key++)
+        config_store_get(key, &result->durable[key]);
+      result->clean_step = step + 1;
+    }
+  }
+}
+
+static void check_after_cut(run_t const* result) {
+  s_power_off = false;
+  s_cut_at = UINT32_MAX;
+  config_store_init(host_flash_region(SECTORS));
+  for (uint16_t key = 1; key <= KEYS; key++) {
+    uint32_t value;
+    if (!config_store_get(key, &value)) {
+      CHECK(result->durable[key] == 0);
+      continue;
+    }
+    if (value == result->durable[key]) continue;
+    const uint32_t step = value - 0x10000u;
+    CHECK(step >= result->clean_step && step < result->steps && key_of(step) == key);
+  }
+
+  // The store keeps working after the reboot.
+  config_store_set(1, 42);
+  while (config_store_pending())
+    config_store_task();
+  config_store_init(host_flash_region(SECTORS));
+  CHECK(config_store_get_or(1, 0) == 42);
+}
+
+int main(void) {
+  // Without a cut: count the operations and the compactions among them.
+  run_t full;
+  run(&full);
+  const uint32_t total_ops = s_ops;
+  uint32_t compaction_cuts = 0;
+  uint32_t used_sectors = 0;
+  for (uint32_t sector = 0; sector < SECTORS; sector++)
+    used_sectors += host_flash_data()[sector * CONFIG_STORE_SECTOR_SIZE] != 0xff;
+  CHECK(full.steps == STEPS);
+  CHECK(used_sectors == SECTORS);
+
+  // Cut the power in each operation, after a varying part of it.
+  for (uint32_t cut = 0; cut < total_ops; cut++) {
+    s_cut_at = cut;
+    s_torn_bytes = cut * 37 % (CONFIG_STORE_PAGE_SIZE + 1);
+    run_t result;
+    run(&result);
+    CHECK(s_power_off);
+    compaction_cuts += s_cut_compacting;
+    check_after_cut(&result);
+  }
+
+  CHECK(compaction_cuts > 0);
+  printf("config_store %u operations, each cut once; %u cuts during a compaction\n", total_ops, compaction_cuts);
+  return HOST_TEST_RESULT();
+}
@@ -0,0 +1,196 @@
+// UniTaruBoard's DFPlayer stack on the simulated module: DfPlayerSd over
+// DfLoopbackTransport, TrackIndex with the config store on a RAM flash, and
+// PlaybackScheduler, polled as the main loop does. The card is enumerated
+// on the first boot only, every query is answered within its wire and
+// module time, errors of play commands never answer a query, and tracks
+// are cut off only where the policy says so.
+
+#include <cstdio>
+#include "host_test.h"
+#include "host_flash.h"
+#include "df_test.h"
+#include "trace.h"
+#include "ConfigKeys.h"
+#include "PlaybackScheduler.h"
+#include "TrackIndex.h"
+
+// The query on the wire, the module's answer and one pass of the loop.
+static constexpr uint32_t QueryUs =
+    FrameUs + DfLoopbackTransport::CommandDelayUs + DfLoopbackTransport::QueryDelayUs + FrameUs + StepUs;
+// The first query waits behind the source and volume commands of startup.
+static constexpr uint32_t MaxQueryUs = 2 * FrameUs + QueryUs;
+
+// Folder 1 holds 20 tracks of 2 s, folder 2 holds tracks of 300 ms.
+static void insertCard(DfLoopbackTransport& card, uint8_t folder2Tracks)
+{
+    card.setFolder(1, 20, 2000000);
+    card.setFolder(2, folder2Tracks, 300000);
+}
+
+// One power-up of the board, with the flash kept from the last one.
+struct Board
+{
+    DfPlayerPicoSd player;
+    TrackIndex index;
+    PlaybackScheduler scheduler;
+
+    explicit Board(uint8_t folder2Tracks)
+    {
+        config_store_init(host_flash_region(2));
+        insertCard(player.transport(), folder2Tracks);
+        player.setResponseHandler([](const DfResponse& response, void* context) {
+            Board* board = static_cast<Board*>(context);
+            board->index.onResponse(response, board->player);
+            board->scheduler.onResponse(response);
+        }, this);
+        player.setVolume(20);
+        index.load();
+        index.verify(player);
+    }
+
+    void step()
+    {
+        dfAdvanceUs(StepUs);
+        player.poll();
+        scheduler.poll(player);
+        config_store_task();
+    }
+
+    void run(uint32_t us)
+    {
+        for (uint32_t elapsed = 0; elapsed < us; elapsed += StepUs) {
+            step();
+        }
+    }
+
+    // A key press as the main loop handles it; false if the track is unknown.
+    bool press(uint8_t folder, uint8_t track)
+    {
+        if (!index.contains(folder, track)) {
+            return false;
+        }
+        CHECK(scheduler.request(folder, track));
+        return true;
+    }
+};
+
+static uint32_t queriesSince(uint32_t count)
+{
+    return DfLoopbackTransport::queryLatency().count - count;
+}
+
+int main()
+{
+    host_sim_reset();
+    trace_init();
+    host_flash_reset();
+
+    // First boot: the card is enumerated, folder by folder, and saved.
+    {
+        Board board(5);
+        CHECK(!board.index.known());
+        board.run(3000000);
+        CHECK(board.index.known());
+        CHECK(board.index.contains(1, 20) && !board.index.contains(1, 21));
+        CHECK(board.index.contains(2, 5) && !board.index.contains(2, 6));
+        CHECK(!board.index.contains(3, 1));
+        CHECK(!config_store_pending());
+        CHECK(config_store_get_or(ConfigCardSignature, 0) == (25u << 16 | 2));
+        // File count, folder count and one query per folder.
+        CHECK(DfLoopbackTransport::queryLatency().count == 4);
+    }
+
+    // Same card: known at once, and only its signature is queried.
+    {
+        const uint32_t queries = DfLoopbackTransport::queryLatency().count;
+        Board board(5);
+        CHECK(board.index.known() && board.index.contains(2, 5));
+        board.run(3000000);
+        CHECK(queriesSince(queries) == 2);
+        CHECK(board.index.known());
+
+        // Interrupt: each press 200 ms after the last cuts the track off.
+        board.scheduler.setPolicy(PlaybackScheduler::Policy::Interrupt);
+        for (uint8_t track = 1; track <= 4; ++track) {
+            CHECK(board.press(1, track));
+            board.run(200000);
+        }
+        CHECK(!board.press(1, 21));
+        board.run(2500000);
+        CHECK(board.player.transport().playCommands() == 4);
+        CHECK(board.player.transport().cutTracks() == 3);
+        CHECK(!board.scheduler.playing());
+
+        // Queue: every track plays to its end.
+        board.scheduler.setPolicy(PlaybackScheduler::Policy::Queue);
+        for (uint8_t track = 1; track <= 4; ++track) {
+            CHECK(board.press(2, track));
+            board.run(5000);
+        }
+        board.run(4 * (300000 + MaxQueryUs));
+        CHECK(board.player.transport().playCommands() == 8);
+        CHECK(board.player.transport().cutTracks() == 3);
+        CHECK(board.scheduler.playTimeouts() == 0);
+        CHECK(board.player.droppedCommands() == 0);
+    }
+
+    // Another card: enumerated again, and the new counts are used.
+    {
+        const uint32_t queries = DfLoopbackTransport::queryLatency().count;
+        Board board(7);
+        CHECK(board.index.known() && !board.index.contains(2, 7));
+        board.run(3000000);
+        CHECK(queriesSince(queries) == 4);
+        CHECK(board.index.contains(2, 7));
+        CHECK(config_store_get_or(ConfigCardSignature, 0) == (27u << 16 | 2));
+    }
+
+    // Without other traffic on the link.
+    const DfLatencyStats latency = DfLoopbackTransport::queryLatency();
+    CHECK(latency.maxUs <= MaxQueryUs);
+    CHECK(latency.minUs >= QueryUs - StepUs);
+    printf("df loopback: %u queries, latency min=%uus mean=%uus max=%uus (bound %uus)\n", latency.count,
+        latency.minUs, static_cast<uint32_t>(latency.sumUs / latency.count), latency.maxUs, MaxQueryUs);
+
+    // Key presses of a missing track during the enumeration: their errors
+    // come while folder queries are in flight and must not answer them.
+    {
+        Board board(9);
+        while (!board.player.ready()) {
+            board.step();
+        }
+        for (uint32_t elapsed = 0; elapsed < 3000000; elapsed += 20000) {
+            board.player.playSound(2, 30);
+            board.run(20000);
+        }
+        CHECK(board.index.known());
+        CHECK(board.index.contains(1, 20) && board.index.contains(2, 9) && !board.index.contains(2, 10));
+        CHECK(config_store_get_or(ConfigCardSignature, 0) == (29u << 16 | 2));
+        CHECK(board.player.droppedCommands() == 0);
+    }
+
+    // A folder missing from the middle of the card while keys are pressed:
+    // its error cannot be told from theirs, so nothing is saved until a
+    // quiet enumeration finds it missing.
+    {
+        Board board(0);
+        board.player.transport().setFolder(3, 4, 300000);
+        while (!board.player.ready()) {
+            board.step();
+        }
+        for (uint32_t elapsed = 0; elapsed < 3000000; elapsed += 20000) {
+            board.player.playSound(2, 30);
+            board.run(20000);
+        }
+        CHECK(!board.index.known() && board.index.contains(2, 1));
+        CHECK(config_store_get_or(ConfigCardSignature, 0) == (29u << 16 | 2));
+
+        board.index.verify(board.player);
+        board.run(3000000);
+        CHECK(board.index.known());
+        CHECK(board.index.contains(1, 20) && !board.index.contains(2, 1));
+        CHECK(config_store_get_or(ConfigCardSignature, 0) == (24u << 16 | 2));
+    }
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,85 @@
+// DfResponseParser against a byte stream in the DFPlayer's format
+// (data/dfplayer_stream.txt): every good frame is decoded once, and noise,
+// cut-off frames and bad checksums are dropped without losing the next one.
+
+#include <cstdio>
+#include <cstdlib>
+#include "host_test.h"
+#include "DfResponseParser.h"
+
+struct Expected
+{
+    uint8_t cmd;
+    uint16_t param;
+};
+
+static const Expected Responses[] = {
+    {0x3F, 0x0002},
+    {0x41, 0x0000},
+    {0x47, 0x0007},
+    {0x4E, 0x0003},
+    {0x3D, 0x0002},
+    {0x40, 0x0006},
+    {0x3B, 0x0002},
+    {0x3A, 0x0002},
+};
+static constexpr size_t ResponseCount = sizeof(Responses) / sizeof(Responses[0]);
+
+static size_t readStream(const char* path, uint8_t* bytes, size_t capacity)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    size_t count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        char* cursor = line;
+        for (;;) {
+            char* end;
+            const unsigned long byte = strtoul(cursor, &end, 16);
+            if (end == cursor || count == capacity) {
+                break;
+            }
+            bytes[count++] = static_cast<uint8_t>(byte);
+            cursor = end;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+int main()
+{
+    uint8_t stream[512];
+    const size_t length = readStream(DFPLAYER_STREAM, stream, sizeof(stream));
+    CHECK(length > 0);
+
+    DfResponseParser parser;
+    size_t decoded = 0;
+    for (size_t index = 0; index < length; ++index) {
+        if (!parser.feed(stream[index])) {
+            continue;
+        }
+        const DfResponse response = parser.response();
+        CHECK(decoded < ResponseCount);
+        if (decoded < ResponseCount) {
+            CHECK(response.cmd == Responses[decoded].cmd);
+            CHECK(response.param == Responses[decoded].param);
+            CHECK(response.frame.length == DfResponseParser::FrameSize);
+            CHECK(response.frame[0] == DfResponseParser::StartByte);
+        }
+        ++decoded;
+    }
+
+    CHECK(decoded == ResponseCount);
+    CHECK(parser.checksumErrors() == 1);
+    CHECK(parser.framingErrors() == 2);
+    printf("df_response_parser %zu bytes, %zu frames, %u checksum errors, %u framing errors\n", length, decoded,
+        parser.checksumErrors(), parser.framingErrors());
+    return HOST_TEST_RESULT();
+}
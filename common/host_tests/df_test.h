@@ -0,0 +1,22 @@
+#ifndef DF_TEST_H_
+#define DF_TEST_H_
+
+// Timing shared by the tests that run UniTaruBoard's DFPlayer stack on
+// DfLoopbackTransport.
+
+#include <cstdint>
+#include "host_sim.h"
+#include "DfPlayerPicoSd.h"
+
+static constexpr uint32_t StepUs = 500; // One pass of the main loop
+static constexpr uint32_t ByteUs = DfLoopbackTransport::byteUs(DfPlayerPicoSd::BaudRate);
+static constexpr uint32_t FrameUs = DfResponseParser::FrameSize * ByteUs;
+
+// Moves the board's clock and the simulated module's together.
+static inline void dfAdvanceUs(uint32_t us)
+{
+    host_sim_advance_us(us);
+    DfLoopbackTransport::advanceUs(us);
+}
+
+#endif /* DF_TEST_H_ */
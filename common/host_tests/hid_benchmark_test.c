@@ -0,0 +1,113 @@
+// button_and_volume's HID benchmark build on the simulated board and USB
+// host: the benchmark's alarm presses the push button, its "bench" lines
+// come out of the CDC port, and every edge must get its play/pause report
+// within a tick of hid_task and a poll. The lines are printed, so
+// hid_bench.py load can keep a host run for comparing revisions. The
+// block-mean cycle counts read 0 here: it takes no simulated time.
+
+#include <inttypes.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_usb.h"
+
+#include "button_and_volume_board.h"
+#include "hid_benchmark.h"
+#include "input.h"
+#include "usb_descriptors.h"
+
+#define HID_POLL_MS     (5)       // bInterval of the HID endpoint
+#define LOOP_US         (20)      // One pass of the main loop
+#define RUN_MS          (30000)
+// Edge to the completed report: a tick of hid_task and a poll.
+#define MAX_LATENCY_US  ((10 + HID_POLL_MS + 1) * 1000)
+
+static jmp_buf s_done;
+
+static uint16_t knob_sample(void* context) {
+  (void)context;
+  return 2000;
+}
+
+static void run_loop(void* context) {
+  (void)context;
+  host_sim_advance_us(LOOP_US);
+  if (host_sim_now_us() >= RUN_MS * 1000ull) longjmp(s_done, 1);
+}
+
+typedef struct {
+  uint32_t windows;
+  uint32_t window_ms;
+  uint32_t reports;
+  uint32_t edges;
+  uint32_t missed;
+  uint32_t latencies;
+  uint64_t latency_sum_us;
+  uint32_t max_us;
+  uint32_t hist_total;
+} totals_t;
+
+// Sums the windows the way hid_bench.py does.
+static void add_line(totals_t* totals, char const* line) {
+  unsigned long a, b, c, d;
+  if (sscanf(line, "bench window_ms=%lu reports=%lu edges=%lu missed=%lu", &a, &b, &c, &d) == 4) {
+    totals->windows++;
+    totals->window_ms += a;
+    totals->reports += b;
+    totals->edges += c;
+    totals->missed += d;
+  } else if (sscanf(line, "bench latency n=%lu min=%lu mean=%lu max=%lu", &a, &b, &c, &d) == 4) {
+    totals->latencies += a;
+    totals->latency_sum_us += (uint64_t)c * a;
+    if (d > totals->max_us) totals->max_us = d;
+  } else if (strncmp(line, "bench hist ", 11) == 0) {
+    char const* at = strchr(line + 11, ' ');
+    int used;
+    while (at && sscanf(at, " %lu%n", &a, &used) == 1) {
+      totals->hist_total += a;
+      at += used;
+    }
+  }
+}
+
+int main(void) {
+  host_sim_reset();
+  host_usb_reset(HID_POLL_MS);
+  host_sim_adc_set_model(knob_sample, NULL);
+  host_sim_gpio_set_input(INPUT_PUSH_BUTTON_GPIO, true);
+  host_usb_set_cdc_connected(true);
+  host_usb_set_task_hook(run_loop, NULL);
+
+  if (setjmp(s_done) == 0) button_and_volume_main();
+
+  static char text[HOST_USB_CDC_LOG_SIZE + 1];
+  CHECK(bav_board_cdc_text(text, sizeof(text)));
+
+  totals_t totals = {0};
+  for (char* line = strtok(text, "\r\n"); line; line = strtok(NULL, "\r\n")) {
+    if (strncmp(line, "bench ", 6) != 0) continue;
+    printf("%s\n", line);
+    add_line(&totals, line);
+  }
+
+  // One window a second, each edge answered in time; the last edge of a
+  // window may be answered in the next one.
+  CHECK(totals.windows + 2 >= RUN_MS / 1000);
+  CHECK(totals.edges >= totals.window_ms * 1000ull / HID_BENCHMARK_PERIOD_US);
+  CHECK(totals.missed == 0);
+  CHECK(totals.latencies + 1 >= totals.edges && totals.latencies <= totals.edges);
+  CHECK(totals.hist_total == totals.latencies);
+  CHECK(totals.max_us <= MAX_LATENCY_US);
+  // The presses and releases at least, and the host saw no fewer reports.
+  CHECK(totals.reports >= 2 * totals.latencies);
+  CHECK(host_usb_report_count() >= totals.reports);
+
+  printf("hid benchmark host: %" PRIu32 " edges in %" PRIu32 " ms, %.1f reports/s, latency mean=%" PRIu64
+         "us max=%" PRIu32 "us (bound %u us)\n",
+         totals.edges, totals.window_ms, totals.window_ms ? totals.reports * 1000.0 / totals.window_ms : 0.0,
+         totals.latencies ? totals.latency_sum_us / totals.latencies : 0, totals.max_us, MAX_LATENCY_US);
+  return HOST_TEST_RESULT();
+}
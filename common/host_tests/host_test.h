@@ -0,0 +1,21 @@
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+
+// Minimal checks for the host tests: a failed CHECK prints where and keeps
+// going, and main() returns HOST_TEST_RESULT() so ctest sees the failure.
+
+static int host_test_failures = 0;
+
+#define CHECK(cond)                                                              \
+  do {                                                                           \
+    if (!(cond)) {                                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);   \
+      host_test_failures++;                                                      \
+    }                                                                            \
+  } while (0)
+
+#define HOST_TEST_RESULT() (host_test_failures == 0 ? 0 : 1)
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,88 @@
+// The inactivity state machine of common/power: Active, then Slow, then
+// Dormant only while the caller allows it, back to Active on any activity,
+// with the time in each state and the current estimate following along,
+// also across the millisecond timestamps wrapping.
+
+#include <stdio.h>
+
+#include "host_test.h"
+#include "idle.h"
+
+static const idle_config_t Config = {10000, 60000};
+
+// Calls idle_next() once a millisecond from from_ms up to to_ms, as a main
+// loop does, and returns when the state first changed (to_ms if never).
+static uint32_t run_until_change(idle_t* idle, uint32_t from_ms, uint32_t to_ms, bool dormant_allowed) {
+  const idle_state_t start = idle->state;
+  for (uint32_t now_ms = from_ms; now_ms != to_ms; now_ms++) {
+    if (idle_next(idle, now_ms, dormant_allowed) != start) return now_ms;
+  }
+  return to_ms;
+}
+
+static void check_timeline(uint32_t start_ms) {
+  idle_t idle;
+  idle_init(&idle, &Config, start_ms);
+  CHECK(idle.state == IdleActive);
+  CHECK(idle_estimate_ua(&idle, start_ms) == IDLE_ACTIVE_UA);
+
+  // Slow after slow_after_ms of quiet, dormant after dormant_after_ms.
+  uint32_t at = run_until_change(&idle, start_ms, start_ms + 100000, true);
+  CHECK(at - start_ms == Config.slow_after_ms && idle.state == IdleSlow);
+  at = run_until_change(&idle, at, start_ms + 100000, true);
+  CHECK(at - start_ms == Config.dormant_after_ms && idle.state == IdleDormant);
+  CHECK(idle.dormant_entries == 1);
+  CHECK(idle.time_in_state_ms[IdleActive] == Config.slow_after_ms);
+  CHECK(idle.time_in_state_ms[IdleSlow] == Config.dormant_after_ms - Config.slow_after_ms);
+
+  // Woken by a key: Active again, and quiet counts from the key.
+  const uint32_t key_ms = at + 5;
+  idle_activity(&idle, key_ms);
+  CHECK(idle.state == IdleActive);
+  CHECK(idle_next(&idle, key_ms + Config.slow_after_ms - 1, true) == IdleActive);
+  CHECK(idle_next(&idle, key_ms + Config.slow_after_ms, true) == IdleSlow);
+
+  // With dormant not allowed (VBUS, a track playing) it stays slow, and
+  // goes dormant as soon as that ends.
+  at = run_until_change(&idle, key_ms + Config.slow_after_ms, key_ms + 200000, false);
+  CHECK(at == key_ms + 200000 && idle.state == IdleSlow);
+  CHECK(idle_next(&idle, at, true) == IdleDormant);
+  CHECK(idle.dormant_entries == 2);
+
+  // Activity in slow mode goes straight back to Active.
+  idle_activity(&idle, at);
+  CHECK(idle_next(&idle, at + Config.slow_after_ms, true) == IdleSlow);
+  idle_activity(&idle, at + Config.slow_after_ms + 3);
+  CHECK(idle.state == IdleActive);
+  CHECK(idle.dormant_entries == 2);
+}
+
+// dormant_after_ms of 0 never goes dormant.
+static void check_never_dormant(void) {
+  static const idle_config_t NoDormant = {1000, 0};
+  idle_t idle;
+  idle_init(&idle, &NoDormant, 0);
+  const uint32_t at = run_until_change(&idle, 0, 5000, true);
+  CHECK(at == 1000 && idle.state == IdleSlow);
+  CHECK(run_until_change(&idle, at, 1000000, true) == 1000000);
+  CHECK(idle.dormant_entries == 0);
+}
+
+// Half the time active and half slow weighs the two currents evenly.
+static void check_estimate(void) {
+  idle_t idle;
+  idle_init(&idle, &Config, 0);
+  CHECK(idle_next(&idle, Config.slow_after_ms, false) == IdleSlow);
+  CHECK(idle_estimate_ua(&idle, 2 * Config.slow_after_ms) == (IDLE_ACTIVE_UA + IDLE_SLOW_UA) / 2);
+  CHECK(idle_estimate_ua(&idle, 4 * Config.slow_after_ms) == (IDLE_ACTIVE_UA + 3 * IDLE_SLOW_UA) / 4);
+}
+
+int main(void) {
+  check_timeline(0);
+  // board_millis() wraps after 49.7 days.
+  check_timeline(UINT32_MAX - 30000);
+  check_never_dormant();
+  check_estimate();
+  printf("idle: state machine checked\n");
+  return HOST_TEST_RESULT();
+}
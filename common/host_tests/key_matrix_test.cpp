@@ -0,0 +1,133 @@
+// KeyMatrix on the GPIO shim: every press and release of a bouncing key
+// gives exactly one event, within a bounded time of the first contact.
+
+#include <cstdio>
+#include "host_test.h"
+#include "host_sim.h"
+#include "KeyMatrix.h"
+
+using ButtonMatrix = KeyMatrix<PinList<2, 3>, PinList<4, 5>>;
+
+static constexpr uint32_t TickUs = 250;
+static constexpr uint32_t BounceUs = 1000;
+// Bounce, then four equal samples of the row, each Rows ticks apart, plus
+// the tick it takes to reach the row.
+static constexpr uint32_t MaxLatencyUs = BounceUs + (4 + 1) * ButtonMatrix::Rows * TickUs;
+
+// Keys wired through diodes: a driven row raises the columns of its keys.
+struct Keys
+{
+    uint32_t held = 0;        // Bit per key, the final contact state
+    uint32_t bouncing = 0;    // Keys whose contact still chatters
+    uint64_t settleUs = 0;
+    uint32_t seed = 1;
+
+    static uint32_t read(uint32_t outputs, void* context)
+    {
+        auto* keys = static_cast<Keys*>(context);
+        uint32_t contacts = keys->held;
+        if (host_sim_now_us() < keys->settleUs) {
+            keys->seed = keys->seed * 1103515245u + 12345u;
+            contacts ^= keys->bouncing & (keys->seed >> 16);
+        }
+        uint32_t inputs = 0;
+        for (uint row = 0; row < ButtonMatrix::Rows; ++row) {
+            if (!(outputs & (1u << (2 + row)))) {
+                continue;
+            }
+            for (uint col = 0; col < ButtonMatrix::Cols; ++col) {
+                if (contacts & (1u << (row * ButtonMatrix::Cols + col))) {
+                    inputs |= 1u << (4 + col);
+                }
+            }
+        }
+        return inputs;
+    }
+
+    void change(uint8_t key, bool pressed)
+    {
+        held = pressed ? held | (1u << key) : held & ~(1u << key);
+        bouncing = 1u << key;
+        settleUs = host_sim_now_us() + BounceUs;
+    }
+};
+
+struct Latency
+{
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+
+    void add(uint32_t us)
+    {
+        ++count;
+        maxUs = us > maxUs ? us : maxUs;
+        sumUs += us;
+    }
+};
+
+// Runs until the matrix reports the change, or gives up after a while.
+static bool waitEvent(ButtonMatrix& matrix, uint8_t key, bool pressed, uint32_t edgeUs, Latency& latency)
+{
+    for (uint32_t waited = 0; waited < 4 * MaxLatencyUs; waited += 50) {
+        host_sim_advance_us(50);
+        KeyEvent event;
+        if (!matrix.popEvent(event)) {
+            continue;
+        }
+        CHECK(event.key == key);
+        CHECK(event.pressed == pressed);
+        latency.add(event.time_us - edgeUs);
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    host_sim_reset();
+    Keys keys;
+    host_sim_gpio_set_model(&Keys::read, &keys);
+
+    ButtonMatrix matrix;
+    CHECK(matrix.start(TickUs));
+
+    Latency press;
+    Latency release;
+    uint32_t seed = 7;
+    for (int repeat = 0; repeat < 400; ++repeat) {
+        const uint8_t key = repeat % ButtonMatrix::KeyCount;
+        seed = seed * 1103515245u + 12345u;
+        host_sim_advance_us(5000 + (seed >> 16) % 2000); // Any phase of the scan
+
+        keys.change(key, true);
+        CHECK(waitEvent(matrix, key, true, time_us_32(), press));
+        CHECK(matrix.pressedKeys() == (1u << key));
+
+        host_sim_advance_us(20000);
+        keys.change(key, false);
+        CHECK(waitEvent(matrix, key, false, time_us_32(), release));
+        CHECK(matrix.pressedKeys() == 0);
+    }
+
+    // Bounce never shows up as extra events.
+    host_sim_advance_us(20000);
+    KeyEvent extra;
+    CHECK(!matrix.popEvent(extra));
+    CHECK(matrix.droppedEvents() == 0);
+
+    // Held keys all show in the bitmap, not just the highest one.
+    keys.change(0, true);
+    keys.change(3, true);
+    host_sim_advance_us(2 * MaxLatencyUs);
+    CHECK(matrix.pressedKeys() == 0x9u);
+
+    CHECK(press.count == 400 && release.count == 400);
+    CHECK(press.maxUs <= MaxLatencyUs);
+    CHECK(release.maxUs <= MaxLatencyUs);
+    printf("key_matrix press n=%u mean=%lluus max=%uus, release n=%u mean=%lluus max=%uus (bound %uus)\n",
+        press.count, static_cast<unsigned long long>(press.sumUs / press.count), press.maxUs,
+        release.count, static_cast<unsigned long long>(release.sumUs / release.count), release.maxUs,
+        MaxLatencyUs);
+    return HOST_TEST_RESULT();
+}
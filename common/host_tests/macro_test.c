@@ -0,0 +1,159 @@
+// button_and_volume keystroke macros on the simulated USB host: chords go
+// out one report per poll in order, a release is inserted only where the
+// next chord repeats a key or modifier that is still down, every macro ends
+// with all keys up, and a macro started while the queue is full is dropped
+// and counted while the queued ones still run in order.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_usb.h"
+#include "tusb.h"
+#include "macro.h"
+
+#define REPORT_ID  (1)
+#define POLL_MS    (1)
+
+#define CHORD(mod, ...) { (mod), { __VA_ARGS__ } }
+#define MACRO(name, chords) { (name), (chords), sizeof(chords) / sizeof((chords)[0]) }
+
+typedef struct {
+  uint8_t modifier;
+  uint8_t keycode;    // Only the first slot is used by these macros
+} step_t;
+
+// Modifiers held on alone need a release to count as a second press.
+static const macro_chord_t CtrlTwice[] = {
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, 0),
+  CHORD(KEYBOARD_MODIFIER_LEFTCTRL, 0),
+};
+static const macro_t CtrlTwiceMacro = MACRO("ctrl_twice", CtrlTwice);
+
+// Runs the main loop until the macros are sent and the host took the last
+// report, and returns the number of reports it took.
+static uint32_t run(void) {
+  const uint32_t first = host_usb_report_count();
+  for (uint32_t ms = 0; ms < 1000 && (macro_active() || !tud_hid_ready()); ms++) {
+    host_sim_advance_us(POLL_MS * 1000);
+    tud_task();
+    macro_send_next(REPORT_ID);
+  }
+  CHECK(!macro_active());
+  return host_usb_report_count() - first;
+}
+
+static void check_reports(uint32_t first, step_t const* expected, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    host_usb_report_t const* report = host_usb_report(first + i);
+    CHECK(report != NULL);
+    if (!report) return;
+    static const uint8_t NoKeys[MACRO_MAX_KEYS] = {0};
+    CHECK(report->report_id == REPORT_ID && report->len == 8);
+    CHECK(report->data[0] == expected[i].modifier);
+    CHECK(report->data[2] == expected[i].keycode);
+    CHECK(memcmp(&report->data[3], NoKeys, MACRO_MAX_KEYS - 1) == 0);
+    // One report per poll, back to back.
+    if (i > 0) CHECK(report->time_us - host_usb_report(first + i - 1)->time_us == POLL_MS * 1000);
+  }
+}
+
+static void report_line(const char* text, uint32_t len, void* context) {
+  char* line = context;
+  memcpy(line, text, len);
+  line[len] = 0;
+}
+
+static void check_counters(uint32_t started, uint32_t dropped, uint32_t reports, uint32_t releases) {
+  char line[96];
+  char expected[96];
+  macro_report(report_line, line);
+  snprintf(expected, sizeof(expected), "macro started=%u dropped=%u reports=%u releases=%u\r\n",
+           started, dropped, reports, releases);
+  CHECK(strcmp(line, expected) == 0);
+}
+
+int main(void) {
+  host_sim_reset();
+  host_usb_reset(POLL_MS);
+  macro_init();
+
+  CHECK(macro_table_get(0) == NULL && macro_table_get(8) == NULL);
+  CHECK(!macro_start(NULL));
+  CHECK(!macro_active());
+
+  // Chords in order with no release in between, ending with all keys up.
+  uint32_t first = host_usb_report_count();
+  CHECK(macro_start(macro_table_get(6)));
+  static const step_t CopyLine[] = {
+    {0, HID_KEY_HOME},
+    {KEYBOARD_MODIFIER_LEFTSHIFT, HID_KEY_END},
+    {KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C},
+    {0, 0},
+  };
+  CHECK(run() == 4);
+  check_reports(first, CopyLine, 4);
+  check_counters(1, 0, 4, 0);
+
+  // The repeated L of "Hello" gets a release, nothing else does.
+  first = host_usb_report_count();
+  CHECK(macro_start(macro_table_get(7)));
+  static const step_t Hello[] = {
+    {KEYBOARD_MODIFIER_LEFTSHIFT, HID_KEY_H},
+    {0, HID_KEY_E},
+    {0, HID_KEY_L},
+    {0, 0},
+    {0, HID_KEY_L},
+    {0, HID_KEY_O},
+    {0, HID_KEY_ENTER},
+    {0, 0},
+  };
+  CHECK(run() == 8);
+  check_reports(first, Hello, 8);
+  check_counters(2, 0, 12, 1);
+
+  first = host_usb_report_count();
+  CHECK(macro_start(&CtrlTwiceMacro));
+  static const step_t Ctrl[] = {
+    {KEYBOARD_MODIFIER_LEFTCTRL, 0},
+    {0, 0},
+    {KEYBOARD_MODIFIER_LEFTCTRL, 0},
+    {0, 0},
+  };
+  CHECK(run() == 4);
+  check_reports(first, Ctrl, 4);
+  check_counters(3, 0, 16, 2);
+
+  // A full queue drops the fifth macro; the four queued run in order,
+  // each ending in a release, so the same macro twice is two presses.
+  first = host_usb_report_count();
+  CHECK(macro_start(macro_table_get(1)));
+  CHECK(macro_start(macro_table_get(2)));
+  CHECK(macro_start(macro_table_get(1)));
+  CHECK(macro_start(macro_table_get(3)));
+  CHECK(!macro_start(macro_table_get(4)));
+  static const step_t Queued[] = {
+    {KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C}, {0, 0},
+    {KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_V}, {0, 0},
+    {KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C}, {0, 0},
+    {KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_Z}, {0, 0},
+  };
+  CHECK(run() == 8);
+  check_reports(first, Queued, 8);
+  check_counters(7, 1, 24, 2);
+
+  // Nothing is sent while the endpoint still holds a report.
+  CHECK(macro_start(macro_table_get(5)));
+  CHECK(macro_send_next(REPORT_ID));
+  CHECK(!macro_send_next(REPORT_ID));
+
+  // The host went away: the rest of the macro is forgotten.
+  macro_reset();
+  CHECK(!macro_active());
+  CHECK(!macro_send_next(REPORT_ID));
+  check_counters(8, 1, 25, 2);
+
+  printf("macro %u reports\n", host_usb_report_count());
+  return HOST_TEST_RESULT();
+}
@@ -0,0 +1,237 @@
+// key_matrix.pio on the PIO and DMA emulator: the snapshots PioMatrixScanner
+// keeps match the keys once the settle loop covers the column's rise time,
+// rows are strobed at the rate the program's cycle count gives, also after
+// clk_sys changed, and KeyMatrix::startPio() turns bouncing presses into
+// single events.
+
+#include <cstdio>
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_pio.h"
+#include "KeyMatrix.h"
+
+static constexpr uint RowBase = 2;
+static constexpr uint ColBase = 4;
+using ButtonMatrix = KeyMatrix<PinList<2, 3>, PinList<4, 5>>;
+
+// A driven row takes RiseUs to lift a column through key and diode, and the
+// pull-down takes FallUs to bring it back after the row drops.
+static constexpr uint32_t RiseUs = 8;
+static constexpr uint32_t FallUs = 3;
+static constexpr uint32_t BounceUs = 1000;
+
+static constexpr uint DefaultSettleUs = 10;
+// pull, out, mov, settle + 1 jmp, in, push at one PIO clock per microsecond.
+static constexpr uint32_t RowUs = DefaultSettleUs + 6;
+static constexpr uint32_t PollUs = 1000;
+// Bounce, four equal polls after the one that first sees the key, and a
+// full strobe of the rows.
+static constexpr uint32_t MaxLatencyUs = BounceUs + (4 + 1) * PollUs + ButtonMatrix::Rows * RowUs;
+
+struct Keys
+{
+    uint32_t held = 0;        // Bit per key, row * Cols + col
+    uint32_t bouncing = 0;
+    uint64_t settleUs = 0;
+    uint32_t seed = 1;
+
+    static uint32_t read(uint32_t outputs, void* context)
+    {
+        auto* keys = static_cast<Keys*>(context);
+        uint32_t contacts = keys->held;
+        if (host_sim_now_us() < keys->settleUs) {
+            keys->seed = keys->seed * 1103515245u + 12345u;
+            contacts ^= keys->bouncing & (keys->seed >> 16);
+        }
+        uint32_t inputs = 0;
+        for (uint row = 0; row < ButtonMatrix::Rows; ++row) {
+            const uint pin = RowBase + row;
+            const uint64_t since = host_sim_now_us() - host_sim_gpio_changed_us(pin);
+            const bool high = (outputs >> pin) & 1u;
+            if (high ? since < RiseUs : since >= FallUs) {
+                continue;
+            }
+            for (uint col = 0; col < ButtonMatrix::Cols; ++col) {
+                if (contacts & (1u << (row * ButtonMatrix::Cols + col))) {
+                    inputs |= 1u << (ColBase + col);
+                }
+            }
+        }
+        return inputs;
+    }
+
+    void change(uint8_t key, bool pressed)
+    {
+        held = pressed ? held | (1u << key) : held & ~(1u << key);
+        bouncing = 1u << key;
+        settleUs = host_sim_now_us() + BounceUs;
+    }
+};
+
+static void startSim(Keys& keys)
+{
+    host_sim_reset();
+    keys = Keys{};
+    host_sim_gpio_set_model(&Keys::read, &keys);
+    gpio_init_mask(0x3u << RowBase | 0x3u << ColBase);
+}
+
+// Whether every key pattern of the 2 x 2 matrix shows up in the snapshots.
+static bool readsAllPatterns(uint settleUs)
+{
+    Keys keys;
+    startSim(keys);
+    PioMatrixScanner scanner;
+    CHECK(scanner.start(pio0, RowBase, ButtonMatrix::Rows, ColBase, ButtonMatrix::Cols, settleUs));
+
+    bool exact = true;
+    for (uint32_t pattern = 0; pattern < 16; ++pattern) {
+        keys.held = pattern;
+        host_sim_advance_us(4 * ButtonMatrix::Rows * (settleUs + 6));
+        for (uint row = 0; row < ButtonMatrix::Rows; ++row) {
+            exact &= (scanner.row(row) & 0x3u) == ((pattern >> (row * ButtonMatrix::Cols)) & 0x3u);
+        }
+    }
+    return exact;
+}
+
+static void checkScanRate()
+{
+    Keys keys;
+    startSim(keys);
+    PioMatrixScanner scanner;
+    CHECK(scanner.start(pio0, RowBase, ButtonMatrix::Rows, ColBase, ButtonMatrix::Cols, DefaultSettleUs));
+    host_sim_advance_us(1000);
+
+    const host_pio_sm_stats_t before = host_pio_sm_stats(pio0, 0);
+    host_sim_advance_us(100000);
+    const host_pio_sm_stats_t after = host_pio_sm_stats(pio0, 0);
+    const uint32_t rows = after.pushes - before.pushes;
+    CHECK(rows + 1 >= 100000 / RowUs && rows <= 100000 / RowUs + 1);
+    CHECK(after.pulls - before.pulls == rows);
+    // DMA keeps both FIFOs moving, so the program never waits.
+    CHECK(after.stalls == 0);
+    printf("pio_key_matrix rows/s=%u (%uus per row)\n", rows * 10, RowUs);
+}
+
+struct Latency
+{
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+
+    void add(uint32_t us)
+    {
+        ++count;
+        maxUs = us > maxUs ? us : maxUs;
+        sumUs += us;
+    }
+};
+
+static bool waitEvent(ButtonMatrix& matrix, uint8_t key, bool pressed, uint32_t edgeUs, Latency& latency)
+{
+    for (uint32_t waited = 0; waited < 4 * MaxLatencyUs; waited += 100) {
+        host_sim_advance_us(100);
+        KeyEvent event;
+        if (!matrix.popEvent(event)) {
+            continue;
+        }
+        CHECK(event.key == key);
+        CHECK(event.pressed == pressed);
+        latency.add(event.time_us - edgeUs);
+        return true;
+    }
+    return false;
+}
+
+// Rows strobed per 100 ms of simulated time.
+static uint32_t rowsIn100Ms()
+{
+    const host_pio_sm_stats_t before = host_pio_sm_stats(pio0, 0);
+    host_sim_advance_us(100000);
+    return host_pio_sm_stats(pio0, 0).pushes - before.pushes;
+}
+
+// The idle mode drops clk_sys to 48 MHz: the program slows down with it
+// until the divider is set again, and then scans at the same rate.
+static void checkClockChange()
+{
+    static constexpr uint32_t SlowHz = 48000000;
+    Keys keys;
+    startSim(keys);
+    ButtonMatrix matrix;
+    CHECK(matrix.startPio(pio0, DefaultSettleUs, PollUs));
+    host_sim_advance_us(1000);
+    const uint32_t fast = rowsIn100Ms();
+
+    host_sim_set_clock_hz(SlowHz);
+    rowsIn100Ms(); // Settle on the new period
+    const uint32_t stale = rowsIn100Ms();
+    matrix.onClockChanged();
+    rowsIn100Ms();
+    const uint32_t slow = rowsIn100Ms();
+
+    CHECK(stale * 2 < fast);
+    CHECK(slow + 1 >= fast && slow <= fast + 1);
+
+    // Keys still come through at the slow clock.
+    Latency press;
+    keys.change(1, true);
+    CHECK(waitEvent(matrix, 1, true, time_us_32(), press));
+    CHECK(press.maxUs <= MaxLatencyUs);
+    printf("pio_key_matrix rows/100ms at 125 MHz=%u, 48 MHz=%u before the new divider, %u after\n", fast, stale,
+        slow);
+}
+
+static void checkEvents()
+{
+    Keys keys;
+    startSim(keys);
+    ButtonMatrix matrix;
+    CHECK(matrix.startPio(pio0, DefaultSettleUs, PollUs));
+
+    Latency press;
+    Latency release;
+    uint32_t seed = 7;
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        const uint8_t key = repeat % ButtonMatrix::KeyCount;
+        seed = seed * 1103515245u + 12345u;
+        host_sim_advance_us(5000 + (seed >> 16) % 2000);
+
+        keys.change(key, true);
+        CHECK(waitEvent(matrix, key, true, time_us_32(), press));
+        host_sim_advance_us(20000);
+        keys.change(key, false);
+        CHECK(waitEvent(matrix, key, false, time_us_32(), release));
+    }
+
+    host_sim_advance_us(20000);
+    KeyEvent extra;
+    CHECK(!matrix.popEvent(extra));
+    CHECK(matrix.ghostedScans() == 0);
+    CHECK(press.count == 100 && release.count == 100);
+    CHECK(press.maxUs <= MaxLatencyUs);
+    CHECK(release.maxUs <= MaxLatencyUs);
+    printf("pio_key_matrix press mean=%lluus max=%uus, release mean=%lluus max=%uus (bound %uus)\n",
+        static_cast<unsigned long long>(press.sumUs / press.count), press.maxUs,
+        static_cast<unsigned long long>(release.sumUs / release.count), release.maxUs, MaxLatencyUs);
+}
+
+int main()
+{
+    // The settle loop is what lets the column rise: too short a wait reads
+    // keys as up, and the default is long enough for the modelled wiring.
+    uint minSettleUs = 0;
+    while (minSettleUs <= DefaultSettleUs && !readsAllPatterns(minSettleUs)) {
+        ++minSettleUs;
+    }
+    CHECK(minSettleUs > 0);
+    CHECK(minSettleUs <= DefaultSettleUs);
+    printf("pio_key_matrix shortest settle=%uus for a %uus rise (default %uus)\n", minSettleUs, RiseUs,
+        DefaultSettleUs);
+
+    checkScanRate();
+    checkEvents();
+    checkClockChange();
+    return HOST_TEST_RESULT();
+}
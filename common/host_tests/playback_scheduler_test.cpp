@@ -0,0 +1,174 @@
+// PlaybackScheduler in front of a DFPlayer simulated by DfLoopbackTransport:
+// bursts of key presses faster than the module takes commands are
+// coalesced, and the key-to-play latency (request until the module starts
+// the track) stays bounded. Policy::Queue plays every request in order,
+// and without BUSY a lost track end only holds the queue for MaxPlayUs.
+
+#include <cstdio>
+#include "host_test.h"
+#include "df_test.h"
+#include "trace.h"
+#include "PlaybackScheduler.h"
+
+// The command interval, the frame on the wire and the module's reaction.
+static constexpr uint32_t MaxLatencyUs =
+    PlaybackScheduler::MinCommandIntervalUs + FrameUs + DfLoopbackTransport::CommandDelayUs + StepUs;
+
+struct Latency
+{
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+
+    void add(uint32_t us)
+    {
+        ++count;
+        maxUs = us > maxUs ? us : maxUs;
+        sumUs += us;
+    }
+
+    uint32_t meanUs() const { return count ? static_cast<uint32_t>(sumUs / count) : 0; }
+};
+
+struct Rig
+{
+    DfPlayerPicoSd player;
+    PlaybackScheduler scheduler;
+
+    explicit Rig(uint32_t trackUs)
+    {
+        player.transport().setFolder(1, 20, trackUs);
+        player.setResponseHandler([](const DfResponse& response, void* context) {
+            static_cast<PlaybackScheduler*>(context)->onResponse(response);
+        }, &scheduler);
+        while (!player.ready()) {
+            step();
+        }
+    }
+
+    void step()
+    {
+        dfAdvanceUs(StepUs);
+        player.poll();
+        scheduler.poll(player);
+    }
+
+    // Runs until the module plays track, or gives up after a while.
+    bool waitTrack(uint8_t track, uint32_t limitUs)
+    {
+        for (uint32_t waited = 0; waited < limitUs; waited += StepUs) {
+            if (player.transport().playing() && player.transport().playingTrack() == track) {
+                return true;
+            }
+            step();
+        }
+        return false;
+    }
+
+    void run(uint32_t us)
+    {
+        for (uint32_t elapsed = 0; elapsed < us; elapsed += StepUs) {
+            step();
+        }
+    }
+};
+
+// Bursts of presses 5 ms apart: only the last of a burst has to play, and
+// the module gets no more commands than it can take.
+static void checkBursts()
+{
+    Rig rig(2000000);
+    rig.scheduler.setPolicy(PlaybackScheduler::Policy::Interrupt);
+
+    Latency latency;
+    uint32_t presses = 0;
+    uint32_t seed = 3;
+    for (uint32_t burst = 0; burst < 50; ++burst) {
+        seed = seed * 1103515245u + 12345u;
+        const uint32_t length = 1 + (seed >> 16) % 6;
+        uint8_t track = 0;
+        for (uint32_t press = 0; press < length; ++press) {
+            track = static_cast<uint8_t>(1 + (burst * 7 + press) % 20);
+            CHECK(rig.scheduler.request(1, track));
+            ++presses;
+            if (press + 1 < length) {
+                rig.run(5000);
+            }
+        }
+        const uint32_t lastPressUs = time_us_32();
+        CHECK(rig.waitTrack(track, 4 * MaxLatencyUs));
+        latency.add(time_us_32() - lastPressUs);
+        rig.run(300000 + (seed >> 20) % 200000);
+    }
+
+    CHECK(latency.count == 50);
+    CHECK(latency.maxUs <= MaxLatencyUs);
+    CHECK(rig.player.transport().playCommands() < presses);
+    CHECK(rig.scheduler.coalescedRequests() > 0);
+    CHECK(rig.player.droppedCommands() == 0);
+    CHECK(rig.player.transport().ignoredFrames() == 0);
+    printf("playback interrupt: %u presses, %u commands, latency mean=%uus max=%uus (bound %uus)\n",
+        presses, rig.player.transport().playCommands(), latency.meanUs(), latency.maxUs, MaxLatencyUs);
+}
+
+// Queued requests each play to the end, in order.
+static void checkQueue()
+{
+    static constexpr uint32_t TrackUs = 200000;
+    Rig rig(TrackUs);
+    rig.scheduler.setPolicy(PlaybackScheduler::Policy::Queue);
+
+    for (uint8_t track = 1; track <= 4; ++track) {
+        CHECK(rig.scheduler.request(1, track));
+        rig.run(5000);
+    }
+    Latency latency;
+    const uint32_t firstPressUs = time_us_32() - 4 * 5000;
+    for (uint8_t track = 1; track <= 4; ++track) {
+        CHECK(rig.waitTrack(track, 2 * TrackUs + MaxLatencyUs));
+        latency.add(time_us_32() - firstPressUs);
+    }
+    rig.run(TrackUs + MaxLatencyUs);
+
+    CHECK(!rig.scheduler.playing());
+    CHECK(rig.player.transport().cutTracks() == 0);
+    CHECK(rig.scheduler.playTimeouts() == 0);
+    // Each track waits for the ones before it.
+    CHECK(latency.maxUs <= 4 * (TrackUs + MaxLatencyUs));
+    printf("playback queue: 4 tracks of %uus, last started after %uus\n", TrackUs, latency.maxUs);
+}
+
+// A module that never reports the track end, and no BUSY pin.
+static void checkLostTrackEnd()
+{
+    Rig rig(1000000);
+    rig.player.transport().setNotifyTrackEnd(false);
+    rig.scheduler.setPolicy(PlaybackScheduler::Policy::Queue);
+
+    CHECK(rig.scheduler.request(1, 1));
+    CHECK(rig.waitTrack(1, MaxLatencyUs));
+    const uint32_t startUs = time_us_32();
+    CHECK(rig.scheduler.request(1, 2));
+    CHECK(rig.waitTrack(2, PlaybackScheduler::MaxPlayUs + MaxLatencyUs));
+    const uint32_t waitedUs = time_us_32() - startUs;
+
+    CHECK(waitedUs >= PlaybackScheduler::MaxPlayUs - MaxLatencyUs);
+    CHECK(rig.scheduler.playTimeouts() == 1);
+    printf("playback lost track end: next track after %uus\n", waitedUs);
+}
+
+int main()
+{
+    host_sim_reset();
+    trace_init();
+
+    CHECK(PlaybackScheduler::policyFromValue(0) == PlaybackScheduler::Policy::Interrupt);
+    CHECK(PlaybackScheduler::policyFromValue(1) == PlaybackScheduler::Policy::Queue);
+    CHECK(PlaybackScheduler::policyFromValue(7) == PlaybackScheduler::Policy::Interrupt);
+    CHECK(PlaybackScheduler::policyFromValue(0xffffffffu) == PlaybackScheduler::Policy::Interrupt);
+
+    checkBursts();
+    checkQueue();
+    checkLostTrackEnd();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,23 @@
+#ifndef HOST_BSP_BOARD_H_
+#define HOST_BSP_BOARD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void board_init(void) {}
+static inline uint32_t board_millis(void) { return to_ms_since_boot(get_absolute_time()); }
+
+// Set with host_sim_board_button().
+bool board_button_read(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BSP_BOARD_H_ */
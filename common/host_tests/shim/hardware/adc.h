@@ -0,0 +1,28 @@
+#ifndef HOST_HARDWARE_ADC_H_
+#define HOST_HARDWARE_ADC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Only conversions are simulated: adc_read() returns what the model set
+// with host_sim_adc_set_model() gives. The configuration calls do nothing.
+static inline void adc_init(void) {}
+static inline void adc_gpio_init(uint gpio) { (void)gpio; }
+static inline void adc_select_input(uint input) { (void)input; }
+static inline void adc_set_round_robin(uint mask) { (void)mask; }
+static inline void adc_set_clkdiv(float clkdiv) { (void)clkdiv; }
+static inline void adc_run(bool run) { (void)run; }
+
+uint16_t adc_read(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HARDWARE_ADC_H_ */
@@ -0,0 +1,22 @@
+#ifndef HOST_HARDWARE_CLOCKS_H_
+#define HOST_HARDWARE_CLOCKS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index {
+  clk_sys = 5,
+  clk_peri = 6,
+};
+
+// 125 MHz after host_sim_reset(); host_sim_set_clock_hz() changes clk_sys.
+uint32_t clock_get_hz(enum clock_index clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HARDWARE_CLOCKS_H_ */
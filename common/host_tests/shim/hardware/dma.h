@@ -0,0 +1,63 @@
+#ifndef HOST_HARDWARE_DMA_H_
+#define HOST_HARDWARE_DMA_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// DMA channels paced by the PIO emulator of host_pio.c: a channel moves a
+// word whenever the FIFO behind its DREQ has room or data.
+
+#define HOST_DMA_CHANNELS (12)
+
+enum dma_channel_transfer_size {
+  DMA_SIZE_8 = 0,
+  DMA_SIZE_16 = 1,
+  DMA_SIZE_32 = 2,
+};
+
+// PIO0 TX0-3, RX0-3 and PIO1 the same, as on the RP2040.
+#define DREQ_PIO0_TX0 (0)
+#define DREQ_PIO0_RX0 (4)
+#define DREQ_PIO1_TX0 (8)
+#define DREQ_PIO1_RX0 (12)
+#define DREQ_ADC      (36)
+
+typedef struct {
+  enum dma_channel_transfer_size size;
+  bool read_increment;
+  bool write_increment;
+  bool ring_write;
+  uint ring_bits;   // 0 for no ring
+  uint dreq;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size) {
+  c->size = size;
+}
+static inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) { c->read_increment = incr; }
+static inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) { c->write_increment = incr; }
+static inline void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits) {
+  c->ring_write = write;
+  c->ring_bits = size_bits;
+}
+static inline void channel_config_set_dreq(dma_channel_config* c, uint dreq) { c->dreq = dreq; }
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint32_t transfer_count, bool trigger);
+void dma_start_channel_mask(uint32_t mask);
+bool dma_channel_is_busy(uint channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HARDWARE_DMA_H_ */
@@ -0,0 +1,56 @@
+#ifndef HOST_HARDWARE_GPIO_H_
+#define HOST_HARDWARE_GPIO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIO_IN  (false)
+#define GPIO_OUT (true)
+
+enum gpio_function {
+  GPIO_FUNC_UART = 2,
+  GPIO_FUNC_PWM = 4,
+  GPIO_FUNC_SIO = 5,
+  GPIO_FUNC_PIO0 = 6,
+  GPIO_FUNC_PIO1 = 7,
+  GPIO_FUNC_NULL = 0x1f,
+};
+
+enum gpio_override {
+  GPIO_OVERRIDE_NORMAL = 0,
+  GPIO_OVERRIDE_INVERT = 1,
+  GPIO_OVERRIDE_LOW = 2,
+  GPIO_OVERRIDE_HIGH = 3,
+};
+
+void gpio_init(uint pin);
+void gpio_init_mask(uint32_t mask);
+void gpio_set_dir(uint pin, bool out);
+void gpio_set_dir_out_masked(uint32_t mask);
+void gpio_set_dir_in_masked(uint32_t mask);
+void gpio_set_function(uint pin, enum gpio_function function);
+static inline void gpio_pull_up(uint pin) { (void)pin; }
+static inline void gpio_pull_down(uint pin) { (void)pin; }
+
+void gpio_put_masked(uint32_t mask, uint32_t value);
+static inline void gpio_set_mask(uint32_t mask) { gpio_put_masked(mask, mask); }
+static inline void gpio_clr_mask(uint32_t mask) { gpio_put_masked(mask, 0); }
+static inline void gpio_put(uint pin, bool value) { gpio_put_masked(1u << pin, (uint32_t)value << pin); }
+
+// Applies to what the pin reads, whatever drives it.
+void gpio_set_inover(uint pin, uint value);
+
+uint32_t gpio_get_all(void);
+static inline bool gpio_get(uint pin) { return (gpio_get_all() >> pin) & 1u; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HARDWARE_GPIO_H_ */
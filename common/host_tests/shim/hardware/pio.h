@@ -0,0 +1,106 @@
+#ifndef HOST_HARDWARE_PIO_H_
+#define HOST_HARDWARE_PIO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// PIO blocks run by the emulator of host_pio.c. The FIFOs are only
+// reachable through DMA and the pio_sm_* calls, as the firmwares use them.
+
+typedef struct {
+  volatile uint32_t txf[4];
+  volatile uint32_t rxf[4];
+} pio_hw_t;
+
+typedef pio_hw_t* PIO;
+
+extern pio_hw_t host_pio0_hw;
+extern pio_hw_t host_pio1_hw;
+#define pio0 (&host_pio0_hw)
+#define pio1 (&host_pio1_hw)
+
+typedef struct {
+  const uint16_t* instructions;
+  uint8_t length;
+  int8_t origin;
+} pio_program_t;
+
+typedef struct {
+  float clkdiv;
+  uint wrap_target;
+  uint wrap;
+  uint out_base;
+  uint out_count;
+  uint in_base;
+  bool out_shift_right;
+  bool in_shift_right;
+} pio_sm_config;
+
+enum pio_src_dest {
+  pio_pins = 0,
+  pio_x = 1,
+  pio_y = 2,
+  pio_null = 3,
+  pio_pindirs = 4,
+  pio_exec_mov = 4,
+  pio_status = 5,
+  pio_pc = 5,
+  pio_isr = 6,
+  pio_osr = 7,
+  pio_exec_out = 7,
+};
+
+static inline void sm_config_set_out_pins(pio_sm_config* c, uint base, uint count) {
+  c->out_base = base;
+  c->out_count = count;
+}
+static inline void sm_config_set_in_pins(pio_sm_config* c, uint base) { c->in_base = base; }
+static inline void sm_config_set_wrap(pio_sm_config* c, uint wrap_target, uint wrap) {
+  c->wrap_target = wrap_target;
+  c->wrap = wrap;
+}
+static inline void sm_config_set_clkdiv(pio_sm_config* c, float div) { c->clkdiv = div; }
+
+// Autopull and autopush are not emulated.
+static inline void sm_config_set_out_shift(pio_sm_config* c, bool shift_right, bool autopull, uint threshold) {
+  (void)autopull;
+  (void)threshold;
+  c->out_shift_right = shift_right;
+}
+static inline void sm_config_set_in_shift(pio_sm_config* c, bool shift_right, bool autopush, uint threshold) {
+  (void)autopush;
+  (void)threshold;
+  c->in_shift_right = shift_right;
+}
+
+static inline void pio_gpio_init(PIO pio, uint pin) {
+  (void)pio;
+  gpio_set_function(pin, GPIO_FUNC_PIO0);
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t* program);
+uint pio_add_program(PIO pio, const pio_program_t* program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config* config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+uint pio_encode_pull(bool if_empty, bool block);
+uint pio_encode_mov(enum pio_src_dest dest, enum pio_src_dest src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_HARDWARE_PIO_H_ */
@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_STRUCTS_SYSTICK_H_
+#define HOST_HARDWARE_STRUCTS_SYSTICK_H_
+
+#include <stdint.h>
+
+typedef struct {
+  volatile uint32_t csr;
+  volatile uint32_t rvr;
+  volatile uint32_t cvr;
+  volatile uint32_t calib;
+} systick_hw_t;
+
+// Counts clk_sys cycles of simulated time once enabled, so cycle probes read
+// the time the simulation advanced in between.
+extern systick_hw_t host_systick;
+#define systick_hw (&host_systick)
+
+#endif /* HOST_HARDWARE_STRUCTS_SYSTICK_H_ */
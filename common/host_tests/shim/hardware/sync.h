@@ -0,0 +1,14 @@
+#ifndef HOST_HARDWARE_SYNC_H_
+#define HOST_HARDWARE_SYNC_H_
+
+#include <stdint.h>
+
+// Callbacks run synchronously in the simulation, so there is nothing to
+// mask or to wait for.
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+static inline void __dmb(void) {}
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+
+#endif /* HOST_HARDWARE_SYNC_H_ */
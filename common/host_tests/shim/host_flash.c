@@ -0,0 +1,43 @@
+#include <string.h>
+
+#include "host_flash.h"
+
+static uint8_t s_flash[HOST_FLASH_MAX_SECTORS * CONFIG_STORE_SECTOR_SIZE];
+static config_store_flash_t s_region;
+static host_flash_hook_t s_hook;
+static void* s_hook_context;
+
+static uint32_t operation_bytes(uint32_t offset, const uint8_t* page, uint32_t len) {
+  return s_hook ? s_hook(offset, page, len, s_hook_context) : len;
+}
+
+static void flash_erase(uint32_t offset) {
+  memset(&s_flash[offset], 0xff, operation_bytes(offset, NULL, CONFIG_STORE_SECTOR_SIZE));
+}
+
+static void flash_program(uint32_t offset, const uint8_t* page) {
+  const uint32_t len = operation_bytes(offset, page, CONFIG_STORE_PAGE_SIZE);
+  for (uint32_t i = 0; i < len; i++)
+    s_flash[offset + i] &= page[i];
+}
+
+void host_flash_reset(void) {
+  memset(s_flash, 0xff, sizeof(s_flash));
+  s_hook = NULL;
+  s_hook_context = NULL;
+}
+
+void host_flash_set_hook(host_flash_hook_t hook, void* context) {
+  s_hook = hook;
+  s_hook_context = context;
+}
+
+const config_store_flash_t* host_flash_region(uint32_t sector_count) {
+  if (sector_count > HOST_FLASH_MAX_SECTORS) sector_count = HOST_FLASH_MAX_SECTORS;
+  s_region = (config_store_flash_t){s_flash, sector_count, flash_erase, flash_program};
+  return &s_region;
+}
+
+const uint8_t* host_flash_data(void) {
+  return s_flash;
+}
@@ -0,0 +1,39 @@
+#ifndef HOST_FLASH_H_
+#define HOST_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Simulated NOR flash for config_store: an erase sets a sector to 0xff and
+// programming a page can only clear bits, which config_store relies on
+// when it programs a page around earlier records. The contents survive
+// host_flash_region() calls, so a test reboots by calling
+// config_store_init() again.
+
+#define HOST_FLASH_MAX_SECTORS (8)
+
+// Called before each operation with page NULL for an erase. Returns how
+// many of its len bytes happen, so a test can cut the power part way.
+typedef uint32_t (*host_flash_hook_t)(uint32_t offset, const uint8_t* page, uint32_t len, void* context);
+
+// Erases the whole flash and removes the hook.
+void host_flash_reset(void);
+
+void host_flash_set_hook(host_flash_hook_t hook, void* context);
+
+// The first sector_count sectors, as config_store_init() takes them.
+const config_store_flash_t* host_flash_region(uint32_t sector_count);
+
+const uint8_t* host_flash_data(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FLASH_H_ */
@@ -0,0 +1,755 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_pio.h"
+#include "host_sim.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "pico/time.h"
+
+#define PIO_COUNT        (2)
+#define SM_COUNT         (4)
+#define INSTR_MEM_SIZE   (32)
+#define FIFO_DEPTH       (4)
+#define MAX_PROGRAMS     (4)
+
+typedef struct {
+  uint32_t data[FIFO_DEPTH];
+  uint32_t head;
+  uint32_t tail;
+} fifo_t;
+
+typedef struct {
+  PIO pio;
+  uint index;
+  bool claimed;
+  bool enabled;
+  bool clocked;
+  pio_sm_config config;
+  uint pc;
+  uint32_t x;
+  uint32_t y;
+  uint32_t isr;
+  uint32_t isr_count;
+  uint32_t osr;
+  uint32_t osr_count;     // Bits shifted out; 32 is empty
+  uint32_t delay;
+  fifo_t tx;
+  fifo_t rx;
+  repeating_timer_t timer;
+  host_pio_sm_stats_t stats;
+} sm_t;
+
+typedef struct {
+  uint16_t instr[INSTR_MEM_SIZE];
+  uint32_t used;
+  sm_t sm[SM_COUNT];
+} pio_t;
+
+typedef struct {
+  bool claimed;
+  bool busy;
+  dma_channel_config config;
+  uintptr_t read;
+  uintptr_t write;
+  uint32_t count;
+} dma_t;
+
+typedef struct {
+  char path[256];
+  char name[64];
+  uint16_t instr[INSTR_MEM_SIZE];
+  pio_program_t program;
+  uint wrap_target;
+  uint wrap;
+} program_t;
+
+pio_hw_t host_pio0_hw;
+pio_hw_t host_pio1_hw;
+
+static pio_t s_pio[PIO_COUNT];
+static dma_t s_dma[HOST_DMA_CHANNELS];
+static program_t s_programs[MAX_PROGRAMS];
+static uint32_t s_program_count;
+
+static void fail(const char* what, const char* detail) {
+  fprintf(stderr, "host_pio: %s%s%s\n", what, detail ? ": " : "", detail ? detail : "");
+  abort();
+}
+
+static pio_t* pio_of(PIO pio) {
+  return &s_pio[pio == pio1 ? 1 : 0];
+}
+
+static sm_t* sm_of(PIO pio, uint sm) {
+  return &pio_of(pio)->sm[sm];
+}
+
+void host_pio_reset(void) {
+  memset(s_pio, 0, sizeof(s_pio));
+  memset(s_dma, 0, sizeof(s_dma));
+  for (uint p = 0; p < PIO_COUNT; p++) {
+    for (uint i = 0; i < SM_COUNT; i++) {
+      s_pio[p].sm[i].pio = p ? pio1 : pio0;
+      s_pio[p].sm[i].index = i;
+    }
+  }
+}
+
+// Assembler
+
+typedef struct {
+  const char* name;
+  uint value;
+} operand_t;
+
+static const operand_t JmpConditions[] = {
+  {"!x", 1}, {"x--", 2}, {"!y", 3}, {"y--", 4}, {"x!=y", 5}, {"pin", 6}, {"!osre", 7},
+};
+static const operand_t InSources[] = {
+  {"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"isr", 6}, {"osr", 7},
+};
+static const operand_t OutDestinations[] = {
+  {"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"pindirs", 4}, {"pc", 5}, {"isr", 6},
+};
+static const operand_t MovDestinations[] = {
+  {"pins", 0}, {"x", 1}, {"y", 2}, {"pc", 5}, {"isr", 6}, {"osr", 7},
+};
+static const operand_t MovSources[] = {
+  {"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"status", 5}, {"isr", 6}, {"osr", 7},
+};
+static const operand_t SetDestinations[] = {
+  {"x", 1}, {"y", 2},
+};
+
+#define LOOKUP(table, token) lookup(table, sizeof(table) / sizeof(table[0]), token)
+
+static int lookup(const operand_t* table, uint32_t count, const char* token) {
+  for (uint32_t i = 0; i < count; i++)
+    if (token && strcmp(table[i].name, token) == 0) return (int)table[i].value;
+  return -1;
+}
+
+typedef struct {
+  char label[INSTR_MEM_SIZE][32];
+  uint label_addr[INSTR_MEM_SIZE];
+  uint label_count;
+} labels_t;
+
+static int parse_number(const char* token) {
+  if (!token) return -1;
+  char* end;
+  const long value = strtol(token, &end, 0);
+  return *end == '\0' ? (int)value : -1;
+}
+
+static int bit_count(const char* token) {
+  const int count = parse_number(token);
+  return count >= 1 && count <= 32 ? count & 0x1f : -1;
+}
+
+static int encode(char** tokens, uint count, labels_t const* labels, char const* line) {
+  const char* op = tokens[0];
+  const char* a = count > 1 ? tokens[1] : NULL;
+  const char* b = count > 2 ? tokens[2] : NULL;
+
+  if (strcmp(op, "nop") == 0) return 0xa000 | (2 << 5) | 2;
+
+  if (strcmp(op, "jmp") == 0) {
+    int condition = 0;
+    const char* target = a;
+    if (b) {
+      condition = LOOKUP(JmpConditions, a);
+      target = b;
+    }
+    int addr = parse_number(target);
+    for (uint i = 0; addr < 0 && i < labels->label_count; i++)
+      if (target && strcmp(labels->label[i], target) == 0) addr = (int)labels->label_addr[i];
+    if (condition < 0 || addr < 0) fail("bad jmp", line);
+    return (condition << 5) | addr;
+  }
+
+  if (strcmp(op, "in") == 0 || strcmp(op, "out") == 0) {
+    const bool in = op[0] == 'i';
+    const int place = in ? LOOKUP(InSources, a) : LOOKUP(OutDestinations, a);
+    const int bits = bit_count(b);
+    if (place < 0 || bits < 0) fail("bad in/out", line);
+    return ((in ? 2 : 3) << 13) | (place << 5) | bits;
+  }
+
+  if (strcmp(op, "push") == 0 || strcmp(op, "pull") == 0) {
+    const bool pull = op[1] == 'u' && op[2] == 'l';
+    int instr = 0x8000 | (pull ? 0x80 : 0) | 0x20;
+    for (uint i = 1; i < count; i++) {
+      if (strcmp(tokens[i], pull ? "ifempty" : "iffull") == 0) {
+        instr |= 0x40;
+      } else if (strcmp(tokens[i], "noblock") == 0) {
+        instr &= ~0x20;
+      } else if (strcmp(tokens[i], "block") != 0) {
+        fail("bad push/pull", line);
+      }
+    }
+    return instr;
+  }
+
+  if (strcmp(op, "mov") == 0) {
+    const int dest = LOOKUP(MovDestinations, a);
+    int operation = 0;
+    if (b && (b[0] == '!' || b[0] == '~')) {
+      operation = 1;
+      b++;
+    } else if (b && b[0] == ':' && b[1] == ':') {
+      operation = 2;
+      b += 2;
+    }
+    const int src = LOOKUP(MovSources, b);
+    if (dest < 0 || src < 0) fail("bad mov", line);
+    return 0xa000 | (dest << 5) | (operation << 3) | src;
+  }
+
+  if (strcmp(op, "set") == 0) {
+    const int dest = LOOKUP(SetDestinations, a);
+    const int value = parse_number(b);
+    if (dest < 0 || value < 0 || value > 31) fail("bad set", line);
+    return 0xe000 | (dest << 5) | value;
+  }
+
+  fail("unsupported instruction", line);
+  return -1;
+}
+
+// Splits an instruction line into tokens, taking off a trailing [delay].
+static uint tokenize(char* text, char** tokens, uint max_tokens, int* delay) {
+  *delay = 0;
+  char* bracket = strchr(text, '[');
+  if (bracket) {
+    *delay = parse_number(strtok(bracket + 1, "]"));
+    *bracket = '\0';
+  }
+  uint count = 0;
+  for (char* token = strtok(text, " \t,"); token && count < max_tokens; token = strtok(NULL, " \t,"))
+    tokens[count++] = token;
+  return count;
+}
+
+static char* trim(char* text) {
+  char* comment = strchr(text, ';');
+  if (comment) *comment = '\0';
+  comment = strstr(text, "//");
+  if (comment) *comment = '\0';
+  while (isspace((unsigned char)*text)) text++;
+  char* end = text + strlen(text);
+  while (end > text && isspace((unsigned char)end[-1])) *--end = '\0';
+  return text;
+}
+
+// Takes a label off the front of the line; returns the rest.
+static char* take_label(char* text, labels_t* labels, uint addr) {
+  char* colon = strchr(text, ':');
+  if (!colon || (colon[1] == ':')) return text;
+  for (char* c = text; c < colon; c++)
+    if (!isalnum((unsigned char)*c) && *c != '_' && *c != ' ') return text;
+  *colon = '\0';
+  char* name = trim(text);
+  if (strncmp(name, "public ", 7) == 0) name = trim(name + 7);
+  if (labels && labels->label_count < INSTR_MEM_SIZE) {
+    snprintf(labels->label[labels->label_count], sizeof(labels->label[0]), "%s", name);
+    labels->label_addr[labels->label_count++] = addr;
+  }
+  return trim(colon + 1);
+}
+
+// Two passes over the program's lines: labels first, then instructions.
+static void assemble(program_t* program, FILE* file) {
+  labels_t labels = {0};
+  char line[256];
+  for (int pass = 0; pass < 2; pass++) {
+    rewind(file);
+    bool inside = false;
+    bool in_block = false;
+    uint addr = 0;
+    while (fgets(line, sizeof(line), file)) {
+      char copy[256];
+      snprintf(copy, sizeof(copy), "%s", line);
+      char* text = trim(line);
+      if (in_block) {
+        in_block = strncmp(text, "%}", 2) != 0;
+        continue;
+      }
+      if (text[0] == '%') {
+        in_block = true;
+        continue;
+      }
+      if (strncmp(text, ".program", 8) == 0) {
+        inside = strcmp(trim(text + 8), program->name) == 0;
+        continue;
+      }
+      if (!inside || !*text) continue;
+
+      if (strcmp(text, ".wrap_target") == 0) {
+        program->wrap_target = addr;
+      } else if (strcmp(text, ".wrap") == 0) {
+        program->wrap = addr - 1;
+      } else if (text[0] == '.') {
+        fail("unsupported directive", trim(copy));
+      } else {
+        text = take_label(text, pass == 0 ? &labels : NULL, addr);
+        if (!*text) continue;
+        if (addr == INSTR_MEM_SIZE) fail("program too long", program->name);
+        if (pass == 1) {
+          char* tokens[8];
+          int delay;
+          const uint count = tokenize(text, tokens, 8, &delay);
+          if (delay < 0 || delay > 31) fail("bad delay", trim(copy));
+          program->instr[addr] = (uint16_t)(encode(tokens, count, &labels, trim(copy)) | delay << 8);
+        }
+        addr++;
+      }
+    }
+    program->program.length = (uint8_t)addr;
+  }
+  if (program->program.length == 0) fail("no such program", program->name);
+  if (program->wrap == 0 && program->wrap_target == 0) program->wrap = program->program.length - 1u;
+}
+
+const pio_program_t* host_pio_program(const char* path, const char* name) {
+  for (uint32_t i = 0; i < s_program_count; i++)
+    if (strcmp(s_programs[i].path, path) == 0 && strcmp(s_programs[i].name, name) == 0)
+      return &s_programs[i].program;
+  if (s_program_count == MAX_PROGRAMS) fail("too many programs", name);
+
+  FILE* file = fopen(path, "r");
+  if (!file) fail("cannot open", path);
+  program_t* program = &s_programs[s_program_count++];
+  memset(program, 0, sizeof(*program));
+  snprintf(program->path, sizeof(program->path), "%s", path);
+  snprintf(program->name, sizeof(program->name), "%s", name);
+  program->program.instructions = program->instr;
+  program->program.origin = -1;
+  assemble(program, file);
+  fclose(file);
+  return &program->program;
+}
+
+pio_sm_config host_pio_get_default_config(const pio_program_t* program, uint offset) {
+  pio_sm_config config = {0};
+  config.clkdiv = 1.0f;
+  config.out_shift_right = true;
+  config.in_shift_right = true;
+  for (uint32_t i = 0; i < s_program_count; i++) {
+    if (&s_programs[i].program == program)
+      sm_config_set_wrap(&config, offset + s_programs[i].wrap_target, offset + s_programs[i].wrap);
+  }
+  return config;
+}
+
+host_pio_sm_stats_t host_pio_sm_stats(PIO pio, uint sm) {
+  return sm_of(pio, sm)->stats;
+}
+
+// Program memory and state machines
+
+static uint32_t program_mask(const pio_program_t* program, uint offset) {
+  return (uint32_t)(((1ull << program->length) - 1) << offset);
+}
+
+static int find_offset(pio_t const* pio, const pio_program_t* program) {
+  if (program->origin >= 0)
+    return (pio->used & program_mask(program, (uint)program->origin)) ? -1 : program->origin;
+  for (int offset = INSTR_MEM_SIZE - program->length; offset >= 0; offset--)
+    if (!(pio->used & program_mask(program, (uint)offset))) return offset;
+  return -1;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t* program) {
+  return find_offset(pio_of(pio), program) >= 0;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t* program) {
+  pio_t* state = pio_of(pio);
+  const int offset = find_offset(state, program);
+  if (offset < 0) fail("no room for program", NULL);
+  for (uint i = 0; i < program->length; i++) {
+    uint16_t instr = program->instructions[i];
+    if ((instr >> 13) == 0) instr += (uint16_t)offset;  // Relocate jmp targets
+    state->instr[offset + i] = instr;
+  }
+  state->used |= program_mask(program, (uint)offset);
+  return (uint)offset;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+  pio_t* state = pio_of(pio);
+  for (uint i = 0; i < SM_COUNT; i++) {
+    if (state->sm[i].claimed) continue;
+    state->sm[i].claimed = true;
+    return (int)i;
+  }
+  if (required) fail("no free state machine", NULL);
+  return -1;
+}
+
+static bool fifo_empty(fifo_t const* fifo) {
+  return fifo->head == fifo->tail;
+}
+
+static bool fifo_full(fifo_t const* fifo) {
+  return fifo->tail - fifo->head == FIFO_DEPTH;
+}
+
+static void fifo_push(fifo_t* fifo, uint32_t value) {
+  fifo->data[fifo->tail++ % FIFO_DEPTH] = value;
+}
+
+static uint32_t fifo_pop(fifo_t* fifo) {
+  return fifo->data[fifo->head++ % FIFO_DEPTH];
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config* config) {
+  sm_t* state = sm_of(pio, sm);
+  state->enabled = false;
+  state->config = *config;
+  memset(&state->tx, 0, sizeof(state->tx));
+  memset(&state->rx, 0, sizeof(state->rx));
+  state->isr = 0;
+  state->isr_count = 0;
+  state->osr = 0;
+  state->osr_count = 32;
+  state->delay = 0;
+  state->pc = initial_pc;
+}
+
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+  (void)pio;
+  (void)sm;
+  for (uint i = 0; i < pin_count; i++)
+    gpio_set_dir((pin_base + i) % 32, is_out);
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+  sm_t* state = sm_of(pio, sm);
+  if (fifo_full(&state->tx)) fail("TX FIFO full in pio_sm_put_blocking", NULL);
+  fifo_push(&state->tx, data);
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+  return (pio == pio1 ? DREQ_PIO1_TX0 : DREQ_PIO0_TX0) + (is_tx ? 0 : 4) + sm;
+}
+
+uint pio_encode_pull(bool if_empty, bool block) {
+  return 0x8080 | (if_empty ? 0x40 : 0) | (block ? 0x20 : 0);
+}
+
+uint pio_encode_mov(enum pio_src_dest dest, enum pio_src_dest src) {
+  return 0xa000 | ((uint)dest & 7) << 5 | ((uint)src & 7);
+}
+
+// Execution
+
+static uint32_t rotate_right(uint32_t value, uint shift) {
+  shift &= 31;
+  return shift ? value >> shift | value << (32 - shift) : value;
+}
+
+static uint32_t read_pins(sm_t const* sm) {
+  return rotate_right(gpio_get_all(), sm->config.in_base);
+}
+
+static void write_pins(sm_t const* sm, uint32_t value) {
+  const uint count = sm->config.out_count;
+  const uint32_t bits = count >= 32 ? ~0u : (1u << count) - 1;
+  const uint shift = 32 - sm->config.out_base % 32;
+  gpio_put_masked(rotate_right(bits, shift), rotate_right(value & bits, shift));
+}
+
+static void write_pindirs(sm_t const* sm, uint32_t value) {
+  for (uint i = 0; i < sm->config.out_count; i++)
+    gpio_set_dir((sm->config.out_base + i) % 32, (value >> i) & 1u);
+}
+
+static uint32_t shift_out(sm_t* sm, uint bits) {
+  uint32_t data;
+  if (bits == 32) {
+    data = sm->osr;
+    sm->osr = 0;
+  } else if (sm->config.out_shift_right) {
+    data = sm->osr & ((1u << bits) - 1);
+    sm->osr >>= bits;
+  } else {
+    data = sm->osr >> (32 - bits);
+    sm->osr <<= bits;
+  }
+  sm->osr_count = sm->osr_count + bits > 32 ? 32 : sm->osr_count + bits;
+  return data;
+}
+
+static void shift_in(sm_t* sm, uint32_t data, uint bits) {
+  if (bits == 32) {
+    sm->isr = data;
+  } else {
+    data &= (1u << bits) - 1;
+    sm->isr = sm->config.in_shift_right ? (sm->isr >> bits) | (data << (32 - bits)) : (sm->isr << bits) | data;
+  }
+  sm->isr_count = sm->isr_count + bits > 32 ? 32 : sm->isr_count + bits;
+}
+
+static uint32_t bit_reverse(uint32_t value) {
+  uint32_t reversed = 0;
+  for (uint i = 0; i < 32; i++)
+    reversed |= ((value >> i) & 1u) << (31 - i);
+  return reversed;
+}
+
+// Returns false while the instruction stalls. Sets *jumped when it wrote
+// the program counter.
+static bool execute(sm_t* sm, uint16_t instr, bool* jumped) {
+  const uint arg1 = (instr >> 5) & 7;
+  const uint arg2 = instr & 0x1f;
+  const uint bits = arg2 ? arg2 : 32;
+  *jumped = false;
+
+  switch (instr >> 13) {
+  case 0: {
+    bool take = false;
+    switch (arg1) {
+    case 0: take = true; break;
+    case 1: take = sm->x == 0; break;
+    case 2: take = sm->x-- != 0; break;
+    case 3: take = sm->y == 0; break;
+    case 4: take = sm->y-- != 0; break;
+    case 5: take = sm->x != sm->y; break;
+    case 7: take = sm->osr_count < 32; break;
+    default: fail("jmp pin is not emulated", NULL);
+    }
+    if (take) {
+      sm->pc = arg2;
+      *jumped = true;
+    }
+    return true;
+  }
+
+  case 2: {
+    const uint32_t sources[8] = {read_pins(sm), sm->x, sm->y, 0, 0, 0, sm->isr, sm->osr};
+    shift_in(sm, sources[arg1], bits);
+    return true;
+  }
+
+  case 3: {
+    const uint32_t data = shift_out(sm, bits);
+    switch (arg1) {
+    case 0: write_pins(sm, data); break;
+    case 1: sm->x = data; break;
+    case 2: sm->y = data; break;
+    case 3: break;
+    case 4: write_pindirs(sm, data); break;
+    case 5: sm->pc = data & 31; *jumped = true; break;
+    case 6: sm->isr = data; sm->isr_count = bits; break;
+    default: fail("out exec is not emulated", NULL);
+    }
+    return true;
+  }
+
+  case 4:
+    if (instr & 0x80) {
+      if ((instr & 0x40) && sm->osr_count < 32) return true;
+      if (fifo_empty(&sm->tx)) {
+        if (instr & 0x20) return false;
+        sm->osr = sm->x;
+      } else {
+        sm->osr = fifo_pop(&sm->tx);
+        sm->stats.pulls++;
+      }
+      sm->osr_count = 0;
+    } else {
+      if ((instr & 0x40) && sm->isr_count < 32) return true;
+      if (fifo_full(&sm->rx)) {
+        if (instr & 0x20) return false;
+      } else {
+        fifo_push(&sm->rx, sm->isr);
+        sm->stats.pushes++;
+      }
+      sm->isr = 0;
+      sm->isr_count = 0;
+    }
+    return true;
+
+  case 5: {
+    const uint32_t sources[8] = {read_pins(sm), sm->x, sm->y, 0, 0, 0, sm->isr, sm->osr};
+    uint32_t value = sources[instr & 7];
+    if (((instr >> 3) & 3) == 1) value = ~value;
+    if (((instr >> 3) & 3) == 2) value = bit_reverse(value);
+    switch (arg1) {
+    case 0: write_pins(sm, value); break;
+    case 1: sm->x = value; break;
+    case 2: sm->y = value; break;
+    case 5: sm->pc = value & 31; *jumped = true; break;
+    case 6: sm->isr = value; sm->isr_count = 0; break;
+    case 7: sm->osr = value; sm->osr_count = 0; break;
+    default: fail("mov exec is not emulated", NULL);
+    }
+    return true;
+  }
+
+  case 7:
+    if (arg1 == 1) {
+      sm->x = arg2;
+    } else if (arg1 == 2) {
+      sm->y = arg2;
+    } else {
+      fail("set pins is not emulated", NULL);
+    }
+    return true;
+  }
+  fail("wait is not emulated", NULL);
+  return true;
+}
+
+void pio_sm_exec(PIO pio, uint sm, uint instr) {
+  sm_t* state = sm_of(pio, sm);
+  bool jumped;
+  if (!execute(state, (uint16_t)instr, &jumped)) fail("pio_sm_exec stalled", NULL);
+}
+
+// DMA
+
+static fifo_t* pio_fifo_at(uintptr_t address, bool tx) {
+  for (uint p = 0; p < PIO_COUNT; p++) {
+    pio_hw_t* hw = p ? pio1 : pio0;
+    for (uint i = 0; i < SM_COUNT; i++) {
+      if (address == (uintptr_t)(tx ? &hw->txf[i] : &hw->rxf[i]))
+        return tx ? &s_pio[p].sm[i].tx : &s_pio[p].sm[i].rx;
+    }
+  }
+  return NULL;
+}
+
+static uintptr_t advance(uintptr_t address, uint size, uint ring_bits) {
+  if (ring_bits == 0) return address + size;
+  const uintptr_t mask = ((uintptr_t)1 << ring_bits) - 1;
+  return (address & ~mask) | ((address + size) & mask);
+}
+
+// Moves one element if the DREQ allows it.
+static bool dma_step(dma_t* channel) {
+  fifo_t* source = pio_fifo_at(channel->read, false);
+  fifo_t* target = pio_fifo_at(channel->write, true);
+  if ((source && fifo_empty(source)) || (target && fifo_full(target))) return false;
+  if (!source && !target) return false;  // Only PIO DREQs are emulated
+
+  const uint size = 1u << channel->config.size;
+  uint32_t value = 0;
+  if (source) {
+    value = fifo_pop(source);
+  } else {
+    memcpy(&value, (const void*)channel->read, size);
+  }
+  if (target) {
+    fifo_push(target, value);
+  } else {
+    memcpy((void*)channel->write, &value, size);
+  }
+
+  const dma_channel_config* config = &channel->config;
+  if (config->read_increment)
+    channel->read = advance(channel->read, size, config->ring_write ? 0 : config->ring_bits);
+  if (config->write_increment)
+    channel->write = advance(channel->write, size, config->ring_write ? config->ring_bits : 0);
+  channel->busy = --channel->count > 0;
+  return true;
+}
+
+static void dma_service(void) {
+  for (uint i = 0; i < HOST_DMA_CHANNELS; i++) {
+    while (s_dma[i].busy && dma_step(&s_dma[i])) {
+    }
+  }
+}
+
+int dma_claim_unused_channel(bool required) {
+  for (uint i = 0; i < HOST_DMA_CHANNELS; i++) {
+    if (s_dma[i].claimed) continue;
+    s_dma[i].claimed = true;
+    return (int)i;
+  }
+  if (required) fail("no free DMA channel", NULL);
+  return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+  (void)channel;
+  dma_channel_config config = {DMA_SIZE_32, true, false, false, 0, 0x3f};
+  return config;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint32_t transfer_count, bool trigger) {
+  dma_t* state = &s_dma[channel];
+  state->config = *config;
+  state->write = (uintptr_t)write_addr;
+  state->read = (uintptr_t)read_addr;
+  state->count = transfer_count;
+  state->busy = trigger && transfer_count > 0;
+}
+
+void dma_start_channel_mask(uint32_t mask) {
+  for (uint i = 0; i < HOST_DMA_CHANNELS; i++)
+    if (mask & (1u << i)) s_dma[i].busy = s_dma[i].count > 0;
+}
+
+bool dma_channel_is_busy(uint channel) {
+  return s_dma[channel].busy;
+}
+
+// Clock
+
+static void step(sm_t* sm) {
+  dma_service();
+  sm->stats.cycles++;
+  if (sm->delay > 0) {
+    sm->delay--;
+    return;
+  }
+
+  const uint16_t instr = pio_of(sm->pio)->instr[sm->pc];
+  bool jumped;
+  if (!execute(sm, instr, &jumped)) {
+    sm->stats.stalls++;
+    return;
+  }
+  sm->delay = (instr >> 8) & 0x1f;
+  if (!jumped) sm->pc = sm->pc == sm->config.wrap ? sm->config.wrap_target : (sm->pc + 1) % INSTR_MEM_SIZE;
+  dma_service();
+}
+
+// One instruction per PIO clock; the simulated clock counts whole
+// microseconds, so clkdiv must make the PIO clock 1 MHz or slower. The
+// period follows clk_sys, as the divider does on the chip.
+static int64_t clock_period_us(sm_t const* sm) {
+  const double period_us = sm->config.clkdiv * 1e6 / clock_get_hz(clk_sys);
+  if (period_us < 0.999) fail("PIO clock faster than 1 MHz", NULL);
+  return (int64_t)(period_us + 0.5);
+}
+
+static bool on_clock(repeating_timer_t* timer) {
+  sm_t* sm = (sm_t*)timer->user_data;
+  if (!sm->enabled) {
+    sm->clocked = false;
+    return false;
+  }
+  step(sm);
+  timer->delay_us = -clock_period_us(sm);
+  return true;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+  sm_t* state = sm_of(pio, sm);
+  state->enabled = enabled;
+  if (!enabled || state->clocked) return;
+  state->clocked = add_repeating_timer_us(-clock_period_us(state), on_clock, state, &state->timer);
+}
+
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {
+  sm_of(pio, sm)->config.clkdiv = div;
+}
@@ -0,0 +1,47 @@
+#ifndef HOST_PIO_H_
+#define HOST_PIO_H_
+
+#include <stdint.h>
+
+#include "hardware/pio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// PIO emulator for the host tests.
+//
+// Programs are assembled from the firmware's .pio sources, so a test runs
+// the same instructions as the chip. The subset pioasm features the
+// firmwares use is understood: labels, .wrap_target and .wrap, delays, and
+// the jmp, in, out, push, pull, mov, set and nop instructions. Side-set,
+// wait and out/mov to exec stop the test with a message.
+//
+// Each enabled state machine executes one instruction per PIO clock on the
+// simulated clock, clk_sys / clkdiv, and DMA channels paced by its DREQs
+// move words in and out of its FIFOs before every instruction.
+
+// The named program of a .pio file, assembled on first use.
+const pio_program_t* host_pio_program(const char* path, const char* name);
+
+// What pioasm's <name>_program_get_default_config() sets: the wrap.
+pio_sm_config host_pio_get_default_config(const pio_program_t* program, uint offset);
+
+typedef struct {
+  uint64_t cycles;    // PIO clocks while enabled
+  uint64_t stalls;    // Clocks spent on a blocking push or pull
+  uint32_t pushes;
+  uint32_t pulls;
+} host_pio_sm_stats_t;
+
+host_pio_sm_stats_t host_pio_sm_stats(PIO pio, uint sm);
+
+// Called by host_sim_reset(): frees state machines, instruction memory and
+// DMA channels.
+void host_pio_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PIO_H_ */
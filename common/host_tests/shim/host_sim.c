@@ -0,0 +1,261 @@
+#include <string.h>
+
+#include "host_sim.h"
+#include "host_pio.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "bsp/board.h"
+
+#define MAX_TIMERS (16)
+
+typedef struct {
+  bool active;
+  uint64_t due_us;
+  alarm_callback_t alarm;         // One-shot alarm, or
+  repeating_timer_t* repeating;   // a repeating timer
+  void* user_data;
+} sim_timer_t;
+
+systick_hw_t host_systick;
+
+static uint64_t s_now_us;
+static uint32_t s_clock_hz = 125000000;
+static sim_timer_t s_timers[MAX_TIMERS];
+static uint32_t s_outputs;
+static uint32_t s_directions;
+static uint32_t s_inputs;
+static uint32_t s_inover_invert;
+static uint32_t s_inover_low;
+static uint32_t s_inover_high;
+static uint64_t s_changed_us[32];
+static host_sim_gpio_model_t s_model;
+static void* s_model_context;
+static bool s_board_button;
+static host_sim_adc_model_t s_adc_model;
+static void* s_adc_context;
+
+void host_sim_reset(void) {
+  s_now_us = 0;
+  s_clock_hz = 125000000;
+  memset(s_timers, 0, sizeof(s_timers));
+  s_outputs = 0;
+  s_directions = 0;
+  s_inputs = 0;
+  s_inover_invert = 0;
+  s_inover_low = 0;
+  s_inover_high = 0;
+  memset(s_changed_us, 0, sizeof(s_changed_us));
+  s_model = NULL;
+  s_model_context = NULL;
+  s_board_button = false;
+  s_adc_model = NULL;
+  s_adc_context = NULL;
+  memset((void*)&host_systick, 0, sizeof(host_systick));
+  host_pio_reset();
+}
+
+uint64_t host_sim_now_us(void) {
+  return s_now_us;
+}
+
+void host_sim_set_clock_hz(uint32_t hz) {
+  s_clock_hz = hz;
+}
+
+uint32_t clock_get_hz(enum clock_index clock) {
+  return clock == clk_sys ? s_clock_hz : 125000000;
+}
+
+uint64_t time_us_64(void) {
+  return s_now_us;
+}
+
+static int add_timer(uint64_t due_us, alarm_callback_t alarm, repeating_timer_t* repeating, void* user_data) {
+  for (int id = 0; id < MAX_TIMERS; id++) {
+    if (s_timers[id].active) continue;
+    s_timers[id] = (sim_timer_t){true, due_us, alarm, repeating, user_data};
+    return id;
+  }
+  return -1;
+}
+
+static void fire(int id) {
+  sim_timer_t* timer = &s_timers[id];
+  const uint64_t scheduled = timer->due_us;
+  timer->active = false;
+
+  if (timer->repeating) {
+    repeating_timer_t* repeating = timer->repeating;
+    if (!repeating->callback(repeating)) return;
+    if (!s_timers[id].active && repeating->alarm_id == id) {
+      // Negative delays keep a fixed period; callbacks take no time here.
+      const int64_t delay = repeating->delay_us < 0 ? -repeating->delay_us : repeating->delay_us;
+      *timer = (sim_timer_t){true, scheduled + (uint64_t)delay, NULL, repeating, NULL};
+    }
+    return;
+  }
+
+  const int64_t again = timer->alarm(id + 1, timer->user_data);
+  if (again < 0) {
+    *timer = (sim_timer_t){true, scheduled + (uint64_t)-again, timer->alarm, NULL, timer->user_data};
+  } else if (again > 0) {
+    *timer = (sim_timer_t){true, s_now_us + (uint64_t)again, timer->alarm, NULL, timer->user_data};
+  }
+}
+
+// An enabled SysTick counts clk_sys cycles down from rvr and wraps.
+static void set_now_us(uint64_t us) {
+  if (host_systick.csr & 1u) {
+    const uint64_t period = (uint64_t)host_systick.rvr + 1;
+    const uint64_t cycles = (us - s_now_us) * s_clock_hz / 1000000 % period;
+    host_systick.cvr = (uint32_t)((host_systick.cvr + period - cycles) % period);
+  }
+  s_now_us = us;
+}
+
+void host_sim_advance_us(uint64_t us) {
+  const uint64_t target = s_now_us + us;
+  for (;;) {
+    int next = -1;
+    for (int id = 0; id < MAX_TIMERS; id++) {
+      if (s_timers[id].active && s_timers[id].due_us <= target &&
+          (next < 0 || s_timers[id].due_us < s_timers[next].due_us))
+        next = id;
+    }
+    if (next < 0) break;
+    if (s_timers[next].due_us > s_now_us) set_now_us(s_timers[next].due_us);
+    fire(next);
+  }
+  set_now_us(target);
+}
+
+void sleep_us(uint64_t us) {
+  host_sim_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+  host_sim_advance_us(ms * 1000ull);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t t) {
+  if (t > s_now_us) host_sim_advance_us(t - s_now_us);
+  return true;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+  (void)fire_if_past;
+  const int id = add_timer(s_now_us + us, callback, NULL, user_data);
+  return id < 0 ? -1 : id + 1;
+}
+
+bool cancel_alarm(alarm_id_t id) {
+  if (id <= 0 || id > MAX_TIMERS || !s_timers[id - 1].active) return false;
+  s_timers[id - 1].active = false;
+  return true;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void* user_data, repeating_timer_t* out) {
+  const uint64_t delay = (uint64_t)(delay_us < 0 ? -delay_us : delay_us);
+  out->delay_us = delay_us;
+  out->pool = NULL;
+  out->callback = callback;
+  out->user_data = user_data;
+  out->alarm_id = add_timer(s_now_us + delay, NULL, out, NULL);
+  return out->alarm_id >= 0;
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer) {
+  if (timer->alarm_id < 0 || timer->alarm_id >= MAX_TIMERS) return false;
+  sim_timer_t* sim = &s_timers[timer->alarm_id];
+  const bool active = sim->active && sim->repeating == timer;
+  if (active) sim->active = false;
+  timer->alarm_id = -1;
+  return active;
+}
+
+void host_sim_gpio_set_model(host_sim_gpio_model_t model, void* context) {
+  s_model = model;
+  s_model_context = context;
+}
+
+void host_sim_gpio_set_input(uint32_t pin, bool level) {
+  s_inputs = (s_inputs & ~(1u << pin)) | ((uint32_t)level << pin);
+}
+
+uint32_t host_sim_gpio_outputs(void) {
+  return s_outputs & s_directions;
+}
+
+uint64_t host_sim_gpio_changed_us(uint32_t pin) {
+  return s_changed_us[pin];
+}
+
+void gpio_init(uint pin) {
+  gpio_init_mask(1u << pin);
+}
+
+void gpio_init_mask(uint32_t mask) {
+  s_directions &= ~mask;
+  s_outputs &= ~mask;
+}
+
+void gpio_set_dir(uint pin, bool out) {
+  if (out) {
+    s_directions |= 1u << pin;
+  } else {
+    s_directions &= ~(1u << pin);
+  }
+}
+
+void gpio_set_dir_out_masked(uint32_t mask) {
+  s_directions |= mask;
+}
+
+void gpio_set_dir_in_masked(uint32_t mask) {
+  s_directions &= ~mask;
+}
+
+void gpio_set_function(uint pin, enum gpio_function function) {
+  (void)pin;
+  (void)function;
+}
+
+void gpio_put_masked(uint32_t mask, uint32_t value) {
+  const uint32_t outputs = (s_outputs & ~mask) | (value & mask);
+  for (uint32_t changed = outputs ^ s_outputs; changed; changed &= changed - 1)
+    s_changed_us[__builtin_ctz(changed)] = s_now_us;
+  s_outputs = outputs;
+}
+
+void gpio_set_inover(uint pin, uint value) {
+  const uint32_t mask = 1u << pin;
+  s_inover_invert = value == GPIO_OVERRIDE_INVERT ? s_inover_invert | mask : s_inover_invert & ~mask;
+  s_inover_low = value == GPIO_OVERRIDE_LOW ? s_inover_low | mask : s_inover_low & ~mask;
+  s_inover_high = value == GPIO_OVERRIDE_HIGH ? s_inover_high | mask : s_inover_high & ~mask;
+}
+
+uint32_t gpio_get_all(void) {
+  const uint32_t outputs = s_outputs & s_directions;
+  const uint32_t inputs = s_model ? s_model(outputs, s_model_context) : s_inputs;
+  const uint32_t levels = outputs | (inputs & ~s_directions);
+  return ((levels ^ s_inover_invert) & ~s_inover_low) | s_inover_high;
+}
+
+void host_sim_board_button(bool pressed) {
+  s_board_button = pressed;
+}
+
+bool board_button_read(void) {
+  return s_board_button;
+}
+
+void host_sim_adc_set_model(host_sim_adc_model_t model, void* context) {
+  s_adc_model = model;
+  s_adc_context = context;
+}
+
+uint16_t adc_read(void) {
+  return s_adc_model ? s_adc_model(s_adc_context) : 0;
+}
@@ -0,0 +1,50 @@
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Simulated RP2040 for the host tests.
+//
+// The shim headers next to this one declare the Pico SDK calls the firmware
+// modules use, and host_sim.c implements them on a simulated clock. Time
+// only moves in host_sim_advance_us() (and sleep_*), which fires timers and
+// alarms at their due times in order, the way interrupts would preempt the
+// main loop. Callbacks take no simulated time.
+
+void host_sim_reset(void);
+
+uint64_t host_sim_now_us(void);
+void host_sim_advance_us(uint64_t us);
+
+// clk_sys as clock_get_hz() reports it. SysTick is not simulated, so
+// probes measure 0 cycles whatever the clock.
+void host_sim_set_clock_hz(uint32_t hz);
+
+// Level seen on input pins, given the output latch. Without a model the
+// pins read what host_sim_gpio_set_input() set.
+typedef uint32_t (*host_sim_gpio_model_t)(uint32_t outputs, void* context);
+void host_sim_gpio_set_model(host_sim_gpio_model_t model, void* context);
+void host_sim_gpio_set_input(uint32_t pin, bool level);
+
+uint32_t host_sim_gpio_outputs(void);
+// When the output latch of the pin last changed, for models with RC delays.
+uint64_t host_sim_gpio_changed_us(uint32_t pin);
+
+// What board_button_read() returns (the BOOTSEL button).
+void host_sim_board_button(bool pressed);
+
+// Result of each adc_read(), 12 bits plus the error flag in bit 15. Reads
+// 0 without a model.
+typedef uint16_t (*host_sim_adc_model_t)(void* context);
+void host_sim_adc_set_model(host_sim_adc_model_t model, void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_SIM_H_ */
@@ -0,0 +1,231 @@
+#include <string.h>
+
+#include "host_sim.h"
+#include "host_usb.h"
+#include "tusb.h"
+
+#define CDC_PACKET_SIZE (64)
+
+static uint64_t s_poll_us;
+static bool s_mounted;
+static bool s_suspended;
+static bool s_cdc_connected;
+
+static bool s_pending;
+static uint64_t s_pending_due_us;
+static uint8_t s_pending_report[1 + HOST_USB_HID_REPORT_SIZE];
+static uint8_t s_pending_len;
+
+static host_usb_report_t s_log[HOST_USB_LOG_SIZE];
+static uint32_t s_log_count;
+
+static uint32_t s_cdc_level;
+static uint8_t s_cdc_log[HOST_USB_CDC_LOG_SIZE];
+static uint32_t s_cdc_log_len;
+static uint64_t s_cdc_drained_ms;
+static uint32_t s_cdc_received;
+static uint32_t s_cdc_short_writes;
+static uint8_t s_cdc_rx[HOST_USB_CDC_RX_SIZE];
+static uint32_t s_cdc_rx_len;
+static uint32_t s_remote_wakeups;
+
+static host_usb_task_hook_t s_hook;
+static void* s_hook_context;
+
+__attribute__((weak)) void tud_mount_cb(void) {}
+__attribute__((weak)) void tud_umount_cb(void) {}
+__attribute__((weak)) void tud_resume_cb(void) {}
+__attribute__((weak)) void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len) {
+  (void)instance;
+  (void)report;
+  (void)len;
+}
+
+void host_usb_reset(uint32_t poll_interval_ms) {
+  s_poll_us = poll_interval_ms * 1000ull;
+  s_mounted = true;
+  s_suspended = false;
+  s_cdc_connected = false;
+  s_pending = false;
+  s_log_count = 0;
+  s_cdc_level = 0;
+  s_cdc_log_len = 0;
+  s_cdc_drained_ms = host_sim_now_us() / 1000;
+  s_cdc_received = 0;
+  s_cdc_short_writes = 0;
+  s_cdc_rx_len = 0;
+  s_remote_wakeups = 0;
+  s_hook = NULL;
+  s_hook_context = NULL;
+}
+
+void host_usb_set_task_hook(host_usb_task_hook_t hook, void* context) {
+  s_hook = hook;
+  s_hook_context = context;
+}
+
+void host_usb_set_mounted(bool mounted) {
+  if (mounted == s_mounted) return;
+  s_mounted = mounted;
+  s_pending = false;
+  if (mounted) {
+    tud_mount_cb();
+  } else {
+    tud_umount_cb();
+  }
+}
+
+void host_usb_set_suspended(bool suspended) {
+  if (suspended == s_suspended) return;
+  s_suspended = suspended;
+  if (!suspended) tud_resume_cb();
+}
+
+void host_usb_set_cdc_connected(bool connected) {
+  s_cdc_connected = connected;
+  s_cdc_level = 0;
+  s_cdc_rx_len = 0;
+}
+
+uint32_t host_usb_report_count(void) {
+  return s_log_count;
+}
+
+host_usb_report_t const* host_usb_report(uint32_t index) {
+  return index < s_log_count ? &s_log[index] : NULL;
+}
+
+uint32_t host_usb_cdc_log(uint8_t const** data) {
+  *data = s_cdc_log;
+  return s_cdc_log_len;
+}
+
+uint32_t host_usb_cdc_send(void const* data, uint32_t len) {
+  if (!tud_cdc_connected()) return 0;
+  const uint32_t room = HOST_USB_CDC_RX_SIZE - s_cdc_rx_len;
+  const uint32_t taken = len < room ? len : room;
+  memcpy(&s_cdc_rx[s_cdc_rx_len], data, taken);
+  s_cdc_rx_len += taken;
+  return taken;
+}
+
+uint32_t host_usb_cdc_received(void) {
+  return s_cdc_received;
+}
+
+uint32_t host_usb_cdc_short_writes(void) {
+  return s_cdc_short_writes;
+}
+
+uint32_t host_usb_remote_wakeups(void) {
+  return s_remote_wakeups;
+}
+
+void tusb_init(void) {}
+
+static void drain_cdc(void) {
+  const uint64_t now_ms = host_sim_now_us() / 1000;
+  if (s_cdc_connected) {
+    const uint64_t room = (now_ms - s_cdc_drained_ms) * CDC_PACKET_SIZE;
+    const uint32_t taken = room < s_cdc_level ? (uint32_t)room : s_cdc_level;
+    s_cdc_level -= taken;
+    s_cdc_received += taken;
+  }
+  s_cdc_drained_ms = now_ms;
+}
+
+void tud_task(void) {
+  drain_cdc();
+
+  if (s_pending && host_sim_now_us() >= s_pending_due_us) {
+    s_pending = false;
+    if (s_log_count < HOST_USB_LOG_SIZE) {
+      host_usb_report_t* logged = &s_log[s_log_count++];
+      logged->time_us = s_pending_due_us;
+      logged->report_id = s_pending_report[0];
+      logged->len = s_pending_len;
+      memcpy(logged->data, &s_pending_report[1], s_pending_len);
+    }
+    tud_hid_report_complete_cb(0, s_pending_report, (uint16_t)(s_pending_len + 1));
+  }
+
+  if (s_hook) s_hook(s_hook_context);
+}
+
+bool tud_mounted(void) {
+  return s_mounted;
+}
+
+bool tud_suspended(void) {
+  return s_suspended;
+}
+
+bool tud_remote_wakeup(void) {
+  if (!s_suspended) return false;
+  s_remote_wakeups++;
+  host_usb_set_suspended(false);
+  return true;
+}
+
+bool tud_hid_ready(void) {
+  return s_mounted && !s_suspended && !s_pending;
+}
+
+bool tud_hid_report(uint8_t report_id, void const* report, uint16_t len) {
+  if (!tud_hid_ready() || len > HOST_USB_HID_REPORT_SIZE) return false;
+  s_pending_report[0] = report_id;
+  memcpy(&s_pending_report[1], report, len);
+  s_pending_len = (uint8_t)len;
+  s_pending_due_us = (host_sim_now_us() / s_poll_us + 1) * s_poll_us;
+  s_pending = true;
+  return true;
+}
+
+bool tud_hid_keyboard_report(uint8_t report_id, uint8_t modifier, uint8_t const keycode[6]) {
+  uint8_t report[8] = {modifier};
+  if (keycode) memcpy(&report[2], keycode, 6);
+  return tud_hid_report(report_id, report, sizeof(report));
+}
+
+bool tud_hid_mouse_report(uint8_t report_id, uint8_t buttons, int8_t x, int8_t y, int8_t vertical, int8_t horizontal) {
+  const int8_t report[5] = {(int8_t)buttons, x, y, vertical, horizontal};
+  return tud_hid_report(report_id, report, sizeof(report));
+}
+
+bool tud_cdc_connected(void) {
+  return s_mounted && s_cdc_connected;
+}
+
+uint32_t tud_cdc_available(void) {
+  return tud_cdc_connected() ? s_cdc_rx_len : 0;
+}
+
+uint32_t tud_cdc_read(void* buffer, uint32_t bufsize) {
+  const uint32_t count = bufsize < tud_cdc_available() ? bufsize : tud_cdc_available();
+  memcpy(buffer, s_cdc_rx, count);
+  s_cdc_rx_len -= count;
+  memmove(s_cdc_rx, &s_cdc_rx[count], s_cdc_rx_len);
+  return count;
+}
+
+uint32_t tud_cdc_write_available(void) {
+  drain_cdc();
+  return tud_cdc_connected() ? HOST_USB_CDC_TX_SIZE - s_cdc_level : 0;
+}
+
+uint32_t tud_cdc_write(void const* buffer, uint32_t bufsize) {
+  const uint32_t room = tud_cdc_write_available();
+  const uint32_t written = bufsize < room ? bufsize : room;
+  if (written < bufsize) s_cdc_short_writes++;
+  s_cdc_level += written;
+
+  const uint32_t free = HOST_USB_CDC_LOG_SIZE - s_cdc_log_len;
+  const uint32_t logged = written < free ? written : free;
+  memcpy(&s_cdc_log[s_cdc_log_len], buffer, logged);
+  s_cdc_log_len += logged;
+  return written;
+}
+
+uint32_t tud_cdc_write_flush(void) {
+  return 0;
+}
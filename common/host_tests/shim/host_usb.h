@@ -0,0 +1,65 @@
+#ifndef HOST_USB_H_
+#define HOST_USB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Simulated USB host for the tusb.h shim.
+//
+// The HID endpoint holds one report at a time; the host takes it at the
+// next poll, a multiple of the polling interval on the simulated clock,
+// and tud_task() then logs it and calls tud_hid_report_complete_cb(), as
+// TinyUSB does. The CDC port has a TX FIFO of the firmware's size that the
+// host empties by one full-speed packet per millisecond, and an RX FIFO
+// that the test fills with host_usb_cdc_send().
+
+#define HOST_USB_HID_REPORT_SIZE  (16)    // CFG_TUD_HID_EP_BUFSIZE
+#define HOST_USB_CDC_TX_SIZE      (512)   // CFG_TUD_CDC_TX_BUFSIZE
+#define HOST_USB_CDC_RX_SIZE      (512)   // CFG_TUD_CDC_RX_BUFSIZE
+#define HOST_USB_LOG_SIZE         (4096)
+#define HOST_USB_CDC_LOG_SIZE     (65536)
+
+typedef struct {
+  uint64_t time_us;     // When the host polled it
+  uint8_t report_id;
+  uint8_t len;          // Without the report ID
+  uint8_t data[HOST_USB_HID_REPORT_SIZE];
+} host_usb_report_t;
+
+// Mounted, not suspended, CDC closed, empty log.
+void host_usb_reset(uint32_t poll_interval_ms);
+
+// Called at the end of every tud_task(), which is once per main loop of a
+// firmware; the hook is where a test moves time on and ends the run.
+typedef void (*host_usb_task_hook_t)(void* context);
+void host_usb_set_task_hook(host_usb_task_hook_t hook, void* context);
+
+void host_usb_set_mounted(bool mounted);
+void host_usb_set_suspended(bool suspended);
+void host_usb_set_cdc_connected(bool connected);
+
+uint32_t host_usb_report_count(void);
+host_usb_report_t const* host_usb_report(uint32_t index);
+
+// Bytes the firmware wrote to the CDC port, in order, up to
+// HOST_USB_CDC_LOG_SIZE of them.
+uint32_t host_usb_cdc_log(uint8_t const** data);
+
+// Host to device: queues bytes for tud_cdc_read() and returns how many
+// fit in the RX FIFO. Nothing arrives while the port is closed.
+uint32_t host_usb_cdc_send(void const* data, uint32_t len);
+
+// Bytes the host read from the CDC port, and writes that did not fit.
+uint32_t host_usb_cdc_received(void);
+uint32_t host_usb_cdc_short_writes(void);
+uint32_t host_usb_remote_wakeups(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_USB_H_ */
@@ -0,0 +1,44 @@
+#ifndef HOST_DFPLAYER_H_
+#define HOST_DFPLAYER_H_
+
+// Host stand-in for the pico-dfPlayerMini submodule: the CRTP base that
+// builds a command frame and hands it to the derived class's uartSend(),
+// and the command codes the firmware uses.
+
+#include <stdint.h>
+
+#define SERIAL_CMD_SIZE (10)
+
+namespace dfPlayer {
+
+constexpr uint8_t SPECIFY_PLAYBACK_SRC = 0x09;
+
+namespace cmd {
+constexpr uint8_t SPECIFY_VOL = 0x06;
+constexpr uint8_t SPECIFY_FOLDER_PLAYBACK = 0x0F;
+} // namespace cmd
+
+} // namespace dfPlayer
+
+// 7E FF 06 CMD FEEDBACK PARA1 PARA2 CHK_H CHK_L EF, the checksum making the
+// bytes from FF to PARA2 sum to zero.
+template <typename Derived>
+class DfPlayer
+{
+public:
+    void sendCmd(uint8_t cmd, uint16_t param)
+    {
+        uint8_t frame[SERIAL_CMD_SIZE] = {0x7E, 0xFF, 0x06, cmd, 0x00,
+            static_cast<uint8_t>(param >> 8), static_cast<uint8_t>(param & 0xff), 0, 0, 0xEF};
+        uint16_t sum = 0;
+        for (int index = 1; index <= 6; ++index) {
+            sum += frame[index];
+        }
+        const uint16_t checksum = 0 - sum;
+        frame[7] = checksum >> 8;
+        frame[8] = checksum & 0xff;
+        static_cast<Derived*>(this)->uartSend(frame);
+    }
+};
+
+#endif /* HOST_DFPLAYER_H_ */
@@ -0,0 +1,6 @@
+#ifndef HOST_PICO_BINARY_INFO_H_
+#define HOST_PICO_BINARY_INFO_H_
+
+#define bi_decl(...)
+
+#endif /* HOST_PICO_BINARY_INFO_H_ */
@@ -0,0 +1,21 @@
+#ifndef HOST_PICO_PLATFORM_H_
+#define HOST_PICO_PLATFORM_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned int uint;
+
+#define __time_critical_func(name) name
+#define __not_in_flash_func(name) name
+
+static inline uint get_core_num(void) { return 0; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PICO_PLATFORM_H_ */
@@ -0,0 +1,14 @@
+#ifndef HOST_PICO_STDLIB_H_
+#define HOST_PICO_STDLIB_H_
+
+// Host stand-in for the Pico SDK, see host_sim.h.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#endif /* HOST_PICO_STDLIB_H_ */
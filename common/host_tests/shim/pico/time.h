@@ -0,0 +1,63 @@
+#ifndef HOST_PICO_TIME_H_
+#define HOST_PICO_TIME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t absolute_time_t;
+typedef int32_t alarm_id_t;
+typedef struct alarm_pool alarm_pool_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void* user_data);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* rt);
+
+struct repeating_timer {
+  int64_t delay_us;
+  alarm_pool_t* pool;
+  alarm_id_t alarm_id;
+  repeating_timer_callback_t callback;
+  void* user_data;
+};
+
+uint64_t time_us_64(void);
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + ms * 1000ull; }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+// Nothing but the timeout wakes the simulated core, so this sleeps until t.
+bool best_effort_wfe_or_timeout(absolute_time_t t);
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void* user_data, bool fire_if_past);
+static inline alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+  return add_alarm_in_us(ms * 1000ull, callback, user_data, fire_if_past);
+}
+bool cancel_alarm(alarm_id_t id);
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void* user_data, repeating_timer_t* out);
+static inline bool alarm_pool_add_repeating_timer_us(alarm_pool_t* pool, int64_t delay_us,
+    repeating_timer_callback_t callback, void* user_data, repeating_timer_t* out) {
+  (void)pool;
+  return add_repeating_timer_us(delay_us, callback, user_data, out);
+}
+bool cancel_repeating_timer(repeating_timer_t* timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PICO_TIME_H_ */
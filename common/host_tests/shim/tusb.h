@@ -0,0 +1,98 @@
+#ifndef HOST_TUSB_H_
+#define HOST_TUSB_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The part of the TinyUSB device API the firmwares use, implemented by the
+// simulated host of host_usb.c. The firmware's tusb_config.h is read as
+// TinyUSB would, for the buffer sizes.
+
+#define OPT_MCU_RP2040        1900
+#define OPT_OS_NONE           1
+#define OPT_MODE_DEVICE       0x0001
+#define OPT_MODE_FULL_SPEED   0x0000
+#define OPT_MODE_HIGH_SPEED   0x0400
+#define CFG_TUSB_MCU          OPT_MCU_RP2040
+
+#if __has_include("tusb_config.h")
+#include "tusb_config.h"
+#endif
+
+enum {
+  KEYBOARD_MODIFIER_LEFTCTRL  = 1u << 0,
+  KEYBOARD_MODIFIER_LEFTSHIFT = 1u << 1,
+  KEYBOARD_MODIFIER_LEFTALT   = 1u << 2,
+  KEYBOARD_MODIFIER_LEFTGUI   = 1u << 3,
+};
+
+#define HID_KEY_A      0x04
+#define HID_KEY_B      0x05
+#define HID_KEY_C      0x06
+#define HID_KEY_D      0x07
+#define HID_KEY_E      0x08
+#define HID_KEY_H      0x0B
+#define HID_KEY_L      0x0F
+#define HID_KEY_O      0x12
+#define HID_KEY_T      0x17
+#define HID_KEY_V      0x19
+#define HID_KEY_Z      0x1D
+#define HID_KEY_ENTER  0x28
+#define HID_KEY_HOME   0x4A
+#define HID_KEY_END    0x4D
+
+#define HID_USAGE_CONSUMER_PLAY_PAUSE        0x00CD
+#define HID_USAGE_CONSUMER_VOLUME_INCREMENT  0x00E9
+#define HID_USAGE_CONSUMER_VOLUME_DECREMENT  0x00EA
+
+#define GAMEPAD_BUTTON_0  (1u << 0)
+#define GAMEPAD_BUTTON_1  (1u << 1)
+
+typedef enum {
+  HID_REPORT_TYPE_INVALID,
+  HID_REPORT_TYPE_INPUT,
+  HID_REPORT_TYPE_OUTPUT,
+  HID_REPORT_TYPE_FEATURE,
+} hid_report_type_t;
+
+typedef struct __attribute__((packed)) {
+  int8_t x, y, z, rz, rx, ry;
+  uint8_t hat;
+  uint32_t buttons;
+} hid_gamepad_report_t;
+
+void tusb_init(void);
+void tud_task(void);
+bool tud_mounted(void);
+bool tud_suspended(void);
+bool tud_remote_wakeup(void);
+
+bool tud_hid_ready(void);
+bool tud_hid_report(uint8_t report_id, void const* report, uint16_t len);
+bool tud_hid_keyboard_report(uint8_t report_id, uint8_t modifier, uint8_t const keycode[6]);
+bool tud_hid_mouse_report(uint8_t report_id, uint8_t buttons, int8_t x, int8_t y, int8_t vertical, int8_t horizontal);
+
+bool tud_cdc_connected(void);
+uint32_t tud_cdc_available(void);
+uint32_t tud_cdc_read(void* buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_available(void);
+uint32_t tud_cdc_write(void const* buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush(void);
+
+// Implemented by the firmware; host_usb.c has empty weak defaults.
+void tud_mount_cb(void);
+void tud_umount_cb(void);
+void tud_resume_cb(void);
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_TUSB_H_ */
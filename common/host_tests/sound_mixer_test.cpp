@@ -0,0 +1,178 @@
+// SoundMixer on the host: PCM voices sum with their gains and the volume
+// and clip at 16 bits, a fifth clip replaces the oldest voice, each voice
+// starts in the next buffer, and the ADPCM tones of the sound bank decode
+// at their pitch. The tones, played one after another and then as a chord,
+// are rendered to a WAV file (SOUND_MIXER_WAV) to listen to.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "host_test.h"
+#include "SoundBank.h"
+
+static constexpr uint32_t BufferSamples = 32; // One PwmSoundPlayer buffer
+
+static SoundClip pcmClip(const int16_t* samples, uint32_t count)
+{
+    return {SoundClip::Format::Pcm16, count, samples, 0, 0};
+}
+
+static void put16(FILE* file, uint16_t value)
+{
+    fputc(value & 0xff, file);
+    fputc(value >> 8, file);
+}
+
+static void put32(FILE* file, uint32_t value)
+{
+    put16(file, value & 0xffff);
+    put16(file, value >> 16);
+}
+
+// 16-bit mono PCM at the mixer's rate.
+static bool writeWav(const char* path, const std::vector<int16_t>& samples)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    const uint32_t dataBytes = static_cast<uint32_t>(samples.size() * 2);
+    fputs("RIFF", file);
+    put32(file, 36 + dataBytes);
+    fputs("WAVEfmt ", file);
+    put32(file, 16);
+    put16(file, 1); // PCM
+    put16(file, 1); // Mono
+    put32(file, SoundMixer::SampleRate);
+    put32(file, SoundMixer::SampleRate * 2);
+    put16(file, 2);
+    put16(file, 16);
+    fputs("data", file);
+    put32(file, dataBytes);
+    for (int16_t sample : samples) {
+        put16(file, static_cast<uint16_t>(sample));
+    }
+    return fclose(file) == 0;
+}
+
+static void checkMix()
+{
+    static const int16_t Low[64] = {1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000};
+    static int16_t High[64];
+    for (int16_t& sample : High) {
+        sample = 30000;
+    }
+    const SoundClip low = pcmClip(Low, 8);
+    const SoundClip high = pcmClip(High, 64);
+
+    SoundMixer mixer;
+    int16_t out[BufferSamples];
+    mixer.play(low, 1);
+    mixer.play(low, 2, SoundMixer::UnityGain / 2);
+    CHECK(mixer.render(out, BufferSamples) == 0x3);
+    CHECK(out[0] == 1500 && out[7] == 1500 && out[8] == 0);
+    CHECK(!mixer.active());
+
+    // The volume applies to the sum, which clips instead of wrapping.
+    mixer.setVolume(SoundMixer::UnityGain / 4);
+    mixer.play(low, 1);
+    mixer.render(out, BufferSamples);
+    CHECK(out[0] == 250);
+    mixer.setVolume(SoundMixer::UnityGain);
+    mixer.play(high, 1);
+    mixer.play(high, 2);
+    mixer.render(out, BufferSamples);
+    CHECK(out[0] == INT16_MAX);
+    mixer.stopAll();
+}
+
+static void checkVoices()
+{
+    static int16_t Long[1000];
+    const SoundClip clip = pcmClip(Long, 1000);
+
+    SoundMixer mixer;
+    int16_t out[BufferSamples];
+    for (uint8_t id = 1; id <= SoundMixer::Voices; ++id) {
+        CHECK(mixer.play(clip, id, SoundMixer::UnityGain, id * 100) == id - 1);
+    }
+    // Each voice starts in the buffer after play(), with its start time.
+    mixer.render(out, BufferSamples);
+    CHECK(mixer.startedVoices() == (1u << SoundMixer::Voices) - 1);
+    CHECK(mixer.voiceStartUs(2) == 300);
+    mixer.render(out, BufferSamples);
+    CHECK(mixer.startedVoices() == 0);
+
+    // A fifth clip takes the oldest voice.
+    CHECK(mixer.play(clip, 5) == 0);
+    CHECK(mixer.voiceId(0) == 5);
+    mixer.render(out, BufferSamples);
+    CHECK(mixer.startedVoices() == 1);
+    CHECK(mixer.play(clip, 6) == 1);
+}
+
+// Zero crossings of a tone give its frequency.
+static uint32_t frequencyOf(const std::vector<int16_t>& samples)
+{
+    uint32_t crossings = 0;
+    for (size_t index = 1; index < samples.size(); ++index) {
+        crossings += (samples[index - 1] < 0) != (samples[index] < 0);
+    }
+    return static_cast<uint32_t>(crossings * static_cast<uint64_t>(SoundMixer::SampleRate) / (2 * samples.size()));
+}
+
+static std::vector<int16_t> renderAll(SoundMixer& mixer)
+{
+    std::vector<int16_t> samples;
+    int16_t out[BufferSamples];
+    while (mixer.active()) {
+        mixer.render(out, BufferSamples);
+        samples.insert(samples.end(), out, out + BufferSamples);
+    }
+    return samples;
+}
+
+int main()
+{
+    checkMix();
+    checkVoices();
+
+    // convert_sounds.py made the bank from C5, E5, G5 and C6.
+    static const uint32_t Tones[] = {523, 659, 784, 1047};
+    std::vector<int16_t> wav;
+    SoundMixer mixer;
+    for (const SoundBankEntry& entry : SoundBank) {
+        mixer.play(entry.clip, entry.track);
+        const std::vector<int16_t> tone = renderAll(mixer);
+        CHECK(tone.size() >= entry.clip.sampleCount && tone.size() < entry.clip.sampleCount + BufferSamples);
+        const uint32_t expected = Tones[entry.track - 1];
+        const uint32_t measured = frequencyOf(tone);
+        CHECK(measured * 100 >= expected * 97 && measured * 100 <= expected * 103);
+        printf("sound_mixer tone %u:%u %u Hz (expected %u)\n", entry.folder, entry.track, measured, expected);
+        wav.insert(wav.end(), tone.begin(), tone.end());
+    }
+
+    mixer.setVolume(SoundMixer::UnityGain / 2);
+    for (const SoundBankEntry& entry : SoundBank) {
+        mixer.play(entry.clip, entry.track);
+    }
+    const std::vector<int16_t> chord = renderAll(mixer);
+    int32_t peak = 0;
+    for (int16_t sample : chord) {
+        peak = abs(sample) > peak ? abs(sample) : peak;
+    }
+    CHECK(peak > 0 && peak < INT16_MAX);
+    wav.insert(wav.end(), chord.begin(), chord.end());
+
+    CHECK(writeWav(SOUND_MIXER_WAV, wav));
+    FILE* file = fopen(SOUND_MIXER_WAV, "rb");
+    CHECK(file != nullptr);
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        CHECK(ftell(file) == static_cast<long>(44 + wav.size() * 2));
+        fclose(file);
+    }
+    printf("sound_mixer %zu samples (chord peak %d) written to %s\n", wav.size(), peak, SOUND_MIXER_WAV);
+    return HOST_TEST_RESULT();
+}
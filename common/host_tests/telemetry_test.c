@@ -0,0 +1,260 @@
+// button_and_volume telemetry on the simulated CDC port: frames carry SYNC,
+// type, length, payload and a checksum that sums to zero, they are batched
+// into 64-byte packets or sent once the first has waited 5 ms, host
+// commands are answered, and a stray SYNC or a corrupted length costs only
+// the bad frame, not the valid ones received after it, at the latest once
+// the partial frame timed out.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "host_usb.h"
+#include "host_flash.h"
+#include "adc_sampler.h"
+#include "config_store.h"
+#include "telemetry.h"
+
+#define FLUSH_MS      (5)
+#define RX_TIMEOUT_MS (20)
+#define INPUT_FRAME   (6 + TELEMETRY_FRAME_OVERHEAD)
+#define SETTING_KEY   (0x0123)
+
+typedef struct {
+  uint8_t type;
+  uint8_t len;
+  uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+} frame_t;
+
+// No ADC stream in these tests.
+uint32_t adc_sampler_copy(uint32_t* cursor, uint32_t* first, uint16_t* samples, uint32_t max_count, uint32_t step) {
+  (void)cursor;
+  (void)first;
+  (void)samples;
+  (void)max_count;
+  (void)step;
+  return 0;
+}
+
+static uint32_t s_read;   // Bytes of the CDC log already decoded
+
+static uint32_t cdc_log_len(void) {
+  uint8_t const* data;
+  return host_usb_cdc_log(&data);
+}
+
+// Decodes the next frame the device wrote, checking its framing.
+static bool next_frame(frame_t* frame) {
+  uint8_t const* data;
+  const uint32_t len = host_usb_cdc_log(&data);
+  if (s_read + TELEMETRY_FRAME_OVERHEAD > len) return false;
+
+  const uint8_t* at = &data[s_read];
+  CHECK(at[0] == TELEMETRY_SYNC);
+  CHECK(at[2] <= TELEMETRY_MAX_PAYLOAD);
+  CHECK(s_read + at[2] + TELEMETRY_FRAME_OVERHEAD <= len);
+  uint8_t sum = 0;
+  for (uint32_t i = 1; i < at[2] + (uint32_t)TELEMETRY_FRAME_OVERHEAD; i++)
+    sum += at[i];
+  CHECK(sum == 0);
+
+  frame->type = at[1];
+  frame->len = at[2];
+  memcpy(frame->payload, &at[3], at[2]);
+  s_read += at[2] + TELEMETRY_FRAME_OVERHEAD;
+  return true;
+}
+
+static uint32_t get_u32(const uint8_t* data) {
+  return data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+// Builds a host frame into out and returns its length.
+static uint32_t host_frame(uint8_t* out, uint8_t type, const uint8_t* payload, uint8_t len) {
+  out[0] = TELEMETRY_SYNC;
+  out[1] = type;
+  out[2] = len;
+  memcpy(&out[3], payload, len);
+  uint8_t sum = 0;
+  for (uint32_t i = 1; i < 3u + len; i++)
+    sum += out[i];
+  out[3 + len] = (uint8_t)(0 - sum);
+  return len + TELEMETRY_FRAME_OVERHEAD;
+}
+
+static void run_ms(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    host_sim_advance_us(1000);
+    telemetry_task();
+  }
+}
+
+static void check_framing(void) {
+  const input_state_t input = {.level = 42, .level_valid = true, .push_edge = true};
+  const uint32_t sent_ms = (uint32_t)(host_sim_now_us() / 1000);
+  telemetry_send_input(&input);
+
+  // A partly filled packet waits for more frames.
+  run_ms(FLUSH_MS - 1);
+  CHECK(cdc_log_len() == s_read);
+  run_ms(1);
+  CHECK(cdc_log_len() == s_read + INPUT_FRAME);
+
+  frame_t frame;
+  CHECK(next_frame(&frame));
+  CHECK(frame.type == TelemetryInput && frame.len == 6);
+  CHECK(get_u32(frame.payload) == sent_ms);
+  CHECK(frame.payload[4] == 42);
+  CHECK(frame.payload[5] == (TelemetryLevelValid | TelemetryPushEdge));
+}
+
+static void check_batching(void) {
+  const input_state_t input = {.level = 7};
+
+  // Six input frames fit in one packet; the seventh sends them.
+  for (uint32_t i = 0; i < TELEMETRY_PACKET_SIZE / INPUT_FRAME; i++)
+    telemetry_send_input(&input);
+  CHECK(cdc_log_len() == s_read);
+  telemetry_send_input(&input);
+  const uint32_t packet = TELEMETRY_PACKET_SIZE / INPUT_FRAME * INPUT_FRAME;
+  CHECK(cdc_log_len() == s_read + packet);
+  run_ms(FLUSH_MS);
+  CHECK(cdc_log_len() == s_read + packet + INPUT_FRAME);
+
+  // A frame that fills the packet goes out at once.
+  char text[TELEMETRY_MAX_PAYLOAD];
+  memset(text, 'x', sizeof(text));
+  telemetry_send_text(text, sizeof(text));
+  CHECK(cdc_log_len() == s_read + packet + INPUT_FRAME + TELEMETRY_PACKET_SIZE);
+
+  frame_t frame;
+  uint32_t inputs = 0;
+  while (next_frame(&frame) && frame.type == TelemetryInput)
+    inputs++;
+  CHECK(inputs == 7);
+  CHECK(frame.type == TelemetryText && frame.len == TELEMETRY_MAX_PAYLOAD);
+  CHECK(memcmp(frame.payload, text, sizeof(text)) == 0);
+}
+
+// Runs the device for ms and counts the Setting and Config answers.
+static void answers(uint32_t ms, uint32_t* settings, uint32_t* configs) {
+  run_ms(ms);
+  *settings = 0;
+  *configs = 0;
+  frame_t frame;
+  while (next_frame(&frame)) {
+    if (frame.type == TelemetrySetting) {
+      CHECK(frame.len == 6);
+      CHECK((frame.payload[0] | frame.payload[1] << 8) == SETTING_KEY);
+      (*settings)++;
+    } else if (frame.type == TelemetryConfig) {
+      CHECK(frame.len == 6);
+      (*configs)++;
+    }
+  }
+}
+
+// Sends bytes from the host and counts the answers: the bytes are read on
+// the first pass and the answers flushed FLUSH_MS later.
+static void exchange(const uint8_t* data, uint32_t len, uint32_t* settings, uint32_t* configs) {
+  CHECK(host_usb_cdc_send(data, len) == len);
+  answers(1 + FLUSH_MS, settings, configs);
+}
+
+static void check_commands(void) {
+  uint8_t bytes[3 * TELEMETRY_PACKET_SIZE];
+  uint32_t settings;
+  uint32_t configs;
+
+  // Store a setting: the answer is the value now held.
+  const uint8_t set[6] = {SETTING_KEY & 0xff, SETTING_KEY >> 8, 0x78, 0x56, 0x34, 0x12};
+  exchange(bytes, host_frame(bytes, TelemetrySetting, set, sizeof(set)), &settings, &configs);
+  uint32_t value = 0;
+  CHECK(config_store_get(SETTING_KEY, &value) && value == 0x12345678);
+  CHECK(settings == 1 && configs == 0);
+
+  // Streams and ADC step, answered with the dropped packet count.
+  const uint8_t config[2] = {TelemetryStreamInput, 2};
+  const uint32_t config_at = s_read;
+  exchange(bytes, host_frame(bytes, TelemetryConfig, config, sizeof(config)), &settings, &configs);
+  CHECK(configs == 1);
+  uint8_t const* data;
+  host_usb_cdc_log(&data);
+  CHECK(data[config_at + 3] == TelemetryStreamInput && data[config_at + 4] == 2);
+  CHECK(get_u32(&data[config_at + 5]) == 0);
+  CHECK(telemetry_enabled(TelemetryStreamInput) && !telemetry_enabled(TelemetryStreamTrace));
+
+  // A broken checksum is ignored.
+  uint32_t len = host_frame(bytes, TelemetryConfig, config, sizeof(config));
+  bytes[len - 1] ^= 1;
+  exchange(bytes, len, &settings, &configs);
+  CHECK(configs == 0);
+}
+
+static void check_resync(void) {
+  uint8_t bytes[3 * TELEMETRY_PACKET_SIZE];
+  uint32_t settings;
+  uint32_t configs;
+  const uint8_t config[2] = {TelemetryStreamInput | TelemetryStreamTrace, 4};
+  const uint8_t query[2] = {SETTING_KEY & 0xff, SETTING_KEY >> 8};
+
+  // A stray SYNC makes the real SYNC look like the type and the type like
+  // the length, longer than what follows: the frame is found once the
+  // partial one timed out.
+  uint32_t len = 0;
+  bytes[len++] = TELEMETRY_SYNC;
+  len += host_frame(&bytes[len], TelemetryConfig, config, sizeof(config));
+  exchange(bytes, len, &settings, &configs);
+  CHECK(configs == 0);
+  answers(RX_TIMEOUT_MS, &settings, &configs);
+  CHECK(configs == 1);
+  CHECK(telemetry_enabled(TelemetryStreamTrace));
+
+  // A corrupted length that still fits in a packet takes in the frames
+  // after it until its checksum fails.
+  len = 0;
+  bytes[len++] = TELEMETRY_SYNC;
+  bytes[len++] = TelemetrySetting;
+  bytes[len++] = 10;
+  bytes[len++] = 0x55;
+  len += host_frame(&bytes[len], TelemetryConfig, config, sizeof(config));
+  len += host_frame(&bytes[len], TelemetrySetting, query, sizeof(query));
+  exchange(bytes, len, &settings, &configs);
+  CHECK(configs == 1 && settings == 1);
+
+  // A length longer than any frame is dropped with only its header.
+  len = 0;
+  bytes[len++] = TELEMETRY_SYNC;
+  bytes[len++] = TelemetryConfig;
+  bytes[len++] = 200;
+  len += host_frame(&bytes[len], TelemetrySetting, query, sizeof(query));
+  exchange(bytes, len, &settings, &configs);
+  CHECK(configs == 0 && settings == 1);
+
+  // A frame split over two reads.
+  len = host_frame(bytes, TelemetryConfig, config, sizeof(config));
+  exchange(bytes, 3, &settings, &configs);
+  CHECK(configs == 0);
+  exchange(&bytes[3], len - 3, &settings, &configs);
+  CHECK(configs == 1);
+}
+
+int main(void) {
+  host_sim_reset();
+  host_usb_reset(1);
+  host_flash_reset();
+  config_store_init(host_flash_region(2));
+  host_usb_set_cdc_connected(true);
+  telemetry_init();
+  run_ms(1);
+
+  check_framing();
+  check_batching();
+  check_commands();
+  check_resync();
+
+  CHECK(host_usb_cdc_short_writes() == 0);
+  printf("telemetry %u bytes sent\n", cdc_log_len());
+  return HOST_TEST_RESULT();
+}
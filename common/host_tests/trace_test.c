@@ -0,0 +1,62 @@
+// trace: cycle counts are converted with the clock that ran when they were
+// recorded, even if it changed before trace_collect(), and long
+// microsecond probes print without wrapping.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "host_sim.h"
+#include "trace.h"
+
+enum {
+  ProbeCycles,
+  ProbeUs,
+};
+
+static char s_report[512];
+static uint32_t s_report_len = 0;
+
+static void write_report(const char* text, uint32_t len, void* context) {
+  (void)context;
+  if (s_report_len + len >= sizeof(s_report)) return;
+  memcpy(&s_report[s_report_len], text, len);
+  s_report_len += len;
+}
+
+int main(void) {
+  host_sim_reset();
+  trace_init();
+  trace_register(ProbeCycles, "cycles", TRACE_UNIT_CYCLES);
+  trace_register(ProbeUs, "us", TRACE_UNIT_US);
+
+  // 10 us at full speed, then 10 us after the idle mode slowed clk_sys,
+  // with the clock changing back before the rings are drained.
+  trace_record(ProbeCycles, 1250);
+  host_sim_set_clock_hz(48000000);
+  trace_record(ProbeCycles, 480);
+  trace_record(ProbeCycles, 480);
+  host_sim_set_clock_hz(125000000);
+  trace_record(ProbeCycles, 1250);
+  trace_collect();
+
+  trace_stats_t stats;
+  CHECK(trace_get_stats(ProbeCycles, &stats));
+  CHECK(stats.count == 4);
+  CHECK(stats.min == 10000 && stats.max == 10000);
+  CHECK(stats.sum == 40000);
+
+  // Past 2^32 ns once in nanoseconds.
+  trace_record(ProbeUs, 16000000);
+  trace_record(ProbeUs, 5);
+  trace_collect();
+  CHECK(trace_get_stats(ProbeUs, &stats));
+  CHECK(stats.max == 16000000);
+
+  trace_report(write_report, NULL);
+  printf("%s", s_report);
+  CHECK(strstr(s_report, "trace cycles n=4 min=10.00 max=10.00 mean=10.00 p99=10.00\r\n") != NULL);
+  CHECK(strstr(s_report, "trace us n=2 min=5.00 max=16000000.00 mean=8000002.50") != NULL);
+  CHECK(strstr(s_report, "trace dropped=0\r\n") != NULL);
+  return HOST_TEST_RESULT();
+}
@@ -0,0 +1,247 @@
+// volume_filter over noisy ADC traces: a knob at rest keeps its level, a
+// slow turn steps through the levels once each, and the cost per block is
+// measured on the host. The fixed-point path is also held against what it
+// replaced: the block mean against the per-sample loop, and the levels
+// against the float scaling hid_task() used to do, timing both.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "volume_filter.h"
+
+#define BLOCK_SAMPLES   (256)   // One DMA ring, as adc_sampler reads it
+#define REST_UPDATES    (2000)  // 20 s of 10 ms ticks
+#define SWEEP_UPDATES   (4000)
+
+// Level changes allowed while the knob rests: the first update settles on
+// the position, nothing after that.
+#define MAX_REST_CHANGES (1)
+
+static uint32_t s_seed = 12345;
+
+static uint32_t next_random(void) {
+  s_seed = s_seed * 1103515245u + 12345u;
+  return s_seed >> 16;
+}
+
+// One block of conversions around position: triangular noise of +-6
+// counts, an occasional spike, the RP2040 ADC's missing codes around
+// multiples of 512, and a few conversions with the error bit set.
+static void noisy_block(uint16_t* samples, int32_t position) {
+  for (uint32_t i = 0; i < BLOCK_SAMPLES; i++) {
+    int32_t value = position + (int32_t)(next_random() % 7) + (int32_t)(next_random() % 7) - 6;
+    if (next_random() % 100 == 0) value += (int32_t)(next_random() % 81) - 40;
+    if ((value & 511) == 511) value++;
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    samples[i] = (uint16_t)value;
+    if (next_random() % 200 == 0) samples[i] |= 0x8000u;
+  }
+}
+
+// The block mean before it took two samples per word.
+static bool scalar_block_mean(uint16_t const* samples, uint32_t count, uint16_t* mean) {
+  uint32_t sum = 0;
+  uint32_t valid = 0;
+  for (uint32_t index = 0; index < count; ++index) {
+    if (samples[index] & 0x8000) continue;
+    sum += samples[index];
+    valid++;
+  }
+  if (valid == 0) return false;
+  *mean = (uint16_t)(sum / valid);
+  return true;
+}
+
+// The level of a settled ADC value along the taper, in float.
+static uint8_t float_level(uint16_t value) {
+#if VOLUME_FILTER_TAPER == VOLUME_FILTER_TAPER_LINEAR
+  return (uint8_t)(value * 1.f / 4096 * (VOLUME_FILTER_LEVEL_MAX + 1));
+#else
+  // Inverse of value = 4096 * ln(1 + level * 99 / 101) / ln(100).
+  const double level = (exp(value / 4096.0 * log(100.0)) - 1) * (VOLUME_FILTER_LEVEL_MAX + 1) / 99;
+  return (uint8_t)(level < VOLUME_FILTER_LEVEL_MAX ? level : VOLUME_FILTER_LEVEL_MAX);
+#endif
+}
+
+// What hid_task() sent before volume_filter, from 0 to 99.
+static uint8_t former_float_level(uint16_t mean) {
+  return (uint8_t)(mean * 1.f / 4096 * 100);
+}
+
+static uint8_t feed(volume_filter_t* filter, int32_t position) {
+  uint16_t samples[BLOCK_SAMPLES];
+  uint16_t mean;
+  noisy_block(samples, position);
+  if (!volume_filter_block_mean(samples, BLOCK_SAMPLES, &mean)) return filter->level;
+  return volume_filter_update(filter, mean);
+}
+
+// Every resting position, including those on level boundaries.
+static uint32_t check_rest(void) {
+  uint32_t worst = 0;
+  for (int32_t position = 0; position < 4096; position += 3) {
+    volume_filter_t filter;
+    volume_filter_init(&filter);
+    uint8_t level = feed(&filter, position);
+    uint32_t changes = 0;
+    for (uint32_t update = 0; update < REST_UPDATES; update++) {
+      const uint8_t next = feed(&filter, position);
+      changes += next != level;
+      level = next;
+    }
+    if (changes > worst) worst = changes;
+    if (changes > MAX_REST_CHANGES) {
+      fprintf(stderr, "position %ld: %lu level changes at rest\n", (long)position, (unsigned long)changes);
+      host_test_failures++;
+    }
+    const int32_t expected = float_level((uint16_t)position);
+    CHECK(level + 1 >= expected && level <= expected + 1);
+  }
+  return worst;
+}
+
+// Any alignment, any count, error samples anywhere: the same mean.
+static void check_block_mean(void) {
+  static uint16_t buffer[BLOCK_SAMPLES + 2] __attribute__((aligned(4)));
+  uint32_t mismatches = 0;
+  for (uint32_t round = 0; round < 20; round++) {
+    for (uint32_t i = 0; i < BLOCK_SAMPLES + 2; i++) {
+      buffer[i] = (uint16_t)(next_random() % 4096);
+      if (next_random() % (round + 2) == 0) buffer[i] |= 0x8000u;
+    }
+    for (uint32_t offset = 0; offset < 2; offset++) {
+      for (uint32_t count = 0; count <= BLOCK_SAMPLES; count++) {
+        uint16_t expected = 0xffff;
+        uint16_t mean = 0xffff;
+        const bool expected_valid = scalar_block_mean(&buffer[offset], count, &expected);
+        const bool valid = volume_filter_block_mean(&buffer[offset], count, &mean);
+        mismatches += valid != expected_valid || (valid && mean != expected);
+      }
+    }
+  }
+  CHECK(mismatches == 0);
+}
+
+// A settled knob: the first reading of each ADC value gives the float level
+// of the curve, and within a step of the former 0 to 99 scale.
+static void check_float_levels(void) {
+  uint32_t off_by_one = 0;
+  for (uint32_t value = 0; value < 4096; value++) {
+    volume_filter_t filter;
+    volume_filter_init(&filter);
+    const uint8_t level = volume_filter_update(&filter, (uint16_t)value);
+    const int32_t expected = float_level((uint16_t)value);
+#if VOLUME_FILTER_TAPER == VOLUME_FILTER_TAPER_LINEAR
+    CHECK(level == expected);
+    CHECK(abs((int32_t)level - former_float_level((uint16_t)value)) <= 1);
+#else
+    // The table rounds each bound to a whole count.
+    CHECK(abs((int32_t)level - expected) <= 1);
+#endif
+    off_by_one += level != expected;
+  }
+  printf("volume_filter float comparison: %lu of 4096 values a step off\n", (unsigned long)off_by_one);
+}
+
+// A slow turn up and back down visits every level once each way.
+static void check_sweep(void) {
+  volume_filter_t filter;
+  volume_filter_init(&filter);
+  uint8_t level = feed(&filter, 0);
+  uint32_t rising = 0;
+  uint32_t falling = 0;
+  for (uint32_t update = 0; update <= 2 * SWEEP_UPDATES; update++) {
+    const uint32_t step = update <= SWEEP_UPDATES ? update : 2 * SWEEP_UPDATES - update;
+    const uint8_t next = feed(&filter, (int32_t)(step * 4095 / SWEEP_UPDATES));
+    if (update <= SWEEP_UPDATES) {
+      CHECK(next >= level);
+      rising += next != level;
+    } else {
+      CHECK(next <= level);
+      falling += next != level;
+    }
+    level = next;
+  }
+  CHECK(rising <= VOLUME_FILTER_LEVEL_MAX);
+  CHECK(falling <= VOLUME_FILTER_LEVEL_MAX);
+  CHECK(level == 0);
+}
+
+static void benchmark(void) {
+  static uint16_t samples[64][BLOCK_SAMPLES];
+  for (uint32_t block = 0; block < 64; block++) noisy_block(samples[block], (int32_t)(block * 64));
+
+  volume_filter_t filter;
+  volume_filter_init(&filter);
+  const uint32_t rounds = 2000;
+  uint32_t sink = 0;
+  const clock_t begin = clock();
+  for (uint32_t round = 0; round < rounds; round++) {
+    for (uint32_t block = 0; block < 64; block++) {
+      uint16_t mean = 0;
+      volume_filter_block_mean(samples[block], BLOCK_SAMPLES, &mean);
+      sink += volume_filter_update(&filter, mean);
+    }
+  }
+  const double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+  printf("volume_filter host: %.2f ns/sample, %.1f ns/block (sink %lu)\n",
+         seconds * 1e9 / ((double)rounds * 64 * BLOCK_SAMPLES), seconds * 1e9 / ((double)rounds * 64),
+         (unsigned long)sink);
+}
+
+typedef bool (*block_mean_t)(uint16_t const* samples, uint32_t count, uint16_t* mean);
+
+static double block_mean_ns(block_mean_t block_mean, uint16_t samples[][BLOCK_SAMPLES], uint32_t* sink) {
+  const uint32_t rounds = 2000;
+  const clock_t begin = clock();
+  for (uint32_t round = 0; round < rounds; round++) {
+    for (uint32_t block = 0; block < 64; block++) {
+      uint16_t mean = 0;
+      block_mean(samples[block], BLOCK_SAMPLES, &mean);
+      *sink += mean;
+    }
+  }
+  return (double)(clock() - begin) / CLOCKS_PER_SEC * 1e9 / ((double)rounds * 64 * BLOCK_SAMPLES);
+}
+
+// Before and after on the host. The RP2040 has no FPU, so the float
+// scaling costs far more there; the HID benchmark build times the block
+// mean on the device.
+static void benchmark_before_after(void) {
+  static uint16_t samples[64][BLOCK_SAMPLES] __attribute__((aligned(4)));
+  for (uint32_t block = 0; block < 64; block++) noisy_block(samples[block], (int32_t)(block * 64));
+
+  uint32_t sink = 0;
+  const double scalar_ns = block_mean_ns(scalar_block_mean, samples, &sink);
+  const double words_ns = block_mean_ns(volume_filter_block_mean, samples, &sink);
+
+  const uint32_t conversions = 4096 * 200;
+  volatile uint16_t input = 0;
+  clock_t begin = clock();
+  for (uint32_t i = 0; i < conversions; i++) sink += former_float_level((uint16_t)(input + i % 4096));
+  const double float_ns = (double)(clock() - begin) / CLOCKS_PER_SEC * 1e9 / conversions;
+
+  volume_filter_t filter;
+  volume_filter_init(&filter);
+  begin = clock();
+  for (uint32_t i = 0; i < conversions; i++) sink += volume_filter_update(&filter, (uint16_t)(input + i % 4096));
+  const double fixed_ns = (double)(clock() - begin) / CLOCKS_PER_SEC * 1e9 / conversions;
+
+  printf("volume_filter host before/after: block mean %.2f -> %.2f ns/sample, level float %.2f -> filter %.2f ns "
+         "(sink %lu)\n", scalar_ns, words_ns, float_ns, fixed_ns, (unsigned long)sink);
+}
+
+int main(void) {
+  const uint32_t worst = check_rest();
+  check_sweep();
+  check_block_mean();
+  check_float_levels();
+  benchmark();
+  benchmark_before_after();
+  printf("volume_filter taper=%d worst changes at rest=%lu\n", VOLUME_FILTER_TAPER, (unsigned long)worst);
+  return HOST_TEST_RESULT();
+}
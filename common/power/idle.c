@@ -0,0 +1,53 @@
+#include "idle.h"
+
+static void enter(idle_t* idle, idle_state_t state, uint32_t now_ms) {
+  idle->time_in_state_ms[idle->state] += now_ms - idle->state_since_ms;
+  idle->state = state;
+  idle->state_since_ms = now_ms;
+  if (state == IdleDormant)
+    idle->dormant_entries++;
+}
+
+void idle_init(idle_t* idle, const idle_config_t* config, uint32_t now_ms) {
+  idle->config = *config;
+  idle->state = IdleActive;
+  idle->last_activity_ms = now_ms;
+  idle->state_since_ms = now_ms;
+  for (uint32_t state = 0; state < IDLE_STATE_COUNT; state++)
+    idle->time_in_state_ms[state] = 0;
+  idle->dormant_entries = 0;
+}
+
+void idle_activity(idle_t* idle, uint32_t now_ms) {
+  idle->last_activity_ms = now_ms;
+  if (idle->state != IdleActive)
+    enter(idle, IdleActive, now_ms);
+}
+
+idle_state_t idle_next(idle_t* idle, uint32_t now_ms, bool dormant_allowed) {
+  const uint32_t quiet_ms = now_ms - idle->last_activity_ms;
+
+  idle_state_t state = IdleActive;
+  if (idle->config.dormant_after_ms && dormant_allowed && quiet_ms >= idle->config.dormant_after_ms)
+    state = IdleDormant;
+  else if (quiet_ms >= idle->config.slow_after_ms)
+    state = IdleSlow;
+
+  if (state != idle->state)
+    enter(idle, state, now_ms);
+  return state;
+}
+
+uint32_t idle_estimate_ua(idle_t const* idle, uint32_t now_ms) {
+  static const uint32_t CurrentUa[IDLE_STATE_COUNT] = {IDLE_ACTIVE_UA, IDLE_SLOW_UA, IDLE_DORMANT_UA};
+
+  uint64_t charge = 0;
+  uint64_t total_ms = 0;
+  for (uint32_t state = 0; state < IDLE_STATE_COUNT; state++) {
+    uint64_t ms = idle->time_in_state_ms[state];
+    if (state == idle->state) ms += now_ms - idle->state_since_ms;
+    charge += ms * CurrentUa[state];
+    total_ms += ms;
+  }
+  return total_ms ? (uint32_t)(charge / total_ms) : CurrentUa[idle->state];
+}
@@ -0,0 +1,82 @@
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Inactivity state machine shared by the firmwares.
+//
+// The logic is plain C on millisecond timestamps; idle_rp2040.c holds the
+// clock and dormant handling. Any activity returns to IdleActive at once.
+// After slow_after_ms without activity the system clock is reduced, and
+// after dormant_after_ms the chip may go dormant until a GPIO edge, but
+// only while the caller allows it (e.g. no VBUS, nothing playing). A
+// dormant chip cannot answer a host, so callers keep it awake while VBUS
+// is present, and VBUS rising wakes it.
+
+typedef enum {
+  IdleActive,
+  IdleSlow,
+  IdleDormant,
+  IDLE_STATE_COUNT
+} idle_state_t;
+
+typedef struct {
+  uint32_t slow_after_ms;
+  uint32_t dormant_after_ms;  // 0 never goes dormant
+} idle_config_t;
+
+typedef struct {
+  idle_config_t config;
+  idle_state_t state;
+  uint32_t last_activity_ms;
+  uint32_t state_since_ms;
+  uint32_t time_in_state_ms[IDLE_STATE_COUNT];
+  uint32_t dormant_entries;
+} idle_t;
+
+// Typical supply current of a Pico board per state, for estimates only.
+#ifndef IDLE_ACTIVE_UA
+#define IDLE_ACTIVE_UA   (25000)  // 125 MHz
+#endif
+#ifndef IDLE_SLOW_UA
+#define IDLE_SLOW_UA     (10000)  // 48 MHz
+#endif
+#ifndef IDLE_DORMANT_UA
+#define IDLE_DORMANT_UA  (1300)
+#endif
+
+void idle_init(idle_t* idle, const idle_config_t* config, uint32_t now_ms);
+
+// Key press, USB traffic and the like.
+void idle_activity(idle_t* idle, uint32_t now_ms);
+
+// The state the system should be in now.
+idle_state_t idle_next(idle_t* idle, uint32_t now_ms, bool dormant_allowed);
+
+// Mean supply current over the time observed so far. The timer stops while
+// dormant, so dormant periods are not part of the mean.
+uint32_t idle_estimate_ua(idle_t const* idle, uint32_t now_ms);
+
+// RP2040: applies IdleActive or IdleSlow to the system clock. Returns true
+// if the clock changed, so peripherals on clk_peri need their dividers set
+// again (e.g. uart_set_baudrate()).
+bool idle_set_clock(idle_state_t state);
+
+// RP2040: whether a host or charger supplies VBUS. Boards without a VBUS
+// sense pin (PICO_VBUS_PIN) report false.
+bool idle_vbus_present(void);
+
+// RP2040: stops the clocks until one of the pins sees the given edge, or
+// VBUS rises, then restores the full-speed clocks.
+void idle_dormant_until(uint32_t rise_mask, uint32_t fall_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IDLE_H_ */
@@ -0,0 +1,91 @@
+#include "idle.h"
+
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/pll.h"
+#include "hardware/xosc.h"
+
+#if PICO_SDK_VERSION_MAJOR >= 2
+#include "pico/runtime_init.h"
+#endif
+
+#define ACTIVE_SYS_KHZ  (125000)
+#define XOSC_HZ         (12 * MHZ)
+
+// The Pico senses VBUS on a GPIO through a divider; the Pico W only
+// through the wireless chip, which is not awake while dormant.
+#ifdef PICO_VBUS_PIN
+#define VBUS_MASK       (1u << PICO_VBUS_PIN)
+#else
+#define VBUS_MASK       (0u)
+#endif
+
+static idle_state_t s_clock_state = IdleActive;
+static bool s_vbus_ready = false;
+
+bool idle_set_clock(idle_state_t state) {
+  if (state == IdleDormant || state == s_clock_state) return false;
+
+  if (state == IdleSlow) {
+    // clk_sys and clk_peri from the USB PLL, which keeps running for USB.
+    set_sys_clock_48mhz();
+  } else {
+    set_sys_clock_khz(ACTIVE_SYS_KHZ, true);
+  }
+  s_clock_state = state;
+  return true;
+}
+
+bool idle_vbus_present(void) {
+#ifdef PICO_VBUS_PIN
+  if (!s_vbus_ready) {
+    gpio_init(PICO_VBUS_PIN);
+    s_vbus_ready = true;
+  }
+  return gpio_get(PICO_VBUS_PIN);
+#else
+  return false;
+#endif
+}
+
+static void restore_clocks(void) {
+#if PICO_SDK_VERSION_MAJOR >= 2
+  runtime_init_clocks();
+#else
+  clocks_init();
+#endif
+  s_clock_state = IdleActive;
+}
+
+void idle_dormant_until(uint32_t rise_mask, uint32_t fall_mask) {
+  // Everything runs from the crystal, which dormant mode then stops.
+  clock_configure(clk_ref, CLOCKS_CLK_REF_CTRL_SRC_VALUE_XOSC_CLKSRC, 0, XOSC_HZ, XOSC_HZ);
+  clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                  CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_XOSC_CLKSRC, XOSC_HZ, XOSC_HZ);
+  clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_XOSC_CLKSRC, XOSC_HZ, XOSC_HZ);
+  clock_stop(clk_usb);
+  clock_stop(clk_adc);
+  pll_deinit(pll_sys);
+  pll_deinit(pll_usb);
+
+  // A host plugged in while dormant gets a device that enumerates.
+  idle_vbus_present();
+  rise_mask |= VBUS_MASK;
+
+  for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+    const uint32_t events = ((rise_mask >> pin) & 1u ? GPIO_IRQ_EDGE_RISE : 0) |
+                            ((fall_mask >> pin) & 1u ? GPIO_IRQ_EDGE_FALL : 0);
+    if (events) gpio_set_dormant_irq_enabled(pin, events, true);
+  }
+
+  xosc_dormant();
+
+  for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+    if (((rise_mask | fall_mask) >> pin) & 1u) {
+      gpio_acknowledge_irq(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+      gpio_set_dormant_irq_enabled(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    }
+  }
+  restore_clocks();
+}
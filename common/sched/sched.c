@@ -0,0 +1,120 @@
+#include <stdio.h>
+
+#include "sched.h"
+
+static sched_task_t s_tasks[SCHED_MAX_TASKS];
+
+void sched_init(void) {
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++)
+    s_tasks[index].active = false;
+}
+
+static int add(const char* name, uint32_t period_ms, uint32_t deadline_ms, sched_fn_t fn, void* context,
+               uint32_t due_ms) {
+  for (int index = 0; index < SCHED_MAX_TASKS; index++) {
+    sched_task_t* task = &s_tasks[index];
+    if (task->active) continue;
+    task->name = name;
+    task->fn = fn;
+    task->context = context;
+    task->period_ms = period_ms;
+    task->deadline_ms = deadline_ms;
+    task->due_ms = due_ms;
+    task->runs = 0;
+    task->missed = 0;
+    task->max_late_ms = 0;
+    task->active = true;
+    return index;
+  }
+  return -1;
+}
+
+int sched_every(const char* name, uint32_t period_ms, uint32_t deadline_ms, sched_fn_t fn, void* context,
+                uint32_t now_ms) {
+  if (period_ms == 0) return -1;
+  return add(name, period_ms, deadline_ms, fn, context, now_ms + period_ms);
+}
+
+int sched_after(const char* name, uint32_t delay_ms, sched_fn_t fn, void* context, uint32_t now_ms) {
+  return add(name, 0, UINT32_MAX, fn, context, now_ms + delay_ms);
+}
+
+void sched_cancel(int task) {
+  if (task >= 0 && task < SCHED_MAX_TASKS)
+    s_tasks[task].active = false;
+}
+
+static void run_task(sched_task_t* task, uint32_t now_ms) {
+  const uint32_t late_ms = now_ms - task->due_ms;
+  task->runs++;
+  if (late_ms > task->max_late_ms) task->max_late_ms = late_ms;
+  if (late_ms > task->deadline_ms) task->missed++;
+
+  if (task->period_ms == 0) {
+    task->active = false;
+  } else {
+    // Whole periods already over are skipped, not caught up on.
+    task->due_ms += task->period_ms;
+    if ((int32_t)(now_ms - task->due_ms) >= 0) {
+      const uint32_t skipped = (now_ms - task->due_ms) / task->period_ms + 1;
+      task->missed += skipped;
+      task->due_ms += skipped * task->period_ms;
+    }
+  }
+
+  // Last, so the callback may cancel or re-add itself.
+  task->fn(late_ms, task->context);
+}
+
+uint32_t sched_run(uint32_t now_ms) {
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++) {
+    sched_task_t* task = &s_tasks[index];
+    if (task->active && (int32_t)(now_ms - task->due_ms) >= 0)
+      run_task(task, now_ms);
+  }
+
+  // Tasks added by the callbacks count too.
+  uint32_t wait_ms = UINT32_MAX;
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++) {
+    sched_task_t const* task = &s_tasks[index];
+    if (!task->active) continue;
+    const int32_t until = (int32_t)(task->due_ms - now_ms);
+    const uint32_t task_wait = until > 0 ? (uint32_t)until : 0;
+    if (task_wait < wait_ms) wait_ms = task_wait;
+  }
+  return wait_ms;
+}
+
+bool sched_get(int task, sched_task_t* out) {
+  if (task < 0 || task >= SCHED_MAX_TASKS || !s_tasks[task].active) return false;
+  *out = s_tasks[task];
+  return true;
+}
+
+uint32_t sched_missed(void) {
+  uint32_t missed = 0;
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++) {
+    if (s_tasks[index].active) missed += s_tasks[index].missed;
+  }
+  return missed;
+}
+
+void sched_reset_stats(void) {
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++) {
+    s_tasks[index].runs = 0;
+    s_tasks[index].missed = 0;
+    s_tasks[index].max_late_ms = 0;
+  }
+}
+
+void sched_report(sched_write_t write, void* context) {
+  char line[80];
+  for (uint32_t index = 0; index < SCHED_MAX_TASKS; index++) {
+    sched_task_t const* task = &s_tasks[index];
+    if (!task->active || task->period_ms == 0) continue;
+    const int len = snprintf(line, sizeof(line), "sched %s runs=%lu missed=%lu max_late=%lums\r\n",
+                             task->name ? task->name : "?", (unsigned long)task->runs,
+                             (unsigned long)task->missed, (unsigned long)task->max_late_ms);
+    if (len > 0) write(line, (uint32_t)len, context);
+  }
+}
@@ -0,0 +1,83 @@
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Cooperative scheduler for the main loop of the firmwares.
+//
+// Periodic tasks keep a fixed cadence: the next due time is the previous one
+// plus the period, not the time the task actually ran, so lateness does not
+// accumulate. A task that fell a whole period or more behind skips the
+// periods it missed instead of running them back to back, and each skipped
+// period counts as a missed deadline. A run later than its deadline after
+// the due time counts as missed too. One-shot tasks run once and free their
+// slot.
+//
+// sched.c is plain C on millisecond timestamps; sched_rp2040.c arms a
+// hardware alarm for the next due time so the loop can sleep in __wfe().
+// Not thread safe: add, cancel and run from one context only.
+
+#define SCHED_MAX_TASKS  (8)
+
+// late_ms is how long after its due time the task runs.
+typedef void (*sched_fn_t)(uint32_t late_ms, void* context);
+
+typedef struct {
+  const char* name;
+  sched_fn_t fn;
+  void* context;
+  uint32_t period_ms;     // 0 for a one-shot task
+  uint32_t deadline_ms;   // Allowed lateness
+  uint32_t due_ms;
+  uint32_t runs;
+  uint32_t missed;
+  uint32_t max_late_ms;
+  bool active;
+} sched_task_t;
+
+typedef void (*sched_write_t)(const char* text, uint32_t len, void* context);
+
+void sched_init(void);
+
+// Returns the task id, or -1 when all slots are taken. The first run is one
+// period after now_ms.
+int sched_every(const char* name, uint32_t period_ms, uint32_t deadline_ms, sched_fn_t fn, void* context,
+                uint32_t now_ms);
+
+// Runs fn once, delay_ms after now_ms.
+int sched_after(const char* name, uint32_t delay_ms, sched_fn_t fn, void* context, uint32_t now_ms);
+
+// Ids are reused once a task ends, so only cancel tasks known to be active.
+// A task may cancel itself.
+void sched_cancel(int task);
+
+// Runs every task that is due. Returns the time until the next due task,
+// UINT32_MAX when there is none.
+uint32_t sched_run(uint32_t now_ms);
+
+bool sched_get(int task, sched_task_t* out);
+
+// Missed deadlines of all tasks since sched_init() or sched_reset_stats().
+uint32_t sched_missed(void);
+void sched_reset_stats(void);
+
+// Writes one "sched" text line per active task.
+void sched_report(sched_write_t write, void* context);
+
+// RP2040: milliseconds since boot.
+uint32_t sched_now_ms(void);
+
+// RP2040: wakes the caller's __wfe() after wait_ms. Replaces the previous
+// alarm; UINT32_MAX cancels it.
+void sched_arm(uint32_t wait_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,29 @@
+#include "sched.h"
+
+#include "pico/time.h"
+
+static alarm_id_t s_alarm = 0;
+
+uint32_t sched_now_ms(void) {
+  return to_ms_since_boot(get_absolute_time());
+}
+
+// The alarm interrupt alone wakes __wfe(); nothing else to do.
+static int64_t on_alarm(alarm_id_t id, void* user_data) {
+  (void) id;
+  (void) user_data;
+  s_alarm = 0;
+  return 0;
+}
+
+void sched_arm(uint32_t wait_ms) {
+  if (s_alarm > 0) {
+    cancel_alarm(s_alarm);
+    s_alarm = 0;
+  }
+  if (wait_ms == UINT32_MAX) return;
+
+  // An alarm already in the past fires at once instead of being dropped.
+  const alarm_id_t alarm = add_alarm_in_ms(wait_ms, on_alarm, NULL, true);
+  if (alarm > 0) s_alarm = alarm;
+}
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "trace.h"
+
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"
+
+#define CORE_COUNT      (2)
+#define BUCKET_COUNT    (124) // Four per octave up to 32 bits
+#define PROBE_SHIFT     (24)
+// Ring word giving the clk_sys (kHz) of the cycle counts after it.
+#define CLOCK_MARKER    (0xff)
+
+typedef struct {
+  const char* name;
+  trace_unit_t unit;
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t buckets[BUCKET_COUNT];
+} probe_t;
+
+typedef struct {
+  uint32_t values[TRACE_RING_SIZE];
+  volatile uint32_t head;  // Written by the recording core
+  volatile uint32_t tail;  // Written by trace_collect()
+  uint32_t dropped;
+  uint32_t record_khz;     // Clock of the last marker written
+  uint32_t collect_khz;    // Clock of the last marker read
+} ring_t;
+
+static probe_t s_probes[TRACE_MAX_PROBES];
+static ring_t s_rings[CORE_COUNT];
+
+void trace_init(void) {
+  systick_hw->csr = 0;
+  systick_hw->rvr = TRACE_VALUE_MASK;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;  // Enable, processor clock, no interrupt
+}
+
+void trace_register(uint8_t probe, const char* name, trace_unit_t unit) {
+  if (probe >= TRACE_MAX_PROBES) return;
+  s_probes[probe].name = name;
+  s_probes[probe].unit = unit;
+}
+
+void __time_critical_func(trace_record)(uint8_t probe, uint32_t value) {
+  ring_t* ring = &s_rings[get_core_num()];
+  // SysTick runs from clk_sys, which the idle modes change, so a marker
+  // goes into the ring ahead of the first value after each change.
+  const uint32_t khz = clock_get_hz(clk_sys) / 1000;
+
+  // Interrupts on this core may record too; other cores use their own ring.
+  const uint32_t interrupts = save_and_disable_interrupts();
+  uint32_t head = ring->head;
+  const uint32_t needed = khz != ring->record_khz ? 2 : 1;
+  if (head - ring->tail <= TRACE_RING_SIZE - needed) {
+    if (needed == 2) {
+      ring->values[head++ % TRACE_RING_SIZE] = (uint32_t)CLOCK_MARKER << PROBE_SHIFT | (khz & TRACE_VALUE_MASK);
+      ring->record_khz = khz;
+    }
+    ring->values[head % TRACE_RING_SIZE] = (uint32_t)probe << PROBE_SHIFT | (value & TRACE_VALUE_MASK);
+    __dmb();
+    ring->head = head + 1;
+  } else {
+    ring->dropped++;
+  }
+  restore_interrupts(interrupts);
+}
+
+static uint32_t bucket_of(uint32_t value) {
+  if (value < 4) return value;
+  const uint32_t msb = 31 - __builtin_clz(value);
+  return 4 * (msb - 1) + ((value >> (msb - 2)) & 3);
+}
+
+static uint32_t bucket_upper(uint32_t bucket) {
+  if (bucket < 4) return bucket;
+  const uint32_t msb = bucket / 4 + 1;
+  const uint32_t sub = bucket % 4;
+  return ((5 + sub) << (msb - 2)) - 1;
+}
+
+// 2^24 cycles stay below 2^32 ns down to a 4 MHz clock.
+static uint32_t cycles_to_ns(uint32_t cycles, uint32_t khz) {
+  const uint64_t ns = (uint64_t)cycles * 1000000 / (khz ? khz : 1);
+  return ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+void trace_collect(void) {
+  for (uint32_t core = 0; core < CORE_COUNT; ++core) {
+    ring_t* ring = &s_rings[core];
+    uint32_t tail = ring->tail;
+    while (tail != ring->head) {
+      __dmb();
+      const uint32_t word = ring->values[tail % TRACE_RING_SIZE];
+      tail++;
+
+      if (word >> PROBE_SHIFT == CLOCK_MARKER) {
+        ring->collect_khz = word & TRACE_VALUE_MASK;
+        continue;
+      }
+      probe_t* probe = &s_probes[(word >> PROBE_SHIFT) % TRACE_MAX_PROBES];
+      const uint32_t value = probe->unit == TRACE_UNIT_CYCLES
+          ? cycles_to_ns(word & TRACE_VALUE_MASK, ring->collect_khz)
+          : word & TRACE_VALUE_MASK;
+      if (probe->count == 0 || value < probe->min) probe->min = value;
+      if (value > probe->max) probe->max = value;
+      probe->count++;
+      probe->sum += value;
+      probe->buckets[bucket_of(value)]++;
+    }
+    ring->tail = tail;
+  }
+}
+
+bool trace_get_stats(uint8_t probe, trace_stats_t* stats) {
+  if (probe >= TRACE_MAX_PROBES || s_probes[probe].count == 0) return false;
+
+  probe_t const* p = &s_probes[probe];
+  stats->count = p->count;
+  stats->min = p->min;
+  stats->max = p->max;
+  stats->sum = p->sum;
+
+  // Upper edge of the bucket holding the 99th percentile, capped at max.
+  const uint32_t rank = p->count - p->count / 100;
+  uint32_t seen = 0;
+  stats->p99 = p->max;
+  for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+    seen += p->buckets[bucket];
+    if (seen >= rank) {
+      const uint32_t upper = bucket_upper(bucket);
+      stats->p99 = upper < p->max ? upper : p->max;
+      break;
+    }
+  }
+  return true;
+}
+
+void trace_reset(void) {
+  for (uint32_t probe = 0; probe < TRACE_MAX_PROBES; ++probe) {
+    s_probes[probe].count = 0;
+    s_probes[probe].min = 0;
+    s_probes[probe].max = 0;
+    s_probes[probe].sum = 0;
+    memset(s_probes[probe].buckets, 0, sizeof(s_probes[probe].buckets));
+  }
+}
+
+uint32_t trace_dropped(void) {
+  uint32_t dropped = 0;
+  for (uint32_t core = 0; core < CORE_COUNT; ++core)
+    dropped += s_rings[core].dropped;
+  return dropped;
+}
+
+// Nanoseconds for the probe's unit, to print fractions of a microsecond.
+// Microsecond probes reach 2^24 us, so this needs 64 bits.
+static uint64_t to_ns(probe_t const* probe, uint64_t value) {
+  return probe->unit == TRACE_UNIT_US ? value * 1000 : value;
+}
+
+void trace_report(trace_write_t write, void* context) {
+  char line[128];
+
+  for (uint8_t index = 0; index < TRACE_MAX_PROBES; ++index) {
+    probe_t const* probe = &s_probes[index];
+    trace_stats_t stats;
+    if (!probe->name || !trace_get_stats(index, &stats)) continue;
+
+    const uint64_t min_ns = to_ns(probe, stats.min);
+    const uint64_t max_ns = to_ns(probe, stats.max);
+    const uint64_t mean_ns = to_ns(probe, stats.sum) / stats.count;
+    const uint64_t p99_ns = to_ns(probe, stats.p99);
+    const int len = snprintf(line, sizeof(line),
+        "trace %s n=%lu min=%llu.%02u max=%llu.%02u mean=%llu.%02u p99=%llu.%02u\r\n",
+        probe->name, (unsigned long)stats.count,
+        (unsigned long long)(min_ns / 1000), (unsigned)(min_ns % 1000 / 10),
+        (unsigned long long)(max_ns / 1000), (unsigned)(max_ns % 1000 / 10),
+        (unsigned long long)(mean_ns / 1000), (unsigned)(mean_ns % 1000 / 10),
+        (unsigned long long)(p99_ns / 1000), (unsigned)(p99_ns % 1000 / 10));
+    if (len > 0) write(line, (uint32_t)len < sizeof(line) ? (uint32_t)len : sizeof(line) - 1, context);
+  }
+
+  const int len = snprintf(line, sizeof(line), "trace dropped=%lu\r\n", (unsigned long)trace_dropped());
+  if (len > 0) write(line, (uint32_t)len, context);
+}
@@ -0,0 +1,78 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hardware/structs/systick.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lightweight timing probes.
+//
+// A probe packs its id and a 24-bit duration into one word and appends it to
+// a per-core ring buffer with interrupts briefly disabled, which costs a few
+// dozen cycles. trace_collect() drains the rings into per-probe histograms
+// (log-linear buckets, four per octave) on the reporting side, so the
+// instrumented code never touches the statistics.
+//
+// Durations are SysTick cycles by default, kept as nanoseconds at the
+// clk_sys that ran when they were recorded; probes registered with
+// TRACE_UNIT_US take microseconds through trace_record().
+
+#define TRACE_MAX_PROBES   (8)
+#define TRACE_RING_SIZE    (256)  // Per core, power of two
+#define TRACE_VALUE_MASK   (0x00ffffffu)
+
+typedef enum {
+  TRACE_UNIT_CYCLES,
+  TRACE_UNIT_US,
+} trace_unit_t;
+
+// Nanoseconds for cycle probes, microseconds for TRACE_UNIT_US probes.
+typedef struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t p99;
+} trace_stats_t;
+
+typedef void (*trace_write_t)(const char* text, uint32_t len, void* context);
+
+// Starts the free-running SysTick of the calling core. Call on every core
+// that records probes.
+void trace_init(void);
+
+void trace_register(uint8_t probe, const char* name, trace_unit_t unit);
+
+// SysTick counts down, so begin - end is the elapsed time.
+static inline uint32_t trace_begin(void) {
+  return systick_hw->cvr;
+}
+
+void trace_record(uint8_t probe, uint32_t value);
+
+static inline void trace_end(uint8_t probe, uint32_t begin) {
+  trace_record(probe, (begin - systick_hw->cvr) & TRACE_VALUE_MASK);
+}
+
+// Moves recorded values into the histograms. Call from one place only.
+void trace_collect(void);
+
+bool trace_get_stats(uint8_t probe, trace_stats_t* stats);
+void trace_reset(void);
+
+// Writes one text line per registered probe, times in microseconds.
+void trace_report(trace_write_t write, void* context);
+
+// Values lost because a ring was full.
+uint32_t trace_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+import math
+import os
+import struct
+import sys
+import wave
+
+# UniTaruBoard の PWM 再生 (UNITARU_PCM_BACKEND) 用に音声を SoundBankData.h へ変換する
+# 使い方: convert_sounds.py <出力.h> <フォルダ>:<トラック>=<ファイル.wav> ...
+#         ファイルの代わりに tone:<周波数>:<ミリ秒> と書くと試験用の音を作る
+# WAV はモノラルにまとめ、22050 Hz にリサンプルして IMA ADPCM で格納する
+SAMPLE_RATE = 22050
+
+STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767,
+]
+INDEX_STEPS = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+def read_wav(path):
+    with wave.open(path) as f:
+        if f.getsampwidth() != 2:
+            raise SystemExit(f"{path}: 16 ビットの WAV だけに対応しています")
+        channels, rate = f.getnchannels(), f.getframerate()
+        raw = f.readframes(f.getnframes())
+    frames = struct.unpack(f'<{len(raw) // 2}h', raw)
+    mono = [sum(frames[i:i + channels]) // channels for i in range(0, len(frames), channels)]
+    # 線形補間で 22050 Hz にそろえる
+    count = len(mono) * SAMPLE_RATE // rate
+    out = []
+    for i in range(count):
+        position = i * rate / SAMPLE_RATE
+        j = int(position)
+        k = min(j + 1, len(mono) - 1)
+        out.append(int(mono[j] + (mono[k] - mono[j]) * (position - j)))
+    return out
+
+def make_tone(frequency, ms):
+    count = SAMPLE_RATE * ms // 1000
+    fade = SAMPLE_RATE // 200  # 5 ms のフェードでクリック音を防ぐ
+    samples = []
+    for i in range(count):
+        envelope = min(1.0, i / fade, (count - 1 - i) / fade)
+        samples.append(int(12000 * envelope * math.sin(2 * math.pi * frequency * i / SAMPLE_RATE)))
+    return samples
+
+def encode_adpcm(samples):
+    # ファームウェアのデコーダ (SoundMixer.cpp) と同じ計算で予測値を追う
+    predictor, index = samples[0] if samples else 0, 0
+    first = predictor
+    codes = []
+    for sample in samples:
+        step = STEPS[index]
+        diff = sample - predictor
+        code = 8 if diff < 0 else 0
+        diff = abs(diff)
+        delta = step >> 3
+        if diff >= step:
+            code |= 4
+            diff -= step
+            delta += step
+        if diff >= step >> 1:
+            code |= 2
+            diff -= step >> 1
+            delta += step >> 1
+        if diff >= step >> 2:
+            code |= 1
+            delta += step >> 2
+        predictor = predictor - delta if code & 8 else predictor + delta
+        predictor = max(-32768, min(32767, predictor))
+        index = max(0, min(88, index + INDEX_STEPS[code & 7]))
+        codes.append(code)
+    if len(codes) % 2:
+        codes.append(0)
+    data = bytes(codes[i] | codes[i + 1] << 4 for i in range(0, len(codes), 2))
+    return first, data
+
+def main():
+    if len(sys.argv) < 3:
+        print("使い方: convert_sounds.py <出力.h> <フォルダ>:<トラック>=<ファイル.wav | tone:周波数:ミリ秒> ...")
+        raise SystemExit(1)
+
+    entries = []
+    for spec in sys.argv[2:]:
+        key, source = spec.split('=', 1)
+        folder, track = (int(v) for v in key.split(':'))
+        if source.startswith('tone:'):
+            _, frequency, ms = source.split(':')
+            samples = make_tone(float(frequency), int(ms))
+        else:
+            samples = read_wav(source)
+        entries.append((folder, track, source, samples))
+
+    lines = [
+        '#pragma once',
+        '',
+        f'// Generated by convert_sounds.py: {" ".join(os.path.basename(a) for a in sys.argv[2:])}',
+        '',
+    ]
+    table = []
+    for folder, track, source, samples in entries:
+        name = f'Sound{folder:02d}_{track:03d}'
+        first, data = encode_adpcm(samples)
+        lines.append(f'// {source}, {len(samples)} samples')
+        lines.append(f'alignas(4) inline constexpr uint8_t {name}[] = {{')
+        for i in range(0, len(data), 16):
+            lines.append('    ' + ', '.join(f'0x{b:02x}' for b in data[i:i + 16]) + ',')
+        lines.append('};')
+        lines.append('')
+        table.append(f'    {{{folder}, {track}, {{SoundClip::Format::ImaAdpcm, {len(samples)}, {name}, {first}, 0}}}},')
+    lines.append('inline constexpr SoundBankEntry SoundBank[] = {')
+    lines.extend(table)
+    lines.append('};')
+    with open(sys.argv[1], 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+    print(f"{sys.argv[1]} に {len(entries)} 個の音を書き出しました")
+
+main()
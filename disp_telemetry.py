@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+import struct
+import sys
+import time
+
+import serial
+import serial.tools.list_ports
+
+import telemetry_frames as tf
+
+# button_and_volume の CDC からADCの生データとボタンの状態を受け取って表示する
+USB_VID = 0xCAFE
+ADC_STEP = int(sys.argv[1]) if len(sys.argv) > 1 else 4
+ADC_ERROR_BIT = 0x8000
+
+def find_telemetry_port():
+    for port in serial.tools.list_ports.comports():
+        if port.vid == USB_VID:
+            return port.device
+    return None
+
+port_name = find_telemetry_port()
+if not port_name:
+    print("button_and_volume が見つかりませんでした…")
+    raise SystemExit(1)
+
+port = serial.Serial(port_name, 115200, timeout=0.1)
+port.write(tf.encode_frame(tf.TYPE_CONFIG, bytes([tf.STREAM_ADC | tf.STREAM_INPUT, ADC_STEP])))
+print(f"{port_name} からテレメトリを受信します (ADCは{ADC_STEP}サンプルごと)")
+
+reader = tf.FrameReader()
+next_index = None
+samples = []
+lost = 0
+last_input = None
+last_print = time.time()
+try:
+    while True:
+        for frame_type, payload in reader.feed(port.read(4096)):
+            if frame_type == tf.TYPE_ADC:
+                first, step, values = tf.decode_adc(payload)
+                # 途切れたサンプル数を数える
+                if next_index is not None and first != next_index:
+                    lost += ((first - next_index) & 0xFFFFFFFF) // step
+                next_index = (first + len(values) * step) & 0xFFFFFFFF
+                samples.extend(v for v in values if not v & ADC_ERROR_BIT)
+            elif frame_type == tf.TYPE_INPUT:
+                last_input = tf.decode_input(payload)
+            elif frame_type == tf.TYPE_CONFIG and len(payload) >= 6:
+                streams, step, dropped = struct.unpack_from('<BBI', payload)
+                print(f"設定: streams=0x{streams:02x} step={step} 送れなかったパケット={dropped}")
+
+        now = time.time()
+        if now - last_print >= 1.0:
+            rate = len(samples) / (now - last_print)
+            mean = sum(samples) / len(samples) if samples else 0
+            text = f"ADC {rate:8.0f} サンプル/秒 平均 {mean:7.1f} 最小 {min(samples, default=0):4} 最大 {max(samples, default=0):4} 欠落 {lost}"
+            if last_input:
+                time_ms, level, flags = last_input
+                text += f" | レベル {level:3} フラグ 0x{flags:02x}"
+            print(text)
+            samples.clear()
+            last_print = now
+except KeyboardInterrupt:
+    pass
+finally:
+    # ADCストリームを止めて元の設定に戻す
+    port.write(tf.encode_frame(tf.TYPE_CONFIG, bytes([tf.STREAM_INPUT | tf.STREAM_TRACE, ADC_STEP])))
+    port.close()
@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+import re
+import sys
+
+import serial
+import serial.tools.list_ports
+
+import telemetry_frames as tf
+
+# UniTaruBoard は Pico 標準の USB シリアル (テキスト)、
+# button_and_volume は TinyUSB の CDC (テレメトリのテキストフレーム)
+PICO_IDS = [(0x2E8A, 0x000A), (0xCAFE, None)]
+TELEMETRY_VID = 0xCAFE
+
+TRACE_LINE = re.compile(r'^trace (\S+) n=(\d+) min=([\d.]+) max=([\d.]+) mean=([\d.]+) p99=([\d.]+)')
+DROPPED_LINE = re.compile(r'^trace dropped=(\d+)')
+
+def find_trace_port():
+    for port in serial.tools.list_ports.comports():
+        for vid, pid in PICO_IDS:
+            if port.vid == vid and (pid is None or port.pid == pid):
+                return port
+    return None
+
+def read_lines(port, telemetry):
+    # テレメトリではテキストフレームをつなげて行に戻す
+    reader = tf.FrameReader()
+    text = ''
+    while True:
+        if telemetry:
+            for frame_type, payload in reader.feed(port.read(port.in_waiting or 1)):
+                if frame_type == tf.TYPE_TEXT:
+                    text += payload.decode(errors='replace')
+        else:
+            text += port.readline().decode(errors='replace')
+        while '\n' in text:
+            line, text = text.split('\n', 1)
+            yield line.strip()
+
+def print_table(stats, dropped):
+    # 端末をクリアして最新の統計だけを表示する
+    print("\x1b[2J\x1b[H", end='')
+    print(f"{'probe':<16}{'count':>10}{'min[us]':>10}{'mean[us]':>10}{'p99[us]':>10}{'max[us]':>10}")
+    for name, (count, min_us, max_us, mean_us, p99_us) in stats.items():
+        print(f"{name:<16}{count:>10}{min_us:>10}{mean_us:>10}{p99_us:>10}{max_us:>10}")
+    print(f"dropped: {dropped}")
+    sys.stdout.flush()
+
+found = find_trace_port()
+if len(sys.argv) > 1:
+    port_name, telemetry = sys.argv[1], len(sys.argv) > 2 and sys.argv[2] == 'telemetry'
+elif found:
+    port_name, telemetry = found.device, found.vid == TELEMETRY_VID
+else:
+    print("Raspberry Pi Picoが見つかりませんでした…")
+    raise SystemExit(1)
+
+port = serial.Serial(port_name, 115200, timeout=2)
+print(f"{port_name} から統計を読み込みます (Ctrl+C で終了)")
+if telemetry:
+    # 前回の統計を捨てて計測をやり直す
+    port.write(tf.encode_frame(tf.TYPE_RESET_TRACE))
+
+stats = {}
+try:
+    for line in read_lines(port, telemetry):
+        match = TRACE_LINE.match(line)
+        if match:
+            stats[match.group(1)] = match.groups()[1:]
+            continue
+        match = DROPPED_LINE.match(line)
+        if match:
+            # dropped 行が1回分の報告の終わり
+            print_table(stats, match.group(1))
+except KeyboardInterrupt:
+    pass
+finally:
+    port.close()
@@ -0,0 +1,155 @@
+#!/usr/bin/env python
+import json
+import re
+import sys
+import time
+
+import serial
+import serial.tools.list_ports
+
+import telemetry_frames as tf
+
+# button_and_volume の HID ベンチマーク (BUTTON_AND_VOLUME_HID_BENCHMARK ビルド) の結果を集計する
+# 使い方: hid_bench.py record <結果.json> [秒数]   デバイスから計測して保存
+#         hid_bench.py load <ログ.txt> <結果.json>  ホストのテスト (hid_benchmark_test) の出力から保存
+#         hid_bench.py compare <前.json> <後.json>  ファームウェアのリビジョンどうしを比べる
+USB_VID = 0xCAFE
+BUCKETS = 16
+
+WINDOW_LINE = re.compile(r'^bench window_ms=(\d+) reports=(\d+) edges=(\d+) missed=(\d+)')
+LATENCY_LINE = re.compile(r'^bench latency n=(\d+) min=(\d+) mean=(\d+) max=(\d+)')
+BLOCK_MEAN_LINE = re.compile(r'^bench block_mean cycles_per_sample scalar=([\d.]+) words=([\d.]+)')
+HIST_LINE = re.compile(r'^bench hist bucket_us=(\d+)((?: \d+)+)')
+
+def empty_result():
+    return {'window_ms': 0, 'reports': 0, 'edges': 0, 'missed': 0, 'latencies': 0,
+            'latency_sum_us': 0, 'min_us': None, 'max_us': 0, 'bucket_us': 1000, 'hist': [0] * BUCKETS,
+            'block_mean_scalar': 0.0, 'block_mean_words': 0.0}
+
+def add_line(result, line):
+    # 1秒ごとの区間の値を足し合わせる
+    match = WINDOW_LINE.match(line)
+    if match:
+        window_ms, reports, edges, missed = map(int, match.groups())
+        result['window_ms'] += window_ms
+        result['reports'] += reports
+        result['edges'] += edges
+        result['missed'] += missed
+        return
+    match = LATENCY_LINE.match(line)
+    if match:
+        count, min_us, mean_us, max_us = map(int, match.groups())
+        result['latencies'] += count
+        result['latency_sum_us'] += mean_us * count
+        result['min_us'] = min_us if result['min_us'] is None else min(result['min_us'], min_us)
+        result['max_us'] = max(result['max_us'], max_us)
+        return
+    match = BLOCK_MEAN_LINE.match(line)
+    if match:
+        # 起動時に1回だけ計った値なので足さずに上書きする
+        result['block_mean_scalar'], result['block_mean_words'] = map(float, match.groups())
+        return
+    match = HIST_LINE.match(line)
+    if match:
+        result['bucket_us'] = int(match.group(1))
+        counts = [int(c) for c in match.group(2).split()]
+        result['hist'] = [a + b for a, b in zip(result['hist'], counts)]
+
+def percentile(result, fraction):
+    # ヒストグラムのバケットの上端で近似する
+    target = result['latencies'] * fraction
+    total = 0
+    for index, count in enumerate(result['hist']):
+        total += count
+        if count and total >= target:
+            return (index + 1) * result['bucket_us']
+    return 0
+
+def summary(result):
+    seconds = result['window_ms'] / 1000 or 1
+    mean_us = result['latency_sum_us'] / result['latencies'] if result['latencies'] else 0
+    return {
+        'reports/s': result['reports'] / seconds,
+        'edges': result['edges'],
+        'missed': result['missed'],
+        'min[us]': result['min_us'] or 0,
+        'mean[us]': mean_us,
+        'p50[us]': percentile(result, 0.5),
+        'p99[us]': percentile(result, 0.99),
+        'max[us]': result['max_us'],
+        'mean_cyc/smp': result.get('block_mean_words', 0.0),
+    }
+
+def print_histogram(result):
+    peak = max(result['hist']) or 1
+    for index, count in enumerate(result['hist']):
+        label = f"{index * result['bucket_us'] / 1000:>4.0f}ms" + ('+' if index == BUCKETS - 1 else ' ')
+        print(f"{label} {count:>6} {'#' * (count * 40 // peak)}")
+
+def record(path, seconds):
+    port_name = next((p.device for p in serial.tools.list_ports.comports() if p.vid == USB_VID), None)
+    if not port_name:
+        print("button_and_volume が見つかりませんでした…")
+        raise SystemExit(1)
+
+    result = empty_result()
+    with serial.Serial(port_name, 115200, timeout=0.1) as port:
+        port.write(tf.encode_frame(tf.TYPE_CONFIG, bytes([tf.STREAM_TRACE, 1])))
+        reader = tf.FrameReader()
+        text = ''
+        # 最初の区間は計測前の値を含むので捨てる
+        skipped = False
+        deadline = time.time() + seconds + 1
+        while time.time() < deadline:
+            for frame_type, payload in reader.feed(port.read(256)):
+                if frame_type == tf.TYPE_TEXT:
+                    text += payload.decode(errors='replace')
+            while '\n' in text:
+                line, text = text.split('\n', 1)
+                line = line.strip()
+                if not skipped:
+                    skipped = WINDOW_LINE.match(line) is not None
+                    continue
+                add_line(result, line)
+        port.write(tf.encode_frame(tf.TYPE_CONFIG, bytes([0, 1])))
+    save(path, result)
+
+def save(path, result):
+    if result['edges'] == 0:
+        print("ベンチマークの出力がありません (BUTTON_AND_VOLUME_HID_BENCHMARK でビルドしてください)")
+        raise SystemExit(1)
+    with open(path, 'w') as f:
+        json.dump(result, f, indent=2)
+    for name, value in summary(result).items():
+        print(f"{name:<12}{value:>12.1f}" if isinstance(value, float) else f"{name:<12}{value:>12}")
+    print_histogram(result)
+
+def load(log_path, path):
+    # シミュレーションの時計は起動から数えるので最初の区間も使う
+    result = empty_result()
+    with open(log_path) as f:
+        for line in f:
+            add_line(result, line.strip())
+    save(path, result)
+
+def compare(before_path, after_path):
+    with open(before_path) as f:
+        before = summary(json.load(f))
+    with open(after_path) as f:
+        after = summary(json.load(f))
+    print(f"{'':<12}{'before':>12}{'after':>12}{'change':>10}")
+    for name in before:
+        change = f"{(after[name] - before[name]) * 100 / before[name]:+.1f}%" if before[name] else '-'
+        print(f"{name:<12}{before[name]:>12.1f}{after[name]:>12.1f}{change:>10}")
+
+if len(sys.argv) >= 3 and sys.argv[1] == 'record':
+    record(sys.argv[2], float(sys.argv[3]) if len(sys.argv) > 3 else 30)
+elif len(sys.argv) == 4 and sys.argv[1] == 'load':
+    load(sys.argv[2], sys.argv[3])
+elif len(sys.argv) == 4 and sys.argv[1] == 'compare':
+    compare(sys.argv[2], sys.argv[3])
+else:
+    print("使い方: hid_bench.py record <結果.json> [秒数]")
+    print("        hid_bench.py load <ログ.txt> <結果.json>")
+    print("        hid_bench.py compare <前.json> <後.json>")
+    raise SystemExit(1)
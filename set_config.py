@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+import struct
+import sys
+import time
+
+import serial
+import serial.tools.list_ports
+
+import telemetry_frames as tf
+
+# button_and_volume の設定をフラッシュに保存する (config_keys.h を参照)
+# 使い方: set_config.py <key> [value]   value を省略すると現在の値を表示
+USB_VID = 0xCAFE
+
+if len(sys.argv) < 2:
+    print("使い方: set_config.py <key> [value]")
+    raise SystemExit(1)
+
+key = int(sys.argv[1], 0)
+payload = struct.pack('<H', key)
+if len(sys.argv) > 2:
+    payload += struct.pack('<I', int(sys.argv[2], 0))
+
+port_name = next((p.device for p in serial.tools.list_ports.comports() if p.vid == USB_VID), None)
+if not port_name:
+    print("button_and_volume が見つかりませんでした…")
+    raise SystemExit(1)
+
+with serial.Serial(port_name, 115200, timeout=0.1) as port:
+    port.write(tf.encode_frame(tf.TYPE_SETTING, payload))
+    reader = tf.FrameReader()
+    deadline = time.time() + 2
+    while time.time() < deadline:
+        for frame_type, data in reader.feed(port.read(256)):
+            if frame_type == tf.TYPE_SETTING and len(data) >= 6:
+                answered_key, value = struct.unpack_from('<HI', data)
+                if answered_key == key:
+                    # フラッシュへの書き込みは1秒以内に行われる
+                    print(f"{key} = {value}")
+                    raise SystemExit(0)
+    print("値がありません (未設定のキーはデフォルト値が使われます)")
@@ -0,0 +1,57 @@
+# button_and_volume の CDC テレメトリのフレーム形式 (telemetry.h を参照)
+import struct
+
+SYNC = 0xA5
+TYPE_ADC = 1
+TYPE_INPUT = 2
+TYPE_TEXT = 3
+TYPE_CONFIG = 4
+TYPE_RESET_TRACE = 5
+TYPE_SETTING = 6
+
+STREAM_ADC = 1 << 0
+STREAM_INPUT = 1 << 1
+STREAM_TRACE = 1 << 2
+
+def encode_frame(frame_type, payload=b''):
+    body = bytes([frame_type, len(payload)]) + payload
+    return bytes([SYNC]) + body + bytes([(-sum(body)) & 0xFF])
+
+class FrameReader:
+    """受信したバイト列からチェックサムの正しいフレームだけを取り出す"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.errors = 0
+
+    def feed(self, data):
+        self.buffer.extend(data)
+        frames = []
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                self.buffer.clear()
+                return frames
+            del self.buffer[:start]
+            if len(self.buffer) < 3:
+                return frames
+            length = self.buffer[2] + 4
+            if len(self.buffer) < length:
+                return frames
+            body = self.buffer[1:length]
+            if sum(body) & 0xFF == 0:
+                frames.append((body[0], bytes(body[2:-1])))
+                del self.buffer[:length]
+            else:
+                # 同期バイトを読み違えたので1バイト進めてやり直す
+                self.errors += 1
+                del self.buffer[:1]
+
+def decode_adc(payload):
+    first, step = struct.unpack_from('<IB', payload)
+    count = (len(payload) - 5) // 2
+    return first, step, struct.unpack_from(f'<{count}H', payload, 5)
+
+def decode_input(payload):
+    time_ms, level, flags = struct.unpack_from('<IBB', payload)
+    return time_ms, level, flags